@@ -59,6 +59,12 @@ public:
   {
   }
 
+  /** @brief Deep copy of the octree of \e other. The lock and the update callback are not copied.
+   *  \e other needs to be locked for reading. */
+  OccMapTree(const OccMapTree& other) : octomap::OcTree(other)
+  {
+  }
+
   /** @brief lock the underlying octree. it will not be read or written by the
    *  monitor until unlockTree() is called */
   void lockRead()
@@ -38,6 +38,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <moveit_msgs/msg/robot_trajectory.hpp>
 #include <moveit/macros/class_forward.h>
 #include <rclcpp/rclcpp.hpp>
@@ -143,6 +144,16 @@ public:
   /** \brief Return the execution status of the last trajectory sent to the controller. */
   virtual ExecutionStatus getLastExecutionStatus() = 0;
 
+  /** \brief Report whether the controller can replace the trajectory it is executing without stopping.
+   *
+   * If true, sendTrajectory() may be called while a trajectory is being executed. The controller then switches to the
+   * new trajectory at the time given by its header stamp, and waitForExecution() waits for the new trajectory
+   * to complete. */
+  virtual bool supportsTrajectoryReplacement() const
+  {
+    return false;
+  }
+
 protected:
   std::string name_;
 };
@@ -209,5 +220,14 @@ public:
   /** \brief Activate and deactivate controllers */
   virtual bool switchControllers(const std::vector<std::string>& activate,
                                  const std::vector<std::string>& deactivate) = 0;
+
+  /** \brief Report a number that changes whenever the list of controllers, their joints or their states change.
+   *
+   * Users of this interface may keep the controller information they read while the number stays the same.
+   * Managers that cannot detect changes return 0, the information is then read again whenever it is needed. */
+  virtual std::uint64_t getControllersRevision()
+  {
+    return 0;
+  }
 };
 }  // namespace moveit_controller_manager
@@ -40,6 +40,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <Eigen/Core>
 
 // Auto-generated
 #include <moveit_butterworth_parameters.hpp>
@@ -88,10 +90,55 @@ private:
   double feedback_term_;
 };
 
+/**
+ * Class ButterworthFilterBank - The filter of ButterworthFilter applied to many signals at once.
+ * The coefficients and the history of all signals are stored in contiguous arrays, so that one filter step is a few
+ * vectorized operations over all signals instead of one scalar filter call per signal.
+ * Every signal can have its own filter coefficient. Higher orders are obtained by cascading first-order sections with
+ * the same coefficient, which keeps the property of not overshooting.
+ */
+class ButterworthFilterBank
+{
+public:
+  /**
+   * Constructor.
+   * @param low_pass_filter_coeffs The filter coefficient of every signal, see ButterworthFilter.
+   * @param order The number of cascaded first-order sections.
+   */
+  ButterworthFilterBank(const Eigen::ArrayXd& low_pass_filter_coeffs, std::size_t order = 1);
+  ButterworthFilterBank() = delete;
+
+  /**
+   * Filter the next measurement of all signals in place.
+   * @param values The new measurements, replaced by the filtered values. Must have size() elements.
+   */
+  void filter(Eigen::Ref<Eigen::ArrayXd> values);
+
+  /**
+   * Reset all signals to steady state at the given values.
+   * @param values The values to reset to. Must have size() elements.
+   */
+  void reset(const Eigen::Ref<const Eigen::ArrayXd>& values);
+
+  std::size_t size() const
+  {
+    return scale_terms_.size();
+  }
+
+private:
+  Eigen::ArrayXd scale_terms_;
+  Eigen::ArrayXd feedback_terms_;
+  // One column per section, one row per signal
+  Eigen::ArrayXXd previous_measurements_;
+  Eigen::ArrayXXd previous_filtered_measurements_;
+};
+
 // Plugin
 class ButterworthFilterPlugin : public SmoothingBaseClass
 {
 public:
+  using SmoothingBaseClass::doSmoothing;
+
   /**
    * Initialize the smoothing algorithm
    * @param node ROS node, used for parameter retrieval
@@ -118,7 +165,7 @@ public:
 
 private:
   rclcpp::Node::SharedPtr node_;
-  std::vector<ButterworthFilter> position_filters_;
+  std::unique_ptr<ButterworthFilterBank> position_filters_;
   size_t num_joints_;
 };
 }  // namespace online_signal_smoothing
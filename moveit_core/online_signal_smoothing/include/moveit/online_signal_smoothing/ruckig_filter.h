@@ -0,0 +1,115 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Description: Jerk-limited online smoothing of joint commands with Ruckig.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Auto-generated
+#include <moveit_ruckig_filter_parameters.hpp>
+#include <moveit/robot_model/robot_model.h>
+#include <moveit/online_signal_smoothing/smoothing_base_class.h>
+#include <ruckig/ruckig.hpp>
+
+namespace online_signal_smoothing
+{
+/**
+ * Plugin that moves the commanded joint positions towards the incoming commands with Ruckig.
+ * Every cycle Ruckig computes a time-optimal trajectory from the current commanded state to the incoming command
+ * and the first sample of that trajectory is returned. The resulting position, velocity and acceleration setpoints
+ * respect the velocity, acceleration and jerk limits of the planning group in the RobotModel.
+ * Ruckig solves each degree of freedom analytically, so the computation time per cycle is bounded. All buffers are
+ * allocated during initialization.
+ */
+class RuckigFilterPlugin : public SmoothingBaseClass
+{
+public:
+  /**
+   * Initialize the smoothing algorithm
+   * @param node ROS node, used for parameter retrieval
+   * @param robot_model used to retrieve the vel/accel/jerk limits of the planning group
+   * @param num_joints number of actuated joints in the JointGroup Servo controls
+   * @return True if initialization was successful
+   */
+  bool initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr robot_model,
+                  size_t num_joints) override;
+
+  /**
+   * Smooth the command signals for all DOF
+   * @param position_vector array of joint position commands
+   * @return True if smoothing was successful
+   */
+  bool doSmoothing(std::vector<double>& position_vector) override;
+
+  /**
+   * Smooth the command signals for all DOF and provide the jerk-limited velocity and acceleration setpoints
+   * @param position_vector array of joint position commands
+   * @param velocity_vector array of joint velocity setpoints
+   * @param acceleration_vector array of joint acceleration setpoints
+   * @return True if smoothing was successful
+   */
+  bool doSmoothing(std::vector<double>& position_vector, std::vector<double>& velocity_vector,
+                   std::vector<double>& acceleration_vector) override;
+
+  /**
+   * Reset to a given joint state
+   * The velocities and accelerations of the last commanded state are kept, so that the robot can be tracked without
+   * losing the motion state. They are reset to zero if no smoothing has been done for more than two update periods.
+   * @param joint_positions reset the filters to these joint positions
+   * @return True if reset was successful
+   */
+  bool reset(const std::vector<double>& joint_positions) override;
+
+private:
+  rclcpp::Node::SharedPtr node_;
+  ruckig_filter::Params params_;
+  size_t num_joints_;
+  std::vector<double> max_velocity_;
+  // The previous incoming command, used to estimate the commanded velocity
+  std::vector<double> previous_command_;
+  // Scratch space for the setpoints that are not requested by the caller
+  std::vector<double> velocities_;
+  std::vector<double> accelerations_;
+  std::optional<ruckig::Ruckig<ruckig::DynamicDOFs>> ruckig_;
+  std::optional<ruckig::InputParameter<ruckig::DynamicDOFs>> ruckig_input_;
+  std::optional<ruckig::OutputParameter<ruckig::DynamicDOFs>> ruckig_output_;
+  std::chrono::steady_clock::time_point last_update_;
+};
+}  // namespace online_signal_smoothing
@@ -76,6 +76,17 @@ public:
    */
   virtual bool doSmoothing(std::vector<double>& position_vector) = 0;
 
+  /**
+   * Smooth an array of joint position commands and provide the matching velocity and acceleration setpoints.
+   * The default implementation only smooths the positions and leaves the velocities and accelerations untouched.
+   * @param position_vector array of joint position commands
+   * @param velocity_vector array of joint velocity setpoints, has the same size as position_vector
+   * @param acceleration_vector array of joint acceleration setpoints, has the same size as position_vector
+   * @return True if smoothing was successful
+   */
+  virtual bool doSmoothing(std::vector<double>& position_vector, std::vector<double>& velocity_vector,
+                           std::vector<double>& acceleration_vector);
+
   /**
    * Reset to a given joint state
    * @param joint_positions reset the filters to these joint positions
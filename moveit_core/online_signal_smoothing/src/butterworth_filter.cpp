@@ -39,28 +39,20 @@
 #include <moveit/online_signal_smoothing/butterworth_filter.h>
 #include <rclcpp/clock.hpp>
 #include <rclcpp/logging.hpp>
+#include <stdexcept>
 
 namespace online_signal_smoothing
 {
 namespace
 {
 constexpr double EPSILON = 1e-9;
-}
 
-ButterworthFilter::ButterworthFilter(double low_pass_filter_coeff)
-  : previous_measurements_{ 0., 0. }
-  , previous_filtered_measurement_(0.)
-  , scale_term_(1. / (1. + low_pass_filter_coeff))
-  , feedback_term_(1. - low_pass_filter_coeff)
+void checkFilterTerms(double low_pass_filter_coeff, double scale_term, double feedback_term)
 {
-  // guarantee this doesn't change because the logic below depends on this length implicitly
-  static_assert(ButterworthFilter::FILTER_LENGTH == 2,
-                "online_signal_smoothing::ButterworthFilter::FILTER_LENGTH should be 2");
-
-  if (std::isinf(feedback_term_))
+  if (std::isinf(feedback_term))
     throw std::length_error("online_signal_smoothing::ButterworthFilter: infinite feedback_term_");
 
-  if (std::isinf(scale_term_))
+  if (std::isinf(scale_term))
     throw std::length_error("online_signal_smoothing::ButterworthFilter: infinite scale_term_");
 
   if (low_pass_filter_coeff < 1)
@@ -69,12 +61,26 @@ ButterworthFilter::ButterworthFilter(double low_pass_filter_coeff)
         "online_signal_smoothing::ButterworthFilter: Filter coefficient < 1. makes the lowpass filter unstable");
   }
 
-  if (std::abs(feedback_term_) < EPSILON)
+  if (std::abs(feedback_term) < EPSILON)
   {
     throw std::length_error(
         "online_signal_smoothing::ButterworthFilter: Filter coefficient value resulted in feedback term of 0");
   }
 }
+}  // namespace
+
+ButterworthFilter::ButterworthFilter(double low_pass_filter_coeff)
+  : previous_measurements_{ 0., 0. }
+  , previous_filtered_measurement_(0.)
+  , scale_term_(1. / (1. + low_pass_filter_coeff))
+  , feedback_term_(1. - low_pass_filter_coeff)
+{
+  // guarantee this doesn't change because the logic below depends on this length implicitly
+  static_assert(ButterworthFilter::FILTER_LENGTH == 2,
+                "online_signal_smoothing::ButterworthFilter::FILTER_LENGTH should be 2");
+
+  checkFilterTerms(low_pass_filter_coeff, scale_term_, feedback_term_);
+}
 
 double ButterworthFilter::filter(double new_measurement)
 {
@@ -95,25 +101,87 @@ void ButterworthFilter::reset(const double data)
   previous_filtered_measurement_ = data;
 }
 
+ButterworthFilterBank::ButterworthFilterBank(const Eigen::ArrayXd& low_pass_filter_coeffs, std::size_t order)
+  : scale_terms_(1. / (1. + low_pass_filter_coeffs))
+  , feedback_terms_(1. - low_pass_filter_coeffs)
+  , previous_measurements_(Eigen::ArrayXXd::Zero(low_pass_filter_coeffs.size(), order))
+  , previous_filtered_measurements_(Eigen::ArrayXXd::Zero(low_pass_filter_coeffs.size(), order))
+{
+  if (order < 1)
+    throw std::length_error("online_signal_smoothing::ButterworthFilterBank: Filter order must be at least 1");
+
+  for (Eigen::Index i = 0; i < low_pass_filter_coeffs.size(); ++i)
+  {
+    checkFilterTerms(low_pass_filter_coeffs[i], scale_terms_[i], feedback_terms_[i]);
+  }
+}
+
+void ButterworthFilterBank::filter(Eigen::Ref<Eigen::ArrayXd> values)
+{
+  // Each section filters the output of the previous one. The columns are contiguous, so Eigen vectorizes every line.
+  for (Eigen::Index section = 0; section < previous_measurements_.cols(); ++section)
+  {
+    auto previous_measurement = previous_measurements_.col(section);
+    auto previous_filtered_measurement = previous_filtered_measurements_.col(section);
+    previous_filtered_measurement =
+        scale_terms_ * (values + previous_measurement - feedback_terms_ * previous_filtered_measurement);
+    previous_measurement = values;
+    values = previous_filtered_measurement;
+  }
+}
+
+void ButterworthFilterBank::reset(const Eigen::Ref<const Eigen::ArrayXd>& values)
+{
+  previous_measurements_.colwise() = values;
+  previous_filtered_measurements_.colwise() = values;
+}
+
 bool ButterworthFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr /* unused */,
                                          size_t num_joints)
 {
   node_ = node;
   num_joints_ = num_joints;
 
-  online_signal_smoothing::ParamListener param_listener(node_);
-  double filter_coeff = param_listener.get_params().butterworth_filter_coeff;
+  // invalid parameters are rejected when they are declared
+  online_signal_smoothing::Params params;
+  try
+  {
+    online_signal_smoothing::ParamListener param_listener(node_);
+    params = param_listener.get_params();
+  }
+  catch (const std::exception& ex)
+  {
+    RCLCPP_ERROR(node_->get_logger(), "Invalid Butterworth filter parameters: %s", ex.what());
+    return false;
+  }
+
+  Eigen::ArrayXd filter_coeffs = Eigen::ArrayXd::Constant(num_joints_, params.butterworth_filter_coeff);
+  if (!params.butterworth_filter_coeffs.empty())
+  {
+    if (params.butterworth_filter_coeffs.size() != num_joints_)
+    {
+      RCLCPP_ERROR(node_->get_logger(), "butterworth_filter_coeffs has %zu entries, but there are %zu joints.",
+                   params.butterworth_filter_coeffs.size(), num_joints_);
+      return false;
+    }
+    filter_coeffs = Eigen::Map<const Eigen::ArrayXd>(params.butterworth_filter_coeffs.data(), num_joints_);
+  }
 
-  for (std::size_t i = 0; i < num_joints_; ++i)
+  try
+  {
+    position_filters_ = std::make_unique<ButterworthFilterBank>(filter_coeffs, params.butterworth_filter_order);
+  }
+  catch (const std::length_error& ex)
   {
-    position_filters_.emplace_back(filter_coeff);
+    RCLCPP_ERROR(node_->get_logger(), "%s", ex.what());
+    return false;
   }
   return true;
 };
 
 bool ButterworthFilterPlugin::doSmoothing(std::vector<double>& position_vector)
 {
-  if (position_vector.size() != position_filters_.size())
+  if (position_vector.size() != position_filters_->size())
   {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -122,17 +190,14 @@ bool ButterworthFilterPlugin::doSmoothing(std::vector<double>& position_vector)
 #pragma GCC diagnostic pop
     return false;
   }
-  for (size_t i = 0; i < position_vector.size(); ++i)
-  {
-    // Lowpass filter the position command
-    position_vector[i] = position_filters_.at(i).filter(position_vector[i]);
-  }
+  // Lowpass filter the position commands
+  position_filters_->filter(Eigen::Map<Eigen::ArrayXd>(position_vector.data(), position_vector.size()));
   return true;
 };
 
 bool ButterworthFilterPlugin::reset(const std::vector<double>& joint_positions)
 {
-  if (joint_positions.size() != position_filters_.size())
+  if (joint_positions.size() != position_filters_->size())
   {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -141,10 +206,7 @@ bool ButterworthFilterPlugin::reset(const std::vector<double>& joint_positions)
 #pragma GCC diagnostic pop
     return false;
   }
-  for (size_t joint_idx = 0; joint_idx < joint_positions.size(); ++joint_idx)
-  {
-    position_filters_.at(joint_idx).reset(joint_positions.at(joint_idx));
-  }
+  position_filters_->reset(Eigen::Map<const Eigen::ArrayXd>(joint_positions.data(), joint_positions.size()));
   return true;
 };
 
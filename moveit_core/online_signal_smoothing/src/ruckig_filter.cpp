@@ -0,0 +1,194 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Description: Jerk-limited online smoothing of joint commands with Ruckig.
+ */
+
+#include <moveit/online_signal_smoothing/ruckig_filter.h>
+#include <rclcpp/clock.hpp>
+#include <rclcpp/logging.hpp>
+#include <algorithm>
+
+namespace online_signal_smoothing
+{
+namespace
+{
+const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit.core.ruckig_filter_plugin");
+
+// Used if the robot description does not provide limits, same as for the offline Ruckig smoothing
+constexpr double DEFAULT_MAX_VELOCITY = 5;       // rad/s
+constexpr double DEFAULT_MAX_ACCELERATION = 10;  // rad/s^2
+constexpr double DEFAULT_MAX_JERK = 1000;        // rad/s^3
+}  // namespace
+
+bool RuckigFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr robot_model,
+                                    size_t num_joints)
+{
+  node_ = node;
+  num_joints_ = num_joints;
+
+  ruckig_filter::ParamListener param_listener(node_);
+  params_ = param_listener.get_params();
+
+  const moveit::core::JointModelGroup* const group = robot_model->getJointModelGroup(params_.planning_group_name);
+  if (!group)
+  {
+    RCLCPP_ERROR_STREAM(LOGGER, "Planning group '" << params_.planning_group_name << "' does not exist.");
+    return false;
+  }
+  const moveit::core::JointBoundsVector& joint_bounds = group->getActiveJointModelsBounds();
+  if (joint_bounds.size() != num_joints_)
+  {
+    RCLCPP_ERROR_STREAM(LOGGER, "Planning group '" << params_.planning_group_name << "' has " << joint_bounds.size()
+                                                   << " active joints, but " << num_joints_ << " are smoothed.");
+    return false;
+  }
+
+  ruckig_.emplace(num_joints_, params_.update_period);
+  ruckig_input_.emplace(num_joints_);
+  ruckig_output_.emplace(num_joints_);
+  max_velocity_.assign(num_joints_, 0.0);
+  previous_command_.assign(num_joints_, 0.0);
+  velocities_.assign(num_joints_, 0.0);
+  accelerations_.assign(num_joints_, 0.0);
+
+  // Joints are planned independently, this is cheaper than synchronizing them and keeps each joint as fast as possible.
+  ruckig_input_->synchronization = ruckig::Synchronization::None;
+  for (size_t i = 0; i < num_joints_; ++i)
+  {
+    // Servo only supports single variable joints
+    const moveit::core::VariableBounds& bounds = joint_bounds[i]->front();
+    max_velocity_[i] = params_.max_velocity_scaling_factor *
+                       (bounds.velocity_bounded_ ? bounds.max_velocity_ : DEFAULT_MAX_VELOCITY);
+    ruckig_input_->max_velocity[i] = max_velocity_[i];
+    ruckig_input_->max_acceleration[i] =
+        params_.max_acceleration_scaling_factor *
+        (bounds.acceleration_bounded_ ? bounds.max_acceleration_ : DEFAULT_MAX_ACCELERATION);
+    ruckig_input_->max_jerk[i] = bounds.jerk_bounded_ ? bounds.max_jerk_ : DEFAULT_MAX_JERK;
+    if (!bounds.velocity_bounded_ || !bounds.acceleration_bounded_ || !bounds.jerk_bounded_)
+    {
+      RCLCPP_WARN_STREAM_ONCE(LOGGER, "Joint limits of the planning group are incomplete, using defaults of "
+                                          << DEFAULT_MAX_VELOCITY << " rad/s, " << DEFAULT_MAX_ACCELERATION
+                                          << " rad/s^2 and " << DEFAULT_MAX_JERK << " rad/s^3.");
+    }
+    ruckig_input_->current_velocity[i] = 0.0;
+    ruckig_input_->current_acceleration[i] = 0.0;
+    ruckig_input_->target_acceleration[i] = 0.0;
+  }
+  return true;
+};
+
+bool RuckigFilterPlugin::doSmoothing(std::vector<double>& position_vector)
+{
+  return doSmoothing(position_vector, velocities_, accelerations_);
+}
+
+bool RuckigFilterPlugin::doSmoothing(std::vector<double>& position_vector, std::vector<double>& velocity_vector,
+                                     std::vector<double>& acceleration_vector)
+{
+  if (position_vector.size() != num_joints_ || velocity_vector.size() != num_joints_ ||
+      acceleration_vector.size() != num_joints_)
+  {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    RCLCPP_ERROR_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
+                          "Vectors to be smoothed do not have the right length.");
+#pragma GCC diagnostic pop
+    return false;
+  }
+
+  // Track the command with the velocity at which the commands move, so a stream of commands is followed smoothly and
+  // a constant command is approached to a stop.
+  for (size_t i = 0; i < num_joints_; ++i)
+  {
+    ruckig_input_->target_position[i] = position_vector[i];
+    ruckig_input_->target_velocity[i] = std::clamp((position_vector[i] - previous_command_[i]) / params_.update_period,
+                                                   -max_velocity_[i], max_velocity_[i]);
+    previous_command_[i] = position_vector[i];
+  }
+
+  const ruckig::Result result = ruckig_->update(*ruckig_input_, *ruckig_output_);
+  last_update_ = std::chrono::steady_clock::now();
+  if (result != ruckig::Result::Working && result != ruckig::Result::Finished)
+  {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    RCLCPP_ERROR_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
+                          "Ruckig could not compute the next setpoint, error code %d.", static_cast<int>(result));
+#pragma GCC diagnostic pop
+    return false;
+  }
+
+  for (size_t i = 0; i < num_joints_; ++i)
+  {
+    position_vector[i] = ruckig_output_->new_position[i];
+    velocity_vector[i] = ruckig_output_->new_velocity[i];
+    acceleration_vector[i] = ruckig_output_->new_acceleration[i];
+  }
+  ruckig_output_->pass_to_input(*ruckig_input_);
+  return true;
+};
+
+bool RuckigFilterPlugin::reset(const std::vector<double>& joint_positions)
+{
+  if (joint_positions.size() != num_joints_)
+  {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    RCLCPP_ERROR_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
+                          "Position vector to be reset does not have the right length.");
+#pragma GCC diagnostic pop
+    return false;
+  }
+
+  // Start from rest if the commands stopped, e.g. because servoing was paused.
+  const std::chrono::duration<double> since_last_update = std::chrono::steady_clock::now() - last_update_;
+  const bool stale = since_last_update.count() > 2.0 * params_.update_period;
+  for (size_t i = 0; i < num_joints_; ++i)
+  {
+    ruckig_input_->current_position[i] = joint_positions[i];
+    if (stale)
+    {
+      ruckig_input_->current_velocity[i] = 0.0;
+      ruckig_input_->current_acceleration[i] = 0.0;
+      previous_command_[i] = joint_positions[i];
+    }
+  }
+  return true;
+};
+
+}  // namespace online_signal_smoothing
+
+#include <pluginlib/class_list_macros.hpp>
+PLUGINLIB_EXPORT_CLASS(online_signal_smoothing::RuckigFilterPlugin, online_signal_smoothing::SmoothingBaseClass)
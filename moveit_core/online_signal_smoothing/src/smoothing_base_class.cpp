@@ -42,4 +42,10 @@ namespace online_signal_smoothing
 {
 SmoothingBaseClass::SmoothingBaseClass() = default;
 SmoothingBaseClass::~SmoothingBaseClass() = default;
+
+bool SmoothingBaseClass::doSmoothing(std::vector<double>& position_vector, std::vector<double>& /* unused */,
+                                     std::vector<double>& /* unused */)
+{
+  return doSmoothing(position_vector);
+}
 }  // namespace online_signal_smoothing
@@ -0,0 +1,97 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Description: Compares the latency per cycle of the online smoothing plugins.
+ */
+
+// To run this benchmark, 'cd' to the build/moveit_core/online_signal_smoothing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/online_signal_smoothing/butterworth_filter.h>
+#include <moveit/online_signal_smoothing/ruckig_filter.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <cmath>
+
+// Robot and planning group for which the smoothing is benchmarked.
+constexpr char TEST_ROBOT[] = "panda";
+constexpr char TEST_GROUP[] = "panda_arm";
+constexpr double UPDATE_PERIOD = 0.01;  // s
+
+// Smooths a sinusoidal stream of joint commands like Servo does, resetting the plugin to the previous output first.
+static void benchmarkSmoothing(benchmark::State& st, online_signal_smoothing::SmoothingBaseClass& plugin)
+{
+  // The plugins read their parameters from a node, which requires an initialized context.
+  if (!rclcpp::ok())
+    rclcpp::init(0, nullptr);
+
+  const moveit::core::RobotModelPtr& robot_model = moveit::core::loadTestingRobotModel(TEST_ROBOT);
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({ { "planning_group_name", TEST_GROUP }, { "update_period", UPDATE_PERIOD } });
+  const auto node = std::make_shared<rclcpp::Node>("smoothing_plugins_benchmark", options);
+
+  const size_t num_joints = robot_model->getJointModelGroup(TEST_GROUP)->getActiveJointModelNames().size();
+  if (!plugin.initialize(node, robot_model, num_joints))
+  {
+    st.SkipWithError("The smoothing plugin could not be initialized.");
+    return;
+  }
+
+  std::vector<double> positions(num_joints, 0.0);
+  std::vector<double> current_positions(num_joints, 0.0);
+  size_t cycle = 0;
+  for (auto _ : st)
+  {
+    const double command = 0.5 * std::sin(2.0 * M_PI * UPDATE_PERIOD * static_cast<double>(cycle++));
+    positions.assign(num_joints, command);
+    plugin.reset(current_positions);
+    plugin.doSmoothing(positions);
+    current_positions = positions;
+    benchmark::DoNotOptimize(positions.data());
+  }
+}
+
+static void BM_ButterworthFilter(benchmark::State& st)
+{
+  online_signal_smoothing::ButterworthFilterPlugin plugin;
+  benchmarkSmoothing(st, plugin);
+}
+
+static void BM_RuckigFilter(benchmark::State& st)
+{
+  online_signal_smoothing::RuckigFilterPlugin plugin;
+  benchmarkSmoothing(st, plugin);
+}
+
+BENCHMARK(BM_ButterworthFilter);
+BENCHMARK(BM_RuckigFilter);
@@ -41,6 +41,9 @@
 
 #include <gtest/gtest.h>
 #include <moveit/online_signal_smoothing/butterworth_filter.h>
+#include <rclcpp/rclcpp.hpp>
+#include <cmath>
+#include <vector>
 
 TEST(SMOOTHING_PLUGINS, FilterConverge)
 {
@@ -71,3 +74,81 @@ TEST(SMOOTHING_PLUGINS, FilterReset)
   // Then check that a different measurement changes the value
   EXPECT_NE(5.0, lpf.filter(100.0));
 }
+
+TEST(SMOOTHING_PLUGINS, FilterBankMatchesFilters)
+{
+  const Eigen::ArrayXd coeffs = (Eigen::ArrayXd(3) << 1.5, 2.0, 10.0).finished();
+  online_signal_smoothing::ButterworthFilterBank bank(coeffs);
+  std::vector<online_signal_smoothing::ButterworthFilter> filters;
+  for (const double coeff : coeffs)
+    filters.emplace_back(coeff);
+
+  // The filter bank gives the same results as one filter per signal, also after a reset.
+  Eigen::ArrayXd values(3);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    if (i == 25)
+    {
+      bank.reset(Eigen::ArrayXd::Constant(3, -1.0));
+      for (auto& filter : filters)
+        filter.reset(-1.0);
+    }
+    values << 0.1 * i, std::sin(0.3 * i), (i % 2) ? 5.0 : -5.0;
+    const Eigen::ArrayXd measurements = values;
+    bank.filter(values);
+    for (Eigen::Index j = 0; j < values.size(); ++j)
+      EXPECT_DOUBLE_EQ(filters[j].filter(measurements[j]), values[j]);
+  }
+}
+
+TEST(SMOOTHING_PLUGINS, FilterBankHigherOrder)
+{
+  online_signal_smoothing::ButterworthFilterBank bank(Eigen::ArrayXd::Constant(2, 2.0), 2);
+  online_signal_smoothing::ButterworthFilter first_section(2.0);
+  online_signal_smoothing::ButterworthFilter second_section(2.0);
+
+  // A second order filter bank cascades two first order filters.
+  Eigen::ArrayXd values(2);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    values.setConstant(5.0);
+    bank.filter(values);
+    EXPECT_DOUBLE_EQ(second_section.filter(first_section.filter(5.0)), values[0]);
+    EXPECT_DOUBLE_EQ(values[0], values[1]);
+  }
+
+  // It converges without overshooting.
+  for (size_t i = 0; i < 100; ++i)
+  {
+    values.setConstant(5.0);
+    bank.filter(values);
+    EXPECT_LE(values[0], 5.0);
+  }
+  EXPECT_DOUBLE_EQ(5.0, values[0]);
+
+  EXPECT_THROW(online_signal_smoothing::ButterworthFilterBank(Eigen::ArrayXd::Constant(2, 0.5)), std::length_error);
+}
+
+TEST(SMOOTHING_PLUGINS, PluginRejectsUnstableCoefficients)
+{
+  const auto make_node = [](const std::vector<double>& coeffs) {
+    rclcpp::NodeOptions options;
+    options.parameter_overrides({ { "butterworth_filter_coeffs", coeffs } });
+    return std::make_shared<rclcpp::Node>("butterworth_filter_test", options);
+  };
+
+  // Coefficients below 1.0 fail the parameter validation, and a coefficient of 1.0 is rejected by the filter.
+  online_signal_smoothing::ButterworthFilterPlugin plugin;
+  EXPECT_FALSE(plugin.initialize(make_node({ 2.0, 0.5 }), nullptr, 2));
+  EXPECT_FALSE(plugin.initialize(make_node({ 2.0, 1.0 }), nullptr, 2));
+  EXPECT_TRUE(plugin.initialize(make_node({ 2.0, 3.0 }), nullptr, 2));
+}
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,135 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/*      Title     : test_ruckig_filter.cpp
+ *      Project   : moveit_core
+ *      Created   : 10/17/2026
+ *      Desc      : Unit test for online_signal_smoothing::RuckigFilterPlugin
+ */
+
+#include <gtest/gtest.h>
+#include <moveit/online_signal_smoothing/ruckig_filter.h>
+#include <moveit/utils/robot_model_test_utils.h>
+
+namespace
+{
+constexpr double UPDATE_PERIOD = 0.01;  // s
+constexpr double EPSILON = 1e-6;
+}  // namespace
+
+class RuckigFilterTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    rclcpp::NodeOptions options;
+    options.parameter_overrides({ { "planning_group_name", "panda_arm" }, { "update_period", UPDATE_PERIOD } });
+    node_ = std::make_shared<rclcpp::Node>("ruckig_filter_test", options);
+    num_joints_ = robot_model_->getJointModelGroup("panda_arm")->getActiveJointModelNames().size();
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  rclcpp::Node::SharedPtr node_;
+  size_t num_joints_;
+};
+
+TEST_F(RuckigFilterTest, InitializeChecksJointCount)
+{
+  online_signal_smoothing::RuckigFilterPlugin plugin;
+  EXPECT_FALSE(plugin.initialize(node_, robot_model_, num_joints_ + 1));
+  EXPECT_TRUE(plugin.initialize(node_, robot_model_, num_joints_));
+}
+
+TEST_F(RuckigFilterTest, StepCommandRespectsLimits)
+{
+  online_signal_smoothing::RuckigFilterPlugin plugin;
+  ASSERT_TRUE(plugin.initialize(node_, robot_model_, num_joints_));
+  ASSERT_TRUE(plugin.reset(std::vector<double>(num_joints_, 0.0)));
+
+  const moveit::core::JointBoundsVector& joint_bounds =
+      robot_model_->getJointModelGroup("panda_arm")->getActiveJointModelsBounds();
+
+  const double target = 0.5;
+  std::vector<double> positions, velocities(num_joints_), accelerations(num_joints_);
+  std::vector<double> previous_accelerations(num_joints_, 0.0);
+  for (size_t step = 0; step < 1000; ++step)
+  {
+    positions.assign(num_joints_, target);
+    ASSERT_TRUE(plugin.doSmoothing(positions, velocities, accelerations));
+    for (size_t i = 0; i < num_joints_; ++i)
+    {
+      const moveit::core::VariableBounds& bounds = joint_bounds[i]->front();
+      if (bounds.velocity_bounded_)
+        EXPECT_LE(std::abs(velocities[i]), bounds.max_velocity_ + EPSILON);
+      if (bounds.acceleration_bounded_)
+        EXPECT_LE(std::abs(accelerations[i]), bounds.max_acceleration_ + EPSILON);
+      if (bounds.jerk_bounded_)
+        EXPECT_LE(std::abs(accelerations[i] - previous_accelerations[i]) / UPDATE_PERIOD, bounds.max_jerk_ + EPSILON);
+    }
+    previous_accelerations = accelerations;
+  }
+
+  // The output settles at the commanded position.
+  for (size_t i = 0; i < num_joints_; ++i)
+  {
+    EXPECT_NEAR(positions[i], target, EPSILON);
+    EXPECT_NEAR(velocities[i], 0.0, EPSILON);
+  }
+}
+
+TEST_F(RuckigFilterTest, DoesNotJumpToStepCommand)
+{
+  online_signal_smoothing::RuckigFilterPlugin plugin;
+  ASSERT_TRUE(plugin.initialize(node_, robot_model_, num_joints_));
+  ASSERT_TRUE(plugin.reset(std::vector<double>(num_joints_, 0.0)));
+
+  // Starting from rest, the first setpoint moves less than a jerk-limited motion can in one period.
+  std::vector<double> positions(num_joints_, 1.0);
+  ASSERT_TRUE(plugin.doSmoothing(positions));
+  for (const double position : positions)
+  {
+    EXPECT_GT(position, 0.0);
+    EXPECT_LT(position, 0.01);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,134 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace moveit
+{
+namespace core
+{
+/** \brief Accumulated timing statistics of a traced stage. All durations are in seconds. */
+struct LatencyStatistics
+{
+  std::size_t count = 0;
+  double total = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  double last = 0.0;
+
+  double mean() const
+  {
+    return count > 0 ? total / count : 0.0;
+  }
+};
+
+/** \brief Collects the durations of named stages, e.g. of the trajectory execution pipeline.
+
+    Tracing is disabled by default, in which case record() returns immediately. The process-wide instance returned by
+    getGlobal() is shared by all components, so stages measured in different libraries can be queried and published
+    from a single place. */
+class LatencyTracer
+{
+public:
+  static LatencyTracer& getGlobal();
+
+  void setEnabled(bool enabled)
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool isEnabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /** \brief Add a measured \e duration (in seconds) of \e stage to the statistics. Ignored if tracing is disabled. */
+  void record(const std::string& stage, double duration);
+
+  /** \brief Get a copy of the statistics of all stages recorded since the last reset() */
+  std::map<std::string, LatencyStatistics> getStatistics() const;
+
+  /** \brief Get the statistics of \e stage. Returns false if the stage was not recorded since the last reset() */
+  bool getStatistics(const std::string& stage, LatencyStatistics& statistics) const;
+
+  void reset();
+
+private:
+  std::atomic<bool> enabled_{ false };
+  mutable std::mutex statistics_mutex_;
+  std::map<std::string, LatencyStatistics> statistics_;
+};
+
+/** \brief Records the time from construction until destruction (or stop()) as one sample of a stage */
+class ScopedLatencyTrace
+{
+public:
+  explicit ScopedLatencyTrace(std::string stage, LatencyTracer& tracer = LatencyTracer::getGlobal())
+    : tracer_(tracer), stage_(std::move(stage)), start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~ScopedLatencyTrace()
+  {
+    stop();
+  }
+
+  ScopedLatencyTrace(const ScopedLatencyTrace&) = delete;
+  ScopedLatencyTrace& operator=(const ScopedLatencyTrace&) = delete;
+
+  /** \brief Record the elapsed time now instead of on destruction */
+  void stop()
+  {
+    if (stopped_)
+      return;
+    stopped_ = true;
+    if (tracer_.isEnabled())
+      tracer_.record(stage_, std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+  }
+
+private:
+  LatencyTracer& tracer_;
+  std::string stage_;
+  std::chrono::steady_clock::time_point start_;
+  bool stopped_ = false;
+};
+}  // namespace core
+}  // namespace moveit
@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/utils/latency_tracer.h>
+#include <algorithm>
+
+namespace moveit
+{
+namespace core
+{
+LatencyTracer& LatencyTracer::getGlobal()
+{
+  static LatencyTracer tracer;
+  return tracer;
+}
+
+void LatencyTracer::record(const std::string& stage, double duration)
+{
+  if (!isEnabled())
+    return;
+
+  std::scoped_lock slock(statistics_mutex_);
+  LatencyStatistics& statistics = statistics_[stage];
+  if (statistics.count == 0)
+  {
+    statistics.min = duration;
+    statistics.max = duration;
+  }
+  else
+  {
+    statistics.min = std::min(statistics.min, duration);
+    statistics.max = std::max(statistics.max, duration);
+  }
+  ++statistics.count;
+  statistics.total += duration;
+  statistics.last = duration;
+}
+
+std::map<std::string, LatencyStatistics> LatencyTracer::getStatistics() const
+{
+  std::scoped_lock slock(statistics_mutex_);
+  return statistics_;
+}
+
+bool LatencyTracer::getStatistics(const std::string& stage, LatencyStatistics& statistics) const
+{
+  std::scoped_lock slock(statistics_mutex_);
+  const auto it = statistics_.find(stage);
+  if (it == statistics_.end())
+    return false;
+  statistics = it->second;
+  return true;
+}
+
+void LatencyTracer::reset()
+{
+  std::scoped_lock slock(statistics_mutex_);
+  statistics_.clear();
+}
+}  // namespace core
+}  // namespace moveit
@@ -0,0 +1,91 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/utils/latency_tracer.h>
+#include <thread>
+
+using moveit::core::LatencyStatistics;
+using moveit::core::LatencyTracer;
+using moveit::core::ScopedLatencyTrace;
+
+TEST(LatencyTracer, DisabledByDefault)
+{
+  LatencyTracer tracer;
+  tracer.record("stage", 1.0);
+  EXPECT_TRUE(tracer.getStatistics().empty());
+}
+
+TEST(LatencyTracer, AccumulatesStatistics)
+{
+  LatencyTracer tracer;
+  tracer.setEnabled(true);
+  tracer.record("stage", 2.0);
+  tracer.record("stage", 1.0);
+  tracer.record("stage", 3.0);
+
+  LatencyStatistics statistics;
+  ASSERT_TRUE(tracer.getStatistics("stage", statistics));
+  EXPECT_EQ(statistics.count, 3u);
+  EXPECT_DOUBLE_EQ(statistics.min, 1.0);
+  EXPECT_DOUBLE_EQ(statistics.max, 3.0);
+  EXPECT_DOUBLE_EQ(statistics.last, 3.0);
+  EXPECT_DOUBLE_EQ(statistics.mean(), 2.0);
+  EXPECT_FALSE(tracer.getStatistics("other", statistics));
+
+  tracer.reset();
+  EXPECT_TRUE(tracer.getStatistics().empty());
+}
+
+TEST(LatencyTracer, ScopedTraceRecordsOnce)
+{
+  LatencyTracer tracer;
+  tracer.setEnabled(true);
+  {
+    ScopedLatencyTrace trace("scoped", tracer);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    trace.stop();
+  }
+
+  LatencyStatistics statistics;
+  ASSERT_TRUE(tracer.getStatistics("scoped", statistics));
+  EXPECT_EQ(statistics.count, 1u);
+  EXPECT_GE(statistics.last, 0.01);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
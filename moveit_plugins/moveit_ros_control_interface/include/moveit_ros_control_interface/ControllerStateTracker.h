@@ -0,0 +1,103 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <controller_manager_msgs/msg/controller_state.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace moveit_ros_control_interface
+{
+/**
+ * \brief Keeps the controller states of a controller manager up to date in the background.
+ *
+ * The states are fetched periodically from a background thread, so callers never have to block on the controller
+ * manager. The fetch function is usually a list_controllers service call, but can be any stand-in, e.g. for tests.
+ * The update callback is called whenever the states changed.
+ */
+class ControllerStateTracker
+{
+public:
+  using Controllers = std::vector<controller_manager_msgs::msg::ControllerState>;
+  /** \brief Fetch the current controller states. Returns false on failure, e.g. on a timeout */
+  using ListControllersFn = std::function<bool(Controllers&)>;
+  using UpdateCallback = std::function<void(const Controllers&)>;
+
+  ControllerStateTracker(ListControllersFn list_controllers, UpdateCallback on_update,
+                         std::chrono::duration<double> period);
+
+  /** \brief Stops the background thread */
+  ~ControllerStateTracker();
+
+  ControllerStateTracker(const ControllerStateTracker&) = delete;
+  ControllerStateTracker& operator=(const ControllerStateTracker&) = delete;
+
+  /** \brief Start fetching the controller states in the background */
+  void start();
+
+  /** \brief Stop fetching the controller states in the background. Once this returns, no updates are reported */
+  void stop();
+
+  /**
+   * \brief Fetch the controller states right away, e.g. after switching controllers.
+   * The update callback is called before this returns if the states changed.
+   * @return false if fetching failed
+   */
+  bool refresh();
+
+  /** \brief Number of successful fetches so far */
+  std::size_t getFetchCount() const;
+
+private:
+  void run();
+
+  ListControllersFn list_controllers_;
+  UpdateCallback on_update_;
+  std::chrono::duration<double> period_;
+
+  std::thread thread_;
+  bool running_ = false;
+  std::mutex run_mutex_;  // protects running_
+  std::condition_variable run_condition_;
+
+  mutable std::mutex fetch_mutex_;  // serializes fetching and reporting of updates, protects below members
+  Controllers controllers_;
+  std::size_t fetch_count_ = 0;
+};
+}  // namespace moveit_ros_control_interface
@@ -37,6 +37,7 @@
 #include <moveit/macros/class_forward.h>
 #include <moveit/utils/rclcpp_utils.h>
 #include <moveit_ros_control_interface/ControllerHandle.h>
+#include <moveit_ros_control_interface/ControllerStateTracker.h>
 #include <moveit/controller_manager/controller_manager.h>
 #include <controller_manager_msgs/srv/list_controllers.hpp>
 #include <controller_manager_msgs/srv/switch_controller.hpp>
@@ -51,6 +52,8 @@
 #include <rclcpp/node.hpp>
 #include <rclcpp/parameter_value.hpp>
 #include <rclcpp/time.hpp>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <queue>
@@ -58,6 +61,7 @@
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit.plugins.ros_control_interface");
 static const rclcpp::Duration CONTROLLER_INFORMATION_VALIDITY_AGE = rclcpp::Duration::from_seconds(1.0);
 static const double SERVICE_CALL_TIMEOUT = 1.0;
+static const double DEFAULT_CONTROLLER_STATE_UPDATE_PERIOD = 0.5;
 
 namespace moveit_ros_control_interface
 {
@@ -100,10 +104,8 @@ class Ros2ControlManager : public moveit_controller_manager::MoveItControllerMan
   typedef std::map<std::string, moveit_controller_manager::MoveItControllerHandlePtr> HandleMap;
   HandleMap handles_;
 
-  rclcpp::Time controllers_stamp_{ 0, 0, RCL_ROS_TIME };
-
   /**
-   * @brief Protects access to managed_controllers_, active_controllers_, allocators_, handles_, and controllers_stamp.
+   * @brief Protects access to managed_controllers_, active_controllers_, allocators_, handles_ and dependency_map_.
    */
   std::mutex controllers_mutex_;
 
@@ -114,6 +116,12 @@ class Ros2ControlManager : public moveit_controller_manager::MoveItControllerMan
   // Chained controllers have dependencies (other controllers which must be running)
   std::unordered_map<std::string /* controller name */, std::vector<std::string> /* dependencies */> dependency_map_;
 
+  // Keeps the controller information up to date in the background, so queries never wait for the controller manager
+  std::unique_ptr<ControllerStateTracker> state_tracker_;
+
+  // Incremented whenever the controller information is updated, starts at 1 since 0 reports that changes are unknown
+  std::atomic<std::uint64_t> controllers_revision_{ 1 };
+
   /**
    * \brief Check if given controller is active
    * @param s state of controller
@@ -125,23 +133,13 @@ class Ros2ControlManager : public moveit_controller_manager::MoveItControllerMan
   }
 
   /**
-   * \brief  Call list_controllers and populate managed_controllers_ and active_controllers_. Allocates handles if
-   * needed.
-   * Throttled down to 1 Hz, controllers_mutex_ must be locked externally
-   * @param force force rediscover
+   * \brief Call list_controllers and report the controller states.
+   * Called from the background thread of state_tracker_, controllers_mutex_ must not be locked
+   * @param[out] controllers states of all controllers
+   * @return false if the service did not respond in time
    */
-  void discover(bool force = false)
+  bool listControllers(ControllerStateTracker::Controllers& controllers)
   {
-    // Skip if controller stamp is too new for new discovery, enforce update if force==true
-    if (!force && ((node_->now() - controllers_stamp_) < CONTROLLER_INFORMATION_VALIDITY_AGE))
-    {
-      RCLCPP_WARN_STREAM(LOGGER, "Controller information from " << list_controllers_service_->get_service_name()
-                                                                << " is out of date, skipping discovery");
-      return;
-    }
-
-    controllers_stamp_ = node_->now();
-
     auto request = std::make_shared<controller_manager_msgs::srv::ListControllers::Request>();
     auto result_future = list_controllers_service_->async_send_request(request);
     if (result_future.wait_for(std::chrono::duration<double>(SERVICE_CALL_TIMEOUT)) == std::future_status::timeout)
@@ -149,19 +147,30 @@ class Ros2ControlManager : public moveit_controller_manager::MoveItControllerMan
       RCLCPP_WARN_STREAM(LOGGER, "Failed to read controllers from " << list_controllers_service_->get_service_name()
                                                                     << " within " << SERVICE_CALL_TIMEOUT
                                                                     << " seconds");
-      return;
+      return false;
     }
+    controllers = result_future.get()->controller;
+    return true;
+  }
 
-    managed_controllers_.clear();
-    active_controllers_.clear();
-
-    auto result = result_future.get();
-    if (!Ros2ControlManager::fixChainedControllers(result))
+  /**
+   * \brief Populate managed_controllers_ and active_controllers_ from the controller states reported by
+   * state_tracker_. Allocates handles if needed.
+   * @param controllers states of all controllers
+   */
+  void updateControllers(ControllerStateTracker::Controllers controllers)
+  {
+    std::scoped_lock<std::mutex> lock(controllers_mutex_);
+    if (!fixChainedControllers(controllers))
     {
       return;
     }
 
-    for (const controller_manager_msgs::msg::ControllerState& controller : result->controller)
+    managed_controllers_.clear();
+    active_controllers_.clear();
+    ++controllers_revision_;
+
+    for (const controller_manager_msgs::msg::ControllerState& controller : controllers)
     {
       // If the controller is active, add it to the map of active controllers.
       if (isActive(controller))
@@ -275,8 +284,28 @@ public:
     switch_controller_service_ = node_->create_client<controller_manager_msgs::srv::SwitchController>(
         getAbsName("controller_manager/switch_controller"));
 
-    std::scoped_lock<std::mutex> lock(controllers_mutex_);
-    discover(true);
+    double update_period = DEFAULT_CONTROLLER_STATE_UPDATE_PERIOD;
+    if (!node_->has_parameter("ros_control_state_update_period"))
+    {
+      update_period = node_->declare_parameter<double>("ros_control_state_update_period", update_period);
+    }
+    else
+    {
+      node_->get_parameter<double>("ros_control_state_update_period", update_period);
+    }
+
+    state_tracker_ = std::make_unique<ControllerStateTracker>(
+        [this](ControllerStateTracker::Controllers& controllers) { return listControllers(controllers); },
+        [this](const ControllerStateTracker::Controllers& controllers) { updateControllers(controllers); },
+        std::chrono::duration<double>(update_period));
+    state_tracker_->refresh();
+    state_tracker_->start();
+  }
+
+  ~Ros2ControlManager() override
+  {
+    // the tracker's background thread uses this instance, so it must be stopped first
+    state_tracker_.reset();
   }
   /**
    * \brief Find and return the pre-allocated handle for the given controller.
@@ -295,13 +324,12 @@ public:
   }
 
   /**
-   * \brief Refresh controller list and output all managed controllers
+   * \brief Output all managed controllers, as last reported by the controller manager
    * @param[out] names list of controllers (with namespace)
    */
   void getControllersList(std::vector<std::string>& names) override
   {
     std::scoped_lock<std::mutex> lock(controllers_mutex_);
-    discover();
 
     for (std::pair<const std::string, controller_manager_msgs::msg::ControllerState>& managed_controller :
          managed_controllers_)
@@ -311,13 +339,12 @@ public:
   }
 
   /**
-   * \brief Refresh controller list and output all active, managed controllers
+   * \brief Output all active, managed controllers, as last reported by the controller manager
    * @param[out] names list of controllers (with namespace)
    */
   void getActiveControllers(std::vector<std::string>& names) override
   {
     std::scoped_lock<std::mutex> lock(controllers_mutex_);
-    discover();
 
     for (std::pair<const std::string, controller_manager_msgs::msg::ControllerState>& managed_controller :
          managed_controllers_)
@@ -346,14 +373,14 @@ public:
   }
 
   /**
-   * \brief Refresh controller state and output the state of the given one, only active_ will be set
+   * \brief Output the state of the given controller, as last reported by the controller manager. Only active_ will be
+   * set
    * @param[in] name name of controller (with namespace)
    * @return state
    */
   ControllerState getControllerState(const std::string& name) override
   {
     std::scoped_lock<std::mutex> lock(controllers_mutex_);
-    discover();
 
     ControllerState c;
     ControllersMap::iterator it = managed_controllers_.find(name);
@@ -364,6 +391,15 @@ public:
     return c;
   }
 
+  /**
+   * \brief Report the number of updates of the controller information. The state tracker only updates it when the
+   * controller manager reports different controllers or states.
+   */
+  std::uint64_t getControllersRevision() override
+  {
+    return controllers_revision_;
+  }
+
   /**
    * \brief Filter lists for managed controller and computes switching set.
    * Stopped list might be extended by unsupported controllers that claim needed resources
@@ -374,6 +410,10 @@ public:
   bool switchControllers(const std::vector<std::string>& activate_base,
                          const std::vector<std::string>& deactivate_base) override
   {
+    // compute the switch from the current controller states
+    state_tracker_->refresh();
+    std::unique_lock<std::mutex> lock(controllers_mutex_);
+
     // add controller dependencies
     std::vector<std::string> activate = activate_base;
     std::vector<std::string> deactivate = deactivate_base;
@@ -395,9 +435,6 @@ public:
     // activation dependencies must be started first, but they are processed last, so the order needs to be flipped
     std::reverse(activate.begin(), activate.end());
 
-    std::scoped_lock<std::mutex> lock(controllers_mutex_);
-    discover(true);
-
     // Holds the list of controllers that are currently active and their resources
     // Example:
     // controller1:
@@ -479,7 +516,8 @@ public:
                                                                       << " seconds");
         return false;
       }
-      discover(true);
+      lock.unlock();
+      state_tracker_->refresh();
       return result_future.get()->ok;
     }
     return true;
@@ -489,14 +527,14 @@ public:
    * Since chained controllers cannot be written to directly, they are removed from the response and their interfaces
    * are propagated back to the first controller with a non-chained input
    */
-  bool fixChainedControllers(std::shared_ptr<controller_manager_msgs::srv::ListControllers::Response>& result)
+  bool fixChainedControllers(ControllerStateTracker::Controllers& controllers)
   {
     std::unordered_map<std::string, size_t> controller_name_map;
-    for (size_t i = 0; i < result->controller.size(); ++i)
+    for (size_t i = 0; i < controllers.size(); ++i)
     {
-      controller_name_map[result->controller[i].name] = i;
+      controller_name_map[controllers[i].name] = i;
     }
-    for (auto& controller : result->controller)
+    for (auto& controller : controllers)
     {
       if (controller.chain_connections.size() > 1)
       {
@@ -509,10 +547,10 @@ public:
       {
         auto ind = controller_name_map[chained_controller.name];
         dependency_map_[controller.name].push_back(chained_controller.name);
-        controller.required_command_interfaces = result->controller[ind].required_command_interfaces;
-        controller.claimed_interfaces = result->controller[ind].claimed_interfaces;
-        result->controller[ind].claimed_interfaces.clear();
-        result->controller[ind].required_command_interfaces.clear();
+        controller.required_command_interfaces = controllers[ind].required_command_interfaces;
+        controller.claimed_interfaces = controllers[ind].claimed_interfaces;
+        controllers[ind].claimed_interfaces.clear();
+        controllers[ind].required_command_interfaces.clear();
       }
     }
 
@@ -667,6 +705,25 @@ public:
     return ControllerState();
   }
 
+  /**
+   * \brief Combine the revisions of all discovered interfaces, discovering a new interface changes the result too
+   * @return revision
+   */
+  std::uint64_t getControllersRevision() override
+  {
+    std::unique_lock<std::mutex> lock(controller_managers_mutex_);
+    discover();
+
+    // the revisions of the interfaces only increase and are at least 1
+    std::uint64_t revision = 0;
+    for (std::pair<const std::string, moveit_ros_control_interface::Ros2ControlManagerPtr>& controller_manager :
+         controller_managers_)
+    {
+      revision += controller_manager.second->getControllersRevision();
+    }
+    return revision;
+  }
+
   /**
    * \brief delegates switch to all known interfaces. Stops on first failing switch.
    * @param activate vector of controllers to be activated
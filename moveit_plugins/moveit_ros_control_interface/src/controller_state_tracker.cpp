@@ -0,0 +1,103 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit_ros_control_interface/ControllerStateTracker.h>
+
+namespace moveit_ros_control_interface
+{
+ControllerStateTracker::ControllerStateTracker(ListControllersFn list_controllers, UpdateCallback on_update,
+                                               std::chrono::duration<double> period)
+  : list_controllers_(std::move(list_controllers)), on_update_(std::move(on_update)), period_(period)
+{
+}
+
+ControllerStateTracker::~ControllerStateTracker()
+{
+  stop();
+}
+
+void ControllerStateTracker::start()
+{
+  std::scoped_lock lock(run_mutex_);
+  if (running_)
+    return;
+  running_ = true;
+  thread_ = std::thread(&ControllerStateTracker::run, this);
+}
+
+void ControllerStateTracker::stop()
+{
+  {
+    std::scoped_lock lock(run_mutex_);
+    if (!running_)
+      return;
+    running_ = false;
+  }
+  run_condition_.notify_all();
+  thread_.join();
+}
+
+bool ControllerStateTracker::refresh()
+{
+  Controllers controllers;
+  std::scoped_lock lock(fetch_mutex_);
+  if (!list_controllers_(controllers))
+    return false;
+
+  ++fetch_count_;
+  if (fetch_count_ > 1 && controllers == controllers_)
+    return true;
+  controllers_ = std::move(controllers);
+  on_update_(controllers_);
+  return true;
+}
+
+std::size_t ControllerStateTracker::getFetchCount() const
+{
+  std::scoped_lock lock(fetch_mutex_);
+  return fetch_count_;
+}
+
+void ControllerStateTracker::run()
+{
+  std::unique_lock<std::mutex> lock(run_mutex_);
+  while (running_)
+  {
+    lock.unlock();
+    refresh();
+    lock.lock();
+    run_condition_.wait_for(lock, period_, [this] { return !running_; });
+  }
+}
+}  // namespace moveit_ros_control_interface
@@ -0,0 +1,168 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit_ros_control_interface/ControllerStateTracker.h>
+#include <atomic>
+
+using moveit_ros_control_interface::ControllerStateTracker;
+
+namespace
+{
+// stand-in for the list_controllers service of a controller manager
+class FakeControllerManager
+{
+public:
+  bool listControllers(ControllerStateTracker::Controllers& controllers)
+  {
+    std::scoped_lock lock(mutex_);
+    ++calls_;
+    if (!available_)
+      return false;
+    controllers = controllers_;
+    return true;
+  }
+
+  void setControllerState(const std::string& name, const std::string& state)
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto& controller : controllers_)
+    {
+      if (controller.name == name)
+      {
+        controller.state = state;
+        return;
+      }
+    }
+    controller_manager_msgs::msg::ControllerState controller;
+    controller.name = name;
+    controller.state = state;
+    controllers_.push_back(controller);
+  }
+
+  void setAvailable(bool available)
+  {
+    std::scoped_lock lock(mutex_);
+    available_ = available;
+  }
+
+  std::size_t getCalls()
+  {
+    std::scoped_lock lock(mutex_);
+    return calls_;
+  }
+
+private:
+  std::mutex mutex_;
+  ControllerStateTracker::Controllers controllers_;
+  bool available_ = true;
+  std::size_t calls_ = 0;
+};
+
+template <typename Predicate>
+bool waitFor(const Predicate& predicate)
+{
+  for (int i = 0; i < 500 && !predicate(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  return predicate();
+}
+}  // namespace
+
+TEST(ControllerStateTracker, ReportsOnlyChanges)
+{
+  FakeControllerManager manager;
+  manager.setControllerState("arm_controller", "active");
+
+  std::size_t updates = 0;
+  ControllerStateTracker::Controllers last;
+  ControllerStateTracker tracker(
+      [&manager](ControllerStateTracker::Controllers& controllers) { return manager.listControllers(controllers); },
+      [&](const ControllerStateTracker::Controllers& controllers) {
+        ++updates;
+        last = controllers;
+      },
+      std::chrono::hours(1));
+
+  ASSERT_TRUE(tracker.refresh());
+  EXPECT_EQ(updates, 1u);
+  ASSERT_EQ(last.size(), 1u);
+  EXPECT_EQ(last[0].state, "active");
+
+  // unchanged states are not reported again
+  ASSERT_TRUE(tracker.refresh());
+  EXPECT_EQ(updates, 1u);
+  EXPECT_EQ(tracker.getFetchCount(), 2u);
+
+  manager.setControllerState("arm_controller", "inactive");
+  ASSERT_TRUE(tracker.refresh());
+  EXPECT_EQ(updates, 2u);
+  EXPECT_EQ(last[0].state, "inactive");
+
+  // failures keep the last known states
+  manager.setAvailable(false);
+  EXPECT_FALSE(tracker.refresh());
+  EXPECT_EQ(updates, 2u);
+}
+
+TEST(ControllerStateTracker, UpdatesInBackground)
+{
+  FakeControllerManager manager;
+  manager.setControllerState("arm_controller", "inactive");
+
+  std::atomic<bool> active{ false };
+  ControllerStateTracker tracker(
+      [&manager](ControllerStateTracker::Controllers& controllers) { return manager.listControllers(controllers); },
+      [&active](const ControllerStateTracker::Controllers& controllers) {
+        active = !controllers.empty() && controllers[0].state == "active";
+      },
+      std::chrono::milliseconds(5));
+  tracker.start();
+  EXPECT_TRUE(waitFor([&tracker] { return tracker.getFetchCount() > 0; }));
+  EXPECT_FALSE(active);
+
+  manager.setControllerState("arm_controller", "active");
+  EXPECT_TRUE(waitFor([&active] { return active.load(); }));
+
+  // no more fetches once stopped
+  tracker.stop();
+  const std::size_t calls = manager.getCalls();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(manager.getCalls(), calls);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -41,7 +41,11 @@
 #include <rclcpp_action/rclcpp_action.hpp>
 #include <moveit/controller_manager/controller_manager.h>
 #include <moveit/macros/class_forward.h>
+#include <moveit/utils/latency_tracer.h>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 namespace moveit_simple_controller_manager
 {
@@ -100,7 +104,7 @@ public:
     if (!done_)
     {
       RCLCPP_INFO_STREAM(logger_, "Cancelling execution for " << name_);
-      auto cancel_result_future = controller_action_client_->async_cancel_goal(current_goal_);
+      auto cancel_result_future = controller_action_client_->async_cancel_goal(getCurrentGoal());
 
       const auto& result = cancel_result_future.get();
       if (!result)
@@ -121,50 +125,23 @@ public:
 
   /**
    * @brief Blocks waiting for the action result to be received.
+   * If the goal is replaced by a continuation while waiting (see supportsTrajectoryReplacement()), this waits for the
+   * result of the continuation instead. The timeout applies to each goal waited for.
    * @param timeout Duration to wait for a result before failing. Default value indicates no timeout.
    * @return True if a result was received, false on timeout.
    */
   bool waitForExecution(const rclcpp::Duration& timeout = rclcpp::Duration::from_seconds(-1.0)) override
   {
-    auto result_callback_done = std::make_shared<std::promise<bool>>();
-    auto result_future = controller_action_client_->async_get_result(
-        current_goal_, [this, result_callback_done](const auto& wrapped_result) {
-          controllerDoneCallback(wrapped_result);
-          result_callback_done->set_value(true);
-        });
-    if (timeout < std::chrono::nanoseconds(0))
+    auto goal = getCurrentGoal();
+    while (true)
     {
-      result_future.wait();
+      if (!waitForResult(goal, timeout))
+        return false;
+      auto next_goal = getCurrentGoal();
+      if (next_goal == goal)
+        return true;
+      goal = next_goal;
     }
-    else
-    {
-      std::future_status status;
-      if (node_->get_parameter("use_sim_time").as_bool())
-      {
-        const auto start = node_->now();
-        do
-        {
-          status = result_future.wait_for(50ms);
-          if ((status == std::future_status::timeout) and ((node_->now() - start) > timeout))
-          {
-            RCLCPP_WARN(logger_, "waitForExecution timed out");
-            return false;
-          }
-        } while (status == std::future_status::timeout);
-      }
-      else
-      {
-        status = result_future.wait_for(timeout.to_chrono<std::chrono::duration<double>>());
-        if (status == std::future_status::timeout)
-        {
-          RCLCPP_WARN(logger_, "waitForExecution timed out");
-          return false;
-        }
-      }
-    }
-    // To accommodate for the delay after the future for the result is ready and the time controllerDoneCallback takes to finish
-    result_callback_done->get_future().wait();
-    return true;
   }
 
   moveit_controller_manager::ExecutionStatus getLastExecutionStatus() override
@@ -188,6 +165,58 @@ protected:
    */
   const rclcpp::Node::SharedPtr node_;
 
+  /**
+   * @brief Get the goal that is currently executed, waiting for a replacement of the goal to complete if necessary.
+   */
+  typename rclcpp_action::ClientGoalHandle<T>::SharedPtr getCurrentGoal()
+  {
+    std::unique_lock<std::mutex> lock(goal_mutex_);
+    goal_replaced_condition_.wait(lock, [this] { return !replacing_goal_; });
+    return current_goal_;
+  }
+
+  /**
+   * @brief Set the goal that is currently executed, synchronized with the result callbacks.
+   */
+  void setCurrentGoal(const typename rclcpp_action::ClientGoalHandle<T>::SharedPtr& goal)
+  {
+    std::scoped_lock lock(goal_mutex_);
+    current_goal_ = goal;
+  }
+
+  /**
+   * @brief Mark the start of sending a goal that replaces the one currently executed.
+   * Results received for the current goal in the meantime are deferred until endGoalReplacement() is called.
+   */
+  void beginGoalReplacement()
+  {
+    std::scoped_lock lock(goal_mutex_);
+    replacing_goal_ = true;
+  }
+
+  /**
+   * @brief Mark the end of sending a replacement goal.
+   * @param goal The goal that replaces the current one, or nullptr if the replacement was rejected, in which case the
+   * current goal is kept.
+   */
+  void endGoalReplacement(const typename rclcpp_action::ClientGoalHandle<T>::SharedPtr& goal)
+  {
+    {
+      std::scoped_lock lock(goal_mutex_);
+      replacing_goal_ = false;
+      if (goal)
+      {
+        current_goal_ = goal;
+      }
+      else if (deferred_result_)
+      {
+        controllerDoneCallback(*deferred_result_);
+      }
+      deferred_result_.reset();
+    }
+    goal_replaced_condition_.notify_all();
+  }
+
   /**
    * @brief Check if the controller's action server is ready to receive action goals.
    * @return True if the action server is ready, false if it is not ready or does not exist.
@@ -221,6 +250,12 @@ protected:
   void finishControllerExecution(const rclcpp_action::ResultCode& state)
   {
     RCLCPP_DEBUG_STREAM(logger_, "Controller " << name_ << " is done with state " << static_cast<int>(state));
+    moveit::core::LatencyTracer& tracer = moveit::core::LatencyTracer::getGlobal();
+    if (tracer.isEnabled())
+    {
+      tracer.record("controller/" + name_ + "/execution",
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - goal_sent_time_).count());
+    }
     if (state == rclcpp_action::ResultCode::SUCCEEDED)
     {
       last_exec_ = moveit_controller_manager::ExecutionStatus::SUCCEEDED;
@@ -273,6 +308,83 @@ protected:
    * @brief Current goal that has been sent to the action server.
    */
   typename rclcpp_action::ClientGoalHandle<T>::SharedPtr current_goal_;
+
+  /**
+   * @brief Time the last goal was sent to the action server, for latency tracing.
+   */
+  std::chrono::steady_clock::time_point goal_sent_time_;
+
+private:
+  /**
+   * @brief Blocks waiting for the result of a particular goal.
+   * @return True if a result was received, false on timeout.
+   */
+  bool waitForResult(const typename rclcpp_action::ClientGoalHandle<T>::SharedPtr& goal,
+                     const rclcpp::Duration& timeout)
+  {
+    auto result_callback_done = std::make_shared<std::promise<bool>>();
+    auto result_future = controller_action_client_->async_get_result(
+        goal, [this, goal, result_callback_done](const auto& wrapped_result) {
+          {
+            std::scoped_lock lock(goal_mutex_);
+            // results of goals that were replaced by a continuation are not reported
+            if (goal == current_goal_)
+            {
+              if (replacing_goal_)
+              {
+                deferred_result_ = std::make_unique<typename rclcpp_action::ClientGoalHandle<T>::WrappedResult>(
+                    wrapped_result);
+              }
+              else
+              {
+                controllerDoneCallback(wrapped_result);
+              }
+            }
+          }
+          result_callback_done->set_value(true);
+        });
+    if (timeout < std::chrono::nanoseconds(0))
+    {
+      result_future.wait();
+    }
+    else
+    {
+      std::future_status status;
+      if (node_->get_parameter("use_sim_time").as_bool())
+      {
+        const auto start = node_->now();
+        do
+        {
+          status = result_future.wait_for(50ms);
+          if ((status == std::future_status::timeout) and ((node_->now() - start) > timeout))
+          {
+            RCLCPP_WARN(logger_, "waitForExecution timed out");
+            return false;
+          }
+        } while (status == std::future_status::timeout);
+      }
+      else
+      {
+        status = result_future.wait_for(timeout.to_chrono<std::chrono::duration<double>>());
+        if (status == std::future_status::timeout)
+        {
+          RCLCPP_WARN(logger_, "waitForExecution timed out");
+          return false;
+        }
+      }
+    }
+    // To accommodate for the delay after the future for the result is ready and the time controllerDoneCallback takes to finish
+    result_callback_done->get_future().wait();
+    return true;
+  }
+
+  /**
+   * @brief Protects current_goal_ while it is replaced by a continuation.
+   */
+  std::mutex goal_mutex_;
+  std::condition_variable goal_replaced_condition_;
+  bool replacing_goal_ = false;
+  std::unique_ptr<typename rclcpp_action::ClientGoalHandle<T>::WrappedResult> deferred_result_;
 };
 
 }  // namespace moveit_simple_controller_manager
@@ -61,6 +61,11 @@ public:
 
   bool sendTrajectory(const moveit_msgs::msg::RobotTrajectory& trajectory) override;
 
+  bool supportsTrajectoryReplacement() const override
+  {
+    return true;
+  }
+
   // TODO(JafarAbdi): Revise parameter lookup
   // void configure(XmlRpc::XmlRpcValue& config) override;
 
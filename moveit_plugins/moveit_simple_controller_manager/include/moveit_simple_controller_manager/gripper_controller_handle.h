@@ -153,9 +153,13 @@ public:
         [this](const rclcpp_action::Client<control_msgs::action::GripperCommand>::GoalHandle::SharedPtr&
                /* unused-arg */) { RCLCPP_DEBUG_STREAM(logger_, name_ << " started execution"); };
     // Send goal
+    goal_sent_time_ = std::chrono::steady_clock::now();
+    moveit::core::ScopedLatencyTrace goal_trace("controller/" + name_ + "/send_goal");
     auto current_goal_future = controller_action_client_->async_send_goal(goal, send_goal_options);
-    current_goal_ = current_goal_future.get();
-    if (!current_goal_)
+    auto new_goal = current_goal_future.get();
+    goal_trace.stop();
+    setCurrentGoal(new_goal);
+    if (!new_goal)
     {
       RCLCPP_ERROR(logger_, "Goal was rejected by server");
       return false;
@@ -54,13 +54,16 @@ bool FollowJointTrajectoryControllerHandle::sendTrajectory(const moveit_msgs::ms
     return false;
   }
 
-  if (done_)
+  // the controller replaces the trajectory it is executing at the time given by the header stamp of the new one
+  const bool replace = !done_;
+  if (replace)
   {
-    RCLCPP_INFO_STREAM(logger_, "sending trajectory to " << name_);
+    RCLCPP_INFO_STREAM(logger_, "sending continuation for the currently executed trajectory to " << name_);
+    beginGoalReplacement();
   }
   else
   {
-    RCLCPP_INFO_STREAM(logger_, "sending continuation for the currently executed trajectory to " << name_);
+    RCLCPP_INFO_STREAM(logger_, "sending trajectory to " << name_);
   }
 
   control_msgs::action::FollowJointTrajectory::Goal goal = goal_template_;
@@ -87,9 +90,21 @@ bool FollowJointTrajectoryControllerHandle::sendTrajectory(const moveit_msgs::ms
   last_exec_ = moveit_controller_manager::ExecutionStatus::RUNNING;
 
   // Send goal
+  goal_sent_time_ = std::chrono::steady_clock::now();
+  moveit::core::ScopedLatencyTrace goal_trace("controller/" + name_ + "/send_goal");
   auto current_goal_future = controller_action_client_->async_send_goal(goal, send_goal_options);
-  current_goal_ = current_goal_future.get();
-  if (!current_goal_)
+  auto new_goal = current_goal_future.get();
+  goal_trace.stop();
+  if (replace)
+  {
+    // a rejected continuation leaves the current trajectory executing
+    endGoalReplacement(new_goal);
+  }
+  else
+  {
+    setCurrentGoal(new_goal);
+  }
+  if (!new_goal)
   {
     RCLCPP_ERROR(logger_, "Goal was rejected by server");
     return false;
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, PickNik Robotics, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+
+/*      Title     : servo_replay_benchmark.cpp
+ *      Project   : moveit_servo
+ *      Created   : 10/17/2026
+ *
+ *      Description : Replays a recorded stream of servo commands through the C++ API, without any ROS transport,
+ *                    and reports the latency of each stage of the servo cycle and the command throughput.
+ *
+ *      The commands are read from the file given by the parameter "command_file", one command per line:
+ *        twist <frame> <vx> <vy> <vz> <wx> <wy> <wz>
+ *        joint_jog <n> <name_1> ... <name_n> <velocity_1> ... <velocity_n>
+ *        pose <frame> <x> <y> <z> <qx> <qy> <qz> <qw>
+ *      Empty lines and lines starting with '#' are skipped. If no file is given, "num_commands" twist commands
+ *      following a sine wave are generated. The commands are processed back to back and the results are not sent
+ *      to the robot, so every command is computed from the same robot state.
+ */
+
+#include <moveit_servo/servo.hpp>
+#include <moveit_servo/utils/common.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace moveit_servo;
+
+namespace
+{
+const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_servo.replay_benchmark");
+
+bool parseCommand(const std::string& line, ServoInput& command)
+{
+  std::istringstream stream(line);
+  std::string type;
+  stream >> type;
+  if (type == "twist")
+  {
+    TwistCommand twist;
+    stream >> twist.frame_id;
+    for (Eigen::Index i = 0; i < twist.velocities.size(); ++i)
+    {
+      stream >> twist.velocities[i];
+    }
+    command = twist;
+  }
+  else if (type == "joint_jog")
+  {
+    std::size_t num_joints = 0;
+    stream >> num_joints;
+    JointJogCommand joint_jog;
+    joint_jog.names.resize(num_joints);
+    joint_jog.velocities.resize(num_joints);
+    for (std::string& name : joint_jog.names)
+    {
+      stream >> name;
+    }
+    for (double& velocity : joint_jog.velocities)
+    {
+      stream >> velocity;
+    }
+    command = joint_jog;
+  }
+  else if (type == "pose")
+  {
+    PoseCommand pose;
+    Eigen::Vector3d position;
+    Eigen::Quaterniond orientation;
+    stream >> pose.frame_id >> position.x() >> position.y() >> position.z() >> orientation.x() >> orientation.y() >>
+        orientation.z() >> orientation.w();
+    pose.pose = Eigen::Translation3d(position) * orientation.normalized();
+    command = pose;
+  }
+  else
+  {
+    return false;
+  }
+  return !stream.fail();
+}
+
+std::vector<ServoInput> loadCommands(const std::string& command_file)
+{
+  std::vector<ServoInput> commands;
+  std::ifstream file(command_file);
+  if (!file)
+  {
+    RCLCPP_ERROR_STREAM(LOGGER, "Could not open command file " << command_file);
+    return commands;
+  }
+
+  std::string line;
+  std::size_t line_number = 0;
+  while (std::getline(file, line))
+  {
+    ++line_number;
+    if (line.empty() || line.front() == '#')
+    {
+      continue;
+    }
+    ServoInput command;
+    if (parseCommand(line, command))
+    {
+      commands.push_back(command);
+    }
+    else
+    {
+      RCLCPP_WARN_STREAM(LOGGER, "Skipping malformed command on line " << line_number << " of " << command_file);
+    }
+  }
+  return commands;
+}
+
+std::vector<ServoInput> generateCommands(const std::string& frame_id, const std::size_t num_commands)
+{
+  std::vector<ServoInput> commands;
+  commands.reserve(num_commands);
+  for (std::size_t i = 0; i < num_commands; ++i)
+  {
+    const double phase = 2.0 * M_PI * static_cast<double>(i) / 500.0;
+    commands.push_back(TwistCommand{
+        frame_id, { 0.1 * std::sin(phase), 0.1 * std::cos(phase), 0.05, 0.0, 0.0, 0.2 * std::sin(phase) } });
+  }
+  return commands;
+}
+
+CommandType commandTypeOf(const ServoInput& command)
+{
+  if (std::holds_alternative<JointJogCommand>(command))
+  {
+    return CommandType::JOINT_JOG;
+  }
+  if (std::holds_alternative<TwistCommand>(command))
+  {
+    return CommandType::TWIST;
+  }
+  return CommandType::POSE;
+}
+
+// Prints the latency distribution of the samples [s] in microseconds.
+void reportLatency(const std::string& name, std::vector<double>& samples)
+{
+  if (samples.empty())
+  {
+    RCLCPP_INFO_STREAM(LOGGER, name << ": not executed");
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto percentile = [&samples](const double p) {
+    return 1e6 * samples[std::min(samples.size() - 1, static_cast<std::size_t>(p * samples.size()))];
+  };
+  double total = 0.0;
+  for (const double sample : samples)
+  {
+    total += sample;
+  }
+  RCLCPP_INFO(LOGGER, "%-48s n=%7zu  mean=%9.2f us  p50=%9.2f us  p99=%9.2f us  max=%9.2f us", name.c_str(),
+              samples.size(), 1e6 * total / samples.size(), percentile(0.5), percentile(0.99), 1e6 * samples.back());
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  rclcpp::init(argc, argv);
+
+  // The servo object expects to get a ROS node.
+  const rclcpp::Node::SharedPtr benchmark_node = std::make_shared<rclcpp::Node>("servo_replay_benchmark");
+  const std::string command_file = benchmark_node->declare_parameter<std::string>("command_file", "");
+  const int num_commands = benchmark_node->declare_parameter<int>("num_commands", 10000);
+  const int num_warmup_commands = benchmark_node->declare_parameter<int>("num_warmup_commands", 100);
+
+  // Get the servo parameters.
+  const std::string param_namespace = "moveit_servo";
+  const std::shared_ptr<const servo::ParamListener> servo_param_listener =
+      std::make_shared<const servo::ParamListener>(benchmark_node, param_namespace);
+  const servo::Params servo_params = servo_param_listener->get_params();
+
+  // Create the servo object
+  const planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor =
+      createPlanningSceneMonitor(benchmark_node, servo_params);
+  Servo servo = Servo(benchmark_node, servo_param_listener, planning_scene_monitor);
+
+  const std::vector<ServoInput> commands =
+      command_file.empty() ? generateCommands(servo_params.planning_frame, std::max(num_commands, 0)) :
+                             loadCommands(command_file);
+  if (commands.empty())
+  {
+    RCLCPP_ERROR(LOGGER, "No commands to replay, exiting.");
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+
+  // Let the caches and the smoothing filter settle before measuring.
+  for (int i = 0; i < num_warmup_commands; ++i)
+  {
+    const ServoInput& command = commands[i % commands.size()];
+    servo.setCommandType(commandTypeOf(command));
+    servo.getNextJointState(command);
+  }
+  servo.resetStageTimings();
+
+  std::vector<std::vector<double>> stage_samples(NUM_SERVO_STAGES);
+  std::vector<double> cycle_samples;
+  cycle_samples.reserve(commands.size());
+  for (std::vector<double>& samples : stage_samples)
+  {
+    samples.reserve(commands.size());
+  }
+
+  std::size_t num_invalid = 0;
+  StageTimings previous_timings = servo.getStageTimings();
+  const auto start_time = std::chrono::steady_clock::now();
+  for (const ServoInput& command : commands)
+  {
+    servo.setCommandType(commandTypeOf(command));
+    const auto cycle_start = std::chrono::steady_clock::now();
+    servo.getNextJointState(command);
+    cycle_samples.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - cycle_start).count());
+
+    if (servo.getStatus() == StatusCode::INVALID)
+    {
+      ++num_invalid;
+    }
+
+    // Stages that are skipped in a cycle, e.g. the smoothing of a halted command, are not sampled.
+    const StageTimings timings = servo.getStageTimings();
+    for (std::size_t stage = 0; stage < NUM_SERVO_STAGES; ++stage)
+    {
+      if (timings[stage].count != previous_timings[stage].count)
+      {
+        stage_samples[stage].push_back(timings[stage].last);
+      }
+    }
+    previous_timings = timings;
+  }
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+  RCLCPP_INFO_STREAM(LOGGER, "Replayed " << commands.size() << " commands (" << num_invalid << " invalid) in "
+                                         << elapsed << " s");
+  for (std::size_t stage = 0; stage < NUM_SERVO_STAGES; ++stage)
+  {
+    reportLatency(SERVO_STAGE_NAME_MAP.at(static_cast<ServoStage>(stage)), stage_samples[stage]);
+  }
+  reportLatency("Complete cycle", cycle_samples);
+  RCLCPP_INFO(LOGGER, "Throughput: %.1f commands/s", commands.size() / elapsed);
+
+  rclcpp::shutdown();
+  return EXIT_SUCCESS;
+}
@@ -42,8 +42,10 @@
 #pragma once
 
 #include <moveit_servo_lib_parameters.hpp>
+#include <moveit_servo/world_distance_field.hpp>
 #include <moveit/planning_scene_monitor/planning_scene_monitor.h>
 #include <moveit/planning_scene/planning_scene.h>
+#include <mutex>
 
 namespace moveit_servo
 {
@@ -58,12 +60,35 @@ public:
 
   void stop();
 
+  /**
+   * \brief Set the joint position change commanded in the current servo cycle, used for predicting collisions.
+   * This does not allocate memory once the size of the move group is known.
+   * @param joint_position_delta The commanded joint position change of the move group, before collision scaling.
+   * @param period The duration of a servo cycle [seconds].
+   */
+  void setCommandedJointDelta(const Eigen::VectorXd& joint_position_delta, double period);
+
 private:
   /**
    * \brief The collision checking function, this will run in a separate thread.
    */
   void checkCollisions();
 
+  /**
+   * \brief Compute the distance to the scene from the distance field of the world instead of the collision
+   * environment, updating the field with the changes of the world first. Like the collision environment, the
+   * distance skips the collisions allowed by the scene and includes the link padding.
+   * @param scene The locked planning scene.
+   */
+  void checkDistanceFieldCollision(const planning_scene::PlanningScene& scene);
+
+  /**
+   * \brief Compute the velocity scale from the predicted time to contact of the commanded motion.
+   * @param scene The locked planning scene.
+   * @return The fraction of the look-ahead horizon that is predicted to be collision free.
+   */
+  double lookAheadVelocityScale(const planning_scene::PlanningScene& scene);
+
   // Variables
 
   const servo::Params& servo_params_;
@@ -84,6 +109,16 @@ private:
   // The data structures used to get information about robot collision with other objects in the collision scene.
   collision_detection::CollisionRequest scene_collision_request_;
   collision_detection::CollisionResult scene_collision_result_;
+  // The distance field of the world, created when it is first used.
+  std::unique_ptr<WorldDistanceField> world_distance_field_;
+
+  // The latest commanded joint velocities, set by servo and read by the collision monitor thread.
+  std::mutex commanded_velocities_mutex_;
+  Eigen::VectorXd commanded_velocities_;
+  // The state and collision requests used for checking the predicted states.
+  moveit::core::RobotStatePtr predicted_state_;
+  collision_detection::CollisionRequest look_ahead_request_;
+  collision_detection::CollisionResult look_ahead_result_;
 };
 
 }  // namespace moveit_servo
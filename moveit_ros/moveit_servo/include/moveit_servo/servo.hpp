@@ -52,6 +52,7 @@
 #include <sensor_msgs/msg/joint_state.hpp>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <tf2_ros/transform_listener.h>
+#include <mutex>
 #include <variant>
 
 namespace moveit_servo
@@ -78,6 +79,25 @@ public:
    */
   KinematicState getNextJointState(const ServoInput& command);
 
+  /**
+   * \brief Computes the joint state required to follow the given command, writing it into an existing state.
+   * Once \e target_state and the internal buffers have been sized by a first call, this does not allocate memory
+   * for joint jog commands, which makes it suitable for use in a hard real-time control loop.
+   * @param command The command to follow, std::variant type, can handle JointJog, Twist and Pose.
+   * @param target_state The required joint state.
+   */
+  void getNextJointState(const ServoInput& command, KinematicState& target_state);
+
+  /**
+   * \brief Computes the joint state required to follow commands for several subgroups of the move group at once.
+   * All subgroups share the same robot state and collision check, the changes in joint position required by the
+   * commands are added up. The commands must match the expected command type. Subgroups that share joints with
+   * another commanded subgroup are rejected.
+   * @param commands The commands to follow, one per subgroup.
+   * @param target_state The required joint state.
+   */
+  void getNextJointState(const std::vector<SubgroupCommand>& commands, KinematicState& target_state);
+
   /**
    * \brief Set the type of incoming servo command.
    * @param command_type The type of command servo should expect.
@@ -131,6 +151,25 @@ public:
    */
   std::pair<bool, KinematicState> smoothHalt(const KinematicState& halt_state) const;
 
+  /**
+   * \brief Get the computation time spent in each stage of the servo cycles since the last reset.
+   * The collision checks themselves run in the collision monitor thread and are not part of the cycle.
+   * @return The timings, indexed by ServoStage.
+   */
+  StageTimings getStageTimings() const;
+
+  /**
+   * \brief Reset the timings of all stages of the servo cycle.
+   */
+  void resetStageTimings();
+
+  /**
+   * \brief Get the outcome of the iterative IK solve of the last pose command.
+   * Only updated if 'pose_tracking.use_iterative_ik' is enabled.
+   * @return Whether the solve converged, the number of iterations, the remaining error and the latency.
+   */
+  PoseTrackingReport getPoseTrackingReport() const;
+
 private:
   /**
    * \brief Finds the transform from the planning frame to a specified command frame.
@@ -162,9 +201,33 @@ private:
   /**
    * \brief Compute the change in joint position required to follow the received command.
    * @param command The incoming servo command.
-   * @return The joint position change required (delta).
+   * @param robot_state The current robot state.
+   * @param servo_params The servo parameters, active_subgroup selects the commanded subgroup.
+   * @param joint_position_deltas The joint position change required (delta).
    */
-  Eigen::VectorXd jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state);
+  void jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state,
+                             const servo::Params& servo_params, Eigen::VectorXd& joint_position_deltas);
+
+  /**
+   * \brief Marks the joints of a subgroup as commanded in commanded_joints_.
+   * @param subgroup The name of the subgroup, or of the move group itself.
+   * @return False if one of its joints was already commanded by another subgroup.
+   */
+  bool claimSubgroupJoints(const std::string& subgroup);
+
+  /**
+   * \brief Computes the target state from joint_position_delta_, applying collision and joint limit scaling,
+   * smoothing and halting. The caller must hold robot_state_mutex_ and have updated current_state_.
+   * @param target_state The required joint state.
+   */
+  void applyJointPositionDelta(KinematicState& target_state);
+
+  /**
+   * \brief Copy the latest state from the state monitor into robot_state_ and the kinematic state of the move group.
+   * The caller must hold robot_state_mutex_.
+   * @param current_state The kinematic state to be updated.
+   */
+  void updateCurrentState(KinematicState& current_state) const;
 
   /**
    * \brief Updates data depending on joint model group
@@ -192,11 +255,10 @@ private:
    * \brief Apply halting logic to specified joints.
    * @param joints_to_halt The indices of joints to be halted.
    * @param current_state The current kinematic state.
-   * @param target_state The target kinematic state.
-   * @return The bounded kinematic state.
+   * @param target_state The target kinematic state, bounded in place.
    */
-  KinematicState haltJoints(const std::vector<int>& joints_to_halt, const KinematicState& current_state,
-                            const KinematicState& target_state) const;
+  void haltJoints(const std::vector<int>& joints_to_halt, const KinematicState& current_state,
+                  KinematicState& target_state) const;
 
   // Variables
 
@@ -217,6 +279,25 @@ private:
 
   // Map between joint subgroup names and corresponding joint name - move group indices map
   std::unordered_map<std::string, JointNameToMoveGroupIndexMap> joint_name_to_index_maps_;
+
+  // Buffers reused by every servo cycle so that the control loop does not allocate memory.
+  // robot_state_ is filled from the state monitor in place instead of copying a new state each cycle.
+  mutable std::mutex robot_state_mutex_;
+  moveit::core::RobotStatePtr robot_state_;
+  mutable KinematicState current_state_;
+  Eigen::VectorXd joint_position_delta_;
+  std::vector<int> joints_to_halt_;
+  // Guarded by robot_state_mutex_ as well.
+  StageTimings stage_timings_;
+  Eigen::VectorXd cartesian_position_delta_;
+  SingularityDirectionCaches singularity_caches_;
+  PoseTrackingState pose_tracking_state_;
+
+  // Buffers used when servoing several subgroups concurrently. subgroup_params_ is a copy of servo_params_ that is
+  // refreshed when the parameters change, only active_subgroup and ee_frame are set for each subgroup.
+  servo::Params subgroup_params_;
+  Eigen::VectorXd subgroup_joint_position_delta_;
+  std::vector<bool> commanded_joints_;
 };
 
 }  // namespace moveit_servo
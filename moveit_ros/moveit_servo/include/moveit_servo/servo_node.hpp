@@ -42,11 +42,13 @@
 #pragma once
 
 #include <control_msgs/msg/joint_jog.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <moveit_msgs/srv/servo_command_type.hpp>
 #include <moveit_msgs/msg/servo_status.hpp>
 #include <moveit_servo/servo.hpp>
+#include <moveit_servo/utils/spsc_queue.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <std_msgs/msg/float64_multi_array.hpp>
 #include <std_srvs/srv/set_bool.hpp>
@@ -103,6 +105,27 @@ private:
   std::optional<KinematicState> processTwistCommand();
   std::optional<KinematicState> processPoseCommand();
 
+  /**
+   * \brief Computes the next joint state from the latest commands of all concurrently servoed subgroups.
+   */
+  std::optional<KinematicState> processSubgroupCommands();
+
+  /**
+   * \brief Moves the commands received since the last cycle from the queues into the latest command messages.
+   * Only called by the servo loop thread.
+   */
+  void receiveCommands();
+
+  /**
+   * \brief Publishes the jitter statistics of the servo loop cycles recorded since the last call.
+   */
+  void publishLoopStatistics();
+
+  /**
+   * \brief Summarizes the pose tracking reports recorded since the last call.
+   */
+  diagnostic_msgs::msg::DiagnosticStatus poseTrackingStatistics();
+
   // Variables
 
   const rclcpp::Node::SharedPtr node_;
@@ -121,6 +144,8 @@ private:
   rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr multi_array_publisher_;
   rclcpp::Publisher<trajectory_msgs::msg::JointTrajectory>::SharedPtr trajectory_publisher_;
   rclcpp::Publisher<moveit_msgs::msg::ServoStatus>::SharedPtr status_publisher_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr loop_statistics_publisher_;
+  rclcpp::TimerBase::SharedPtr loop_statistics_timer_;
 
   rclcpp::Service<moveit_msgs::srv::ServoCommandType>::SharedPtr switch_command_type_;
   rclcpp::Service<std_srvs::srv::SetBool>::SharedPtr pause_servo_;
@@ -130,6 +155,38 @@ private:
   std::atomic<bool> servo_paused_;
   std::atomic<bool> new_joint_jog_msg_, new_twist_msg_, new_pose_msg_;
 
+  // Incoming commands are passed from the subscription callbacks to the servo loop without locking.
+  static constexpr std::size_t COMMAND_QUEUE_SIZE = 8;
+  SpscQueue<control_msgs::msg::JointJog, COMMAND_QUEUE_SIZE> joint_jog_queue_;
+  SpscQueue<geometry_msgs::msg::TwistStamped, COMMAND_QUEUE_SIZE> twist_queue_;
+  SpscQueue<geometry_msgs::msg::PoseStamped, COMMAND_QUEUE_SIZE> pose_queue_;
+
+  // The deviation of each servo loop period from the publish period [s], consumed by publishLoopStatistics().
+  static constexpr std::size_t LOOP_JITTER_QUEUE_SIZE = 1024;
+  SpscQueue<double, LOOP_JITTER_QUEUE_SIZE> loop_jitter_queue_;
+  std::vector<double> loop_jitter_samples_;
+
+  // The outcome of the iterative IK solve of each pose command, consumed by publishLoopStatistics().
+  SpscQueue<PoseTrackingReport, LOOP_JITTER_QUEUE_SIZE> pose_tracking_queue_;
+
+  // The command topics and latest commands of a subgroup that is servoed concurrently with other subgroups.
+  struct SubgroupChannel
+  {
+    std::string subgroup;
+    SpscQueue<control_msgs::msg::JointJog, COMMAND_QUEUE_SIZE> joint_jog_queue;
+    SpscQueue<geometry_msgs::msg::TwistStamped, COMMAND_QUEUE_SIZE> twist_queue;
+    SpscQueue<geometry_msgs::msg::PoseStamped, COMMAND_QUEUE_SIZE> pose_queue;
+    control_msgs::msg::JointJog latest_joint_jog;
+    geometry_msgs::msg::TwistStamped latest_twist;
+    geometry_msgs::msg::PoseStamped latest_pose;
+    rclcpp::Subscription<control_msgs::msg::JointJog>::SharedPtr joint_jog_subscriber;
+    rclcpp::Subscription<geometry_msgs::msg::TwistStamped>::SharedPtr twist_subscriber;
+    rclcpp::Subscription<geometry_msgs::msg::PoseStamped>::SharedPtr pose_subscriber;
+  };
+  std::vector<std::unique_ptr<SubgroupChannel>> subgroup_channels_;
+  std::vector<SubgroupCommand> subgroup_commands_;
+  bool subgroups_halting_;
+
   // Threads used by ServoNode
   std::thread servo_loop_thread_;
 };
@@ -62,6 +62,21 @@ JointDeltaResult jointDeltaFromJointJog(const JointJogCommand& command, const mo
                                         const servo::Params& servo_params,
                                         const JointNameToMoveGroupIndexMap& joint_name_group_index_map);
 
+/**
+ * \brief Compute the change in joint position for the given joint jog command, writing it into an existing vector.
+ * This does not allocate memory once \e joint_position_delta has the size of the move group.
+ * @param command The joint jog command.
+ * @param robot_state_ The current robot state as obtained from PlanningSceneMonitor.
+ * @param servo_params The servo parameters.
+ * @param joint_name_group_index_map Mapping between joint subgroup name and move group joint vector position.
+ * @param joint_position_delta The joint position change required (delta) for all joints of the move group.
+ * @return The status of the computation.
+ */
+StatusCode jointDeltaFromJointJog(const JointJogCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                  const servo::Params& servo_params,
+                                  const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                  Eigen::VectorXd& joint_position_delta);
+
 /**
  * \brief Compute the change in joint position for the given twist command.
  * @param command The twist command.
@@ -74,6 +89,35 @@ JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::
                                      const servo::Params& servo_params,
                                      const JointNameToMoveGroupIndexMap& joint_name_group_index_map);
 
+/**
+ * \brief Compute the change in joint position for the given twist command, without slowing down near singularities.
+ * @param command The twist command.
+ * @param robot_state_ The current robot state as obtained from PlanningSceneMonitor.
+ * @param servo_params The servo parameters.
+ * @param joint_name_group_index_map Mapping between joint subgroup name and move group joint vector position.
+ * @param cartesian_position_delta The Cartesian position change commanded for one servo period, left empty when the
+ * command is zero or invalid.
+ * @return The status and joint position change required (delta).
+ */
+JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                     const servo::Params& servo_params,
+                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                     Eigen::VectorXd& cartesian_position_delta);
+
+/**
+ * \brief Slow down a joint position change near singularities, reusing the singularity analysis of previous calls.
+ * @param cartesian_position_delta The Cartesian position change the joint position change was computed for.
+ * @param robot_state_ The current robot state as obtained from PlanningSceneMonitor.
+ * @param servo_params The servo parameters.
+ * @param singularity_caches The directions towards singularity found in previous calls by group, the one of the
+ * commanded group is updated by this call.
+ * @param joint_position_delta The joint position change, scaled in place.
+ * @return The reason for scaling, NO_WARNING if the joint position change was not scaled.
+ */
+StatusCode scaleForSingularity(const Eigen::VectorXd& cartesian_position_delta,
+                               const moveit::core::RobotStatePtr& robot_state, const servo::Params& servo_params,
+                               SingularityDirectionCaches& singularity_caches, Eigen::VectorXd& joint_position_delta);
+
 /**
  * \brief Compute the change in joint position for the given pose command.
  * @param command The pose command.
@@ -86,6 +130,22 @@ JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::co
                                     const servo::Params& servo_params,
                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map);
 
+/**
+ * \brief Compute the change in joint position for the given pose command with a bounded number of damped least
+ * squares iterations. The iterations start from the solution of the previous call and stop when the pose is reached
+ * within the tolerances, after 'pose_tracking.max_iterations' or once 'pose_tracking.time_budget' is used up.
+ * @param command The pose command.
+ * @param robot_state_ The current robot state as obtained from PlanningSceneMonitor, it is restored before returning.
+ * @param servo_params The servo parameters.
+ * @param joint_name_group_index_map Mapping between sub group joint name and move group joint vector position
+ * @param tracking_state The solution of the previous call, updated along with the report of this call.
+ * @return The status and joint position change required (delta).
+ */
+JointDeltaResult jointDeltaFromPoseTracking(const PoseCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                            const servo::Params& servo_params,
+                                            const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                            PoseTrackingState& tracking_state);
+
 /**
  * \brief Computes the required change in joint angles for given Cartesian change, using the robot's IK solver.
  * @param cartesian_position_delta The change in Cartesian position.
@@ -122,6 +122,25 @@ std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::
                                                                   const Eigen::VectorXd& target_delta_x,
                                                                   const servo::Params& servo_params);
 
+/**
+ * \brief Computes scaling factor for velocity when the robot is near a singularity, reusing the direction towards
+ * singularity found in previous calls.
+ * Whether the robot moves towards or away from the singularity is decided by the sign of the least singular vector of
+ * the Jacobian, which is only defined up to its sign. Instead of resolving it with a perturbation step every call, the
+ * sign is carried over from the previous call when the singular vector has barely rotated, which is the case as long
+ * as the smallest singular value is separated from the others. It is resolved again when the joints moved by more
+ * than 'singularity_direction_reuse_distance' since the last resolution, or when the vectors are not aligned.
+ * @param robot_state The current state of the robot, used for singularity look ahead.
+ * @param target_delta_x The vector containing the required change in Cartesian position.
+ * @param servo_params The servo parameters, contains the singularity thresholds.
+ * @param cache The direction found in the previous call, updated by this call.
+ * @return The velocity scaling factor and the reason for scaling.
+ */
+std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::core::RobotStatePtr& robot_state,
+                                                                  const Eigen::VectorXd& target_delta_x,
+                                                                  const servo::Params& servo_params,
+                                                                  SingularityDirectionCache& cache);
+
 /**
  * \brief Apply velocity scaling based on joint limits.
  * @param velocities The commanded velocities.
@@ -129,9 +148,29 @@ std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::
  * @param scaling_override The user defined velocity scaling override.
  * @return The velocity scaling factor.
  */
-double jointLimitVelocityScalingFactor(const Eigen::VectorXd& velocities,
+double jointLimitVelocityScalingFactor(const Eigen::Ref<const Eigen::VectorXd>& velocities,
                                        const moveit::core::JointBoundsVector& joint_bounds, double scaling_override);
 
+/**
+ * \brief Predict how much of a look-ahead horizon is free of collisions when moving with constant joint velocities.
+ * The horizon is sampled at \e steps equally spaced times, the predicted joint positions are clamped to the joint
+ * bounds.
+ * @param predicted_state The state used for the predicted positions, its other variables are left untouched.
+ * @param joint_model_group The joint group that is moving.
+ * @param start_positions The current joint positions of the group.
+ * @param velocities The commanded joint velocities of the group.
+ * @param horizon The look-ahead time [s].
+ * @param steps The number of predicted states.
+ * @param is_colliding Checks a predicted state for collisions, the collision body transforms are up to date.
+ * @return The fraction of the horizon up to the last collision free sample before the first colliding one,
+ * 1.0 if no sample collides and 0.0 if the first one does.
+ */
+double collisionFreeHorizonFraction(moveit::core::RobotState& predicted_state,
+                                    const moveit::core::JointModelGroup* joint_model_group,
+                                    const Eigen::VectorXd& start_positions, const Eigen::VectorXd& velocities,
+                                    double horizon, int steps,
+                                    const std::function<bool(const moveit::core::RobotState&)>& is_colliding);
+
 /**
  * \brief Finds the joints that are exceeding allowable position limits.
  * @param positions The joint positions.
@@ -140,9 +179,23 @@ double jointLimitVelocityScalingFactor(const Eigen::VectorXd& velocities,
  * @param margin Additional buffer on the actual joint limits.
  * @return The joints that are violating the specified position limits.
  */
-std::vector<int> jointsToHalt(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+std::vector<int> jointsToHalt(const Eigen::Ref<const Eigen::VectorXd>& positions,
+                              const Eigen::Ref<const Eigen::VectorXd>& velocities,
                               const moveit::core::JointBoundsVector& joint_bounds, double margin);
 
+/**
+ * \brief Finds the joints that are exceeding allowable position limits, reusing the storage of the output.
+ * @param positions The joint positions.
+ * @param velocities The current commanded velocities.
+ * @param joint_bounds The allowable limits for the robot joints.
+ * @param margin Additional buffer on the actual joint limits.
+ * @param joint_idxs_to_halt The joints that are violating the specified position limits.
+ */
+void jointsToHalt(const Eigen::Ref<const Eigen::VectorXd>& positions,
+                  const Eigen::Ref<const Eigen::VectorXd>& velocities,
+                  const moveit::core::JointBoundsVector& joint_bounds, double margin,
+                  std::vector<int>& joint_idxs_to_halt);
+
 /**
  * \brief Helper function for converting Eigen::Isometry3d to geometry_msgs/TransformStamped.
  * @param eigen_tf The isometry to be converted to TransformStamped.
@@ -41,6 +41,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <string>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <unordered_map>
@@ -70,6 +72,49 @@ const std::unordered_map<StatusCode, std::string> SERVO_STATUS_CODE_MAP(
       { StatusCode::HALT_FOR_COLLISION, "Collision detected, emergency stop" },
       { StatusCode::JOINT_BOUND, "Close to a joint bound (position or velocity), halting" } });
 
+// The stages of a servo cycle for which the computation time is measured.
+enum class ServoStage : std::size_t
+{
+  STATE_UPDATE = 0,
+  FRAME_CONVERSION = 1,
+  JOINT_DELTA = 2,
+  SINGULARITY_SCALING = 3,
+  COLLISION_SCALING = 4,
+  SMOOTHING = 5,
+  LIMIT_ENFORCEMENT = 6
+};
+
+constexpr std::size_t NUM_SERVO_STAGES = 7;
+
+const std::unordered_map<ServoStage, std::string> SERVO_STAGE_NAME_MAP(
+    { { ServoStage::STATE_UPDATE, "State update" },
+      { ServoStage::FRAME_CONVERSION, "Command frame conversion" },
+      { ServoStage::JOINT_DELTA, "Joint delta (IK/Jacobian)" },
+      { ServoStage::SINGULARITY_SCALING, "Singularity scaling" },
+      { ServoStage::COLLISION_SCALING, "Collision scaling" },
+      { ServoStage::SMOOTHING, "Smoothing" },
+      { ServoStage::LIMIT_ENFORCEMENT, "Joint limit enforcement" } });
+
+// The computation time spent in one stage of the servo cycle, durations are in seconds.
+struct StageTiming
+{
+  std::size_t count = 0;
+  double last = 0.0;
+  double total = 0.0;
+  double max = 0.0;
+
+  void add(const double duration)
+  {
+    ++count;
+    last = duration;
+    total += duration;
+    max = std::max(max, duration);
+  }
+};
+
+// The timings of all stages, indexed by ServoStage.
+typedef std::array<StageTiming, NUM_SERVO_STAGES> StageTimings;
+
 // The datatype that specifies the type of command that servo should expect.
 enum class CommandType : int8_t
 {
@@ -110,6 +155,50 @@ struct PoseCommand
 // The generic input type for servo that can be JointJog, Twist or Pose.
 typedef std::variant<JointJogCommand, TwistCommand, PoseCommand> ServoInput;
 
+// A command for one subgroup of the move group, used for servoing several subgroups concurrently.
+// ee_frame is the frame moved by twist and pose commands, if empty the tip frame of the subgroup is used.
+struct SubgroupCommand
+{
+  std::string subgroup;
+  ServoInput command;
+  std::string ee_frame;
+};
+
+// The direction towards singularity found in a previous servo cycle. It is reused as long as the robot stays close
+// to the joint positions at which it was last resolved, which saves evaluating the Jacobian at a perturbed state.
+struct SingularityDirectionCache
+{
+  std::string group_name;
+  // The joint positions at which the direction was last resolved by a perturbation step.
+  Eigen::VectorXd resolved_joint_positions;
+  // The unit vector in Cartesian space along which the condition number of the Jacobian increases.
+  Eigen::VectorXd vector_towards_singularity;
+};
+
+// The singularity direction caches by group name, so that servoing several subgroups in turn keeps one cache per
+// subgroup instead of overwriting a single cache every cycle.
+using SingularityDirectionCaches = std::unordered_map<std::string, SingularityDirectionCache>;
+
+// The outcome of the iterative IK solve of a pose command in one servo cycle.
+struct PoseTrackingReport
+{
+  bool converged = false;
+  bool warm_started = false;
+  int iterations = 0;
+  double linear_error = 0.0;   // [m]
+  double angular_error = 0.0;  // [rad]
+  double latency = 0.0;        // [s]
+};
+
+// The iterative IK solver state carried over between servo cycles.
+struct PoseTrackingState
+{
+  std::string group_name;
+  // The joint positions found in the previous cycle, the starting point of the next solve.
+  Eigen::VectorXd solution;
+  PoseTrackingReport report;
+};
+
 // The output datatype of servo, this structure contains the names of the joints along with their positions, velocities and accelerations.
 struct KinematicState
 {
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, PickNik Robotics, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+/*
+ * Title      : spsc_queue.hpp
+ * Project    : moveit_servo
+ * Created    : 10/17/2026
+ *
+ * Description: A bounded lock-free queue for passing data between exactly one producer and one consumer thread.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace moveit_servo
+{
+
+/**
+ * \brief A bounded single-producer/single-consumer queue that does not lock or allocate memory.
+ * push() must only be called from one thread and pop() from one other thread.
+ * Elements are stored in preallocated slots. Values are copied into the slots and swapped out of them, so that
+ * elements owning memory (e.g. ROS messages) are neither allocated nor freed by the consumer.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+public:
+  /**
+   * \brief Add a copy of \e value to the queue. Must only be called by the producer.
+   * @param value The value to be added.
+   * @return False if the queue is full, in which case the value is dropped.
+   */
+  bool push(const T& value)
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t next = increment(tail);
+    if (next == head_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    slots_[tail] = value;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Take the oldest value from the queue. Must only be called by the consumer.
+   * @param value Receives the value, its previous content is left in the freed slot.
+   * @return False if the queue is empty, in which case \e value is unchanged.
+   */
+  bool pop(T& value)
+  {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    using std::swap;
+    swap(value, slots_[head]);
+    head_.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Take the newest value and discard all older ones. Must only be called by the consumer.
+   * @param value Receives the newest value.
+   * @return False if the queue is empty, in which case \e value is unchanged.
+   */
+  bool popLatest(T& value)
+  {
+    bool popped = false;
+    while (pop(value))
+    {
+      popped = true;
+    }
+    return popped;
+  }
+
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t increment(std::size_t index)
+  {
+    return (index + 1) % (Capacity + 1);
+  }
+
+  // One slot is always left free to tell a full queue from an empty one.
+  std::array<T, Capacity + 1> slots_;
+  // The producer and consumer indices are kept on separate cache lines to avoid false sharing.
+  alignas(64) std::atomic<std::size_t> head_{ 0 };
+  alignas(64) std::atomic<std::size_t> tail_{ 0 };
+};
+
+}  // namespace moveit_servo
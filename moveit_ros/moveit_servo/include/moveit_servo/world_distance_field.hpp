@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, PickNik Robotics, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+/*
+ * Title      : world_distance_field.hpp
+ * Project    : moveit_servo
+ * Created    : 10/17/2026
+ *
+ * Description: Distance field of the planning scene world used for cheap proximity queries.
+ */
+
+#pragma once
+
+#include <moveit/collision_detection/collision_matrix.h>
+#include <moveit/collision_detection/world.h>
+#include <moveit/collision_distance_field/collision_distance_field_types.h>
+#include <moveit/distance_field/propagation_distance_field.h>
+#include <moveit/robot_state/robot_state.h>
+#include <map>
+#include <memory>
+#include <set>
+
+namespace moveit_servo
+{
+
+class WorldDistanceField
+{
+public:
+  /**
+   * \brief Create an empty distance field and decompose the robot links into spheres.
+   * @param robot_model The robot model whose links are queried against the field.
+   * @param size The size of the field in the model frame [m].
+   * @param origin The minimum corner of the field in the model frame [m].
+   * @param resolution The voxel size of the field and the resolution of the link sphere decomposition [m].
+   * @param max_distance The distance up to which distances are propagated [m].
+   */
+  WorldDistanceField(const moveit::core::RobotModelConstPtr& robot_model, const Eigen::Vector3d& size,
+                     const Eigen::Vector3d& origin, double resolution, double max_distance);
+
+  /**
+   * \brief Bring the field up to date with the objects in the world.
+   * Only objects that were added, changed or removed since the last update are added to or removed from the field.
+   * The world copies objects on write, so a changed object is detected by comparing object pointers.
+   * @param world The world of the planning scene.
+   * @return The number of objects that were added, changed or removed.
+   */
+  std::size_t update(const collision_detection::World& world);
+
+  /**
+   * \brief Bring the field up to date with the objects in the world, skipping the collisions allowed by \e acm.
+   * Objects that the same robot links and attached bodies are allowed to collide with share a distance field, which
+   * these links and bodies do not query. Objects that every link and attached body may collide with are left out.
+   * An object whose allowed collisions changed is moved to another field.
+   * @param world The world of the planning scene.
+   * @param acm The allowed collision matrix of the planning scene.
+   * @param state The robot state, which provides the attached bodies.
+   * @return The number of objects that were added, changed or removed.
+   */
+  std::size_t update(const collision_detection::World& world, const collision_detection::AllowedCollisionMatrix& acm,
+                     const moveit::core::RobotState& state);
+
+  /**
+   * \brief Compute the distance between the robot and the world, including the bodies attached to the robot.
+   * The link transforms of the state must be up to date. Attached bodies are decomposed into spheres the first time
+   * they are seen, and again when their shapes change.
+   * @param state The robot state.
+   * @param link_padding The padding of the robot links [m], as set in the collision environment. Attached bodies are
+   * padded like the link they are attached to.
+   * @return The smallest distance between a padded link or attached body sphere and an obstacle it may not collide
+   * with, negative if a sphere penetrates such an obstacle, at most the maximum propagation distance.
+   */
+  double distance(const moveit::core::RobotState& state, const std::map<std::string, double>& link_padding = {});
+
+  /**
+   * \brief Remove all objects from the field.
+   */
+  void clear();
+
+private:
+  struct Field
+  {
+    // The robot links and attached bodies that are allowed to collide with the objects in this field.
+    std::set<std::string> allowed;
+    std::unique_ptr<distance_field::PropagationDistanceField> distance_field;
+    // The objects contained in the field, as they were when they were added.
+    std::map<std::string, collision_detection::World::ObjectConstPtr> objects;
+  };
+
+  std::size_t updateObjects(const collision_detection::World& world,
+                            const std::map<std::string, std::set<std::string>>& allowed, std::size_t body_count);
+
+  std::unique_ptr<Field> makeField(std::set<std::string> allowed) const;
+
+  void addObject(Field& field, const collision_detection::World::Object& object);
+
+  /**
+   * \brief Remove objects that are no longer in the objects of \e field from its distance field.
+   * Voxels that are also occupied by one of the remaining objects are kept.
+   */
+  void removeObjects(Field& field, const std::vector<collision_detection::World::ObjectConstPtr>& objects);
+
+  /**
+   * \brief Get the smallest distance between the posed spheres of the robot body \e name, grown by \e padding, and an
+   * obstacle the body may collide with, or \e min_distance if it is smaller.
+   */
+  double distance(const std::string& name, const collision_detection::PosedBodySphereDecomposition& spheres,
+                  double padding, double min_distance) const;
+
+  Eigen::Vector3d size_;
+  Eigen::Vector3d origin_;
+  double max_distance_;
+  // fields_[0] contains the objects that no robot body is allowed to collide with, and is always present.
+  std::vector<std::unique_ptr<Field>> fields_;
+
+  struct LinkSpheres
+  {
+    const moveit::core::LinkModel* link;
+    collision_detection::PosedBodySphereDecompositionPtr spheres;
+  };
+  std::vector<LinkSpheres> link_spheres_;
+
+  struct AttachedBodySpheres
+  {
+    std::vector<shapes::ShapeConstPtr> shapes;
+    EigenSTL::vector_Isometry3d shape_poses;  // in the frame of the link the body is attached to
+    collision_detection::PosedBodySphereDecompositionPtr spheres;
+  };
+  // The sphere decompositions of the attached bodies seen in the last query, by body name.
+  std::map<std::string, AttachedBodySpheres> attached_body_spheres_;
+  double resolution_;
+};
+
+}  // namespace moveit_servo
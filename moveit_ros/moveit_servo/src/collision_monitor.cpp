@@ -38,6 +38,7 @@
  */
 
 #include <moveit_servo/collision_monitor.hpp>
+#include <moveit_servo/utils/common.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 namespace
@@ -109,8 +110,15 @@ void CollisionMonitor::checkCollisions()
 
       // Check collision with environment.
       scene_collision_result_.clear();
-      locked_scene->getCollisionEnv()->checkRobotCollision(scene_collision_request_, scene_collision_result_,
-                                                           *robot_state_);
+      if (servo_params_.collision_distance_field.enabled)
+      {
+        checkDistanceFieldCollision(*locked_scene);
+      }
+      else
+      {
+        locked_scene->getCollisionEnv()->checkRobotCollision(scene_collision_request_, scene_collision_result_,
+                                                             *robot_state_, locked_scene->getAllowedCollisionMatrix());
+      }
 
       // Check robot self collision.
       self_collision_result_.clear();
@@ -152,8 +160,93 @@ void CollisionMonitor::checkCollisions()
         // Use the scaling factor with lower value, i.e maximum scale down.
         collision_velocity_scale_ = std::min(scene_collision_scale, self_collision_scale);
       }
+
+      // Brake based on the time until the commanded motion is predicted to collide.
+      if (servo_params_.collision_look_ahead.enabled && collision_velocity_scale_ > 0.0)
+      {
+        collision_velocity_scale_ = std::min(collision_velocity_scale_.load(), lookAheadVelocityScale(*locked_scene));
+      }
     }
     rate.sleep();
   }
 }
+
+void CollisionMonitor::setCommandedJointDelta(const Eigen::VectorXd& joint_position_delta, double period)
+{
+  std::scoped_lock lock(commanded_velocities_mutex_);
+  commanded_velocities_ = joint_position_delta / period;
+}
+
+double CollisionMonitor::lookAheadVelocityScale(const planning_scene::PlanningScene& scene)
+{
+  Eigen::VectorXd velocities;
+  {
+    std::scoped_lock lock(commanded_velocities_mutex_);
+    velocities = commanded_velocities_;
+  }
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state_->getJointModelGroup(servo_params_.move_group_name);
+  if (velocities.size() != static_cast<Eigen::Index>(joint_model_group->getVariableCount()) || velocities.isZero())
+  {
+    return 1.0;
+  }
+
+  Eigen::VectorXd start_positions;
+  robot_state_->copyJointGroupPositions(joint_model_group, start_positions);
+  if (!predicted_state_)
+  {
+    predicted_state_ = std::make_shared<moveit::core::RobotState>(*robot_state_);
+  }
+  else
+  {
+    *predicted_state_ = *robot_state_;
+  }
+
+  const auto is_colliding = [&](const moveit::core::RobotState& state) {
+    look_ahead_result_.clear();
+    if (servo_params_.collision_distance_field.enabled && world_distance_field_)
+    {
+      look_ahead_result_.collision =
+          world_distance_field_->distance(state, scene.getCollisionEnv()->getLinkPadding()) <= 0.0;
+    }
+    else
+    {
+      scene.getCollisionEnv()->checkRobotCollision(look_ahead_request_, look_ahead_result_, state,
+                                                   scene.getAllowedCollisionMatrix());
+    }
+    if (!look_ahead_result_.collision)
+    {
+      scene.getCollisionEnvUnpadded()->checkSelfCollision(look_ahead_request_, look_ahead_result_, state,
+                                                          scene.getAllowedCollisionMatrix());
+    }
+    return look_ahead_result_.collision;
+  };
+
+  return collisionFreeHorizonFraction(*predicted_state_, joint_model_group, start_positions, velocities,
+                                      servo_params_.collision_look_ahead.horizon,
+                                      servo_params_.collision_look_ahead.steps, is_colliding);
+}
+
+void CollisionMonitor::checkDistanceFieldCollision(const planning_scene::PlanningScene& scene)
+{
+  if (!world_distance_field_)
+  {
+    const auto& params = servo_params_.collision_distance_field;
+    world_distance_field_ = std::make_unique<WorldDistanceField>(
+        planning_scene_monitor_->getRobotModel(), Eigen::Vector3d(params.size[0], params.size[1], params.size[2]),
+        Eigen::Vector3d(params.origin[0], params.origin[1], params.origin[2]), params.resolution, params.max_distance);
+  }
+
+  const std::size_t changes =
+      world_distance_field_->update(*scene.getWorld(), scene.getAllowedCollisionMatrix(), *robot_state_);
+  if (changes > 0)
+  {
+    RCLCPP_DEBUG_STREAM(LOGGER, "Updated " << changes << " objects in the collision distance field");
+  }
+
+  // Pad the links like the collision environment used without the distance field.
+  scene_collision_result_.distance =
+      world_distance_field_->distance(*robot_state_, scene.getCollisionEnv()->getLinkPadding());
+  scene_collision_result_.collision = scene_collision_result_.distance <= 0.0;
+}
 }  // namespace moveit_servo
@@ -41,6 +41,7 @@
 #include <moveit_servo/utils/command.hpp>
 #include <moveit_servo/utils/common.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <chrono>
 
 // Disable -Wold-style-cast because all _THROTTLE macros trigger this
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -50,6 +51,26 @@ namespace
 const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_servo.servo");
 constexpr double ROBOT_STATE_WAIT_TIME = 5.0;  // seconds
 constexpr double STOPPED_VELOCITY_EPS = 1e-4;
+constexpr int JOINT_LIMIT_WARNING_PERIOD = 1000;  // milliseconds
+
+// Adds the time from construction to destruction to the timing of a servo stage.
+class ScopedStageTimer
+{
+public:
+  ScopedStageTimer(moveit_servo::StageTimings& timings, moveit_servo::ServoStage stage)
+    : timing_{ timings[static_cast<std::size_t>(stage)] }, start_{ std::chrono::steady_clock::now() }
+  {
+  }
+
+  ~ScopedStageTimer()
+  {
+    timing_.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+  }
+
+private:
+  moveit_servo::StageTiming& timing_;
+  const std::chrono::steady_clock::time_point start_;
+};
 }  // namespace
 
 namespace moveit_servo
@@ -86,14 +107,15 @@ Servo::Servo(const rclcpp::Node::SharedPtr& node, std::shared_ptr<const servo::P
     planning_scene_monitor_->requestPlanningSceneState();
   }
 
-  moveit::core::RobotStatePtr robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
+  // The robot state is allocated once here and updated in place by every servo cycle.
+  robot_state_ = planning_scene_monitor_->getStateMonitor()->getCurrentState();
   // Check if the transforms to planning frame and end effector frame exist.
-  if (!robot_state->knowsFrameTransform(servo_params_.planning_frame))
+  if (!robot_state_->knowsFrameTransform(servo_params_.planning_frame))
   {
     servo_status_ = StatusCode::INVALID;
     RCLCPP_ERROR_STREAM(LOGGER, "No transform available for planning frame " << servo_params_.planning_frame);
   }
-  else if (!robot_state->knowsFrameTransform(servo_params_.ee_frame))
+  else if (!robot_state_->knowsFrameTransform(servo_params_.ee_frame))
   {
     servo_status_ = StatusCode::INVALID;
     RCLCPP_ERROR_STREAM(LOGGER, "No transform available for end effector frame " << servo_params_.ee_frame);
@@ -121,6 +143,15 @@ Servo::Servo(const rclcpp::Node::SharedPtr& node, std::shared_ptr<const servo::P
   const auto& move_group_joint_names = planning_scene_monitor_->getRobotModel()
                                            ->getJointModelGroup(servo_params_.move_group_name)
                                            ->getActiveJointModelNames();
+
+  // Size the per-cycle buffers for the move group.
+  const int num_joints = move_group_joint_names.size();
+  current_state_ = KinematicState(num_joints);
+  joint_position_delta_ = Eigen::VectorXd::Zero(num_joints);
+  joints_to_halt_.reserve(num_joints);
+  subgroup_params_ = servo_params_;
+  commanded_joints_.assign(num_joints, false);
+
   // Create subgroup map
   for (const auto& sub_group_name : planning_scene_monitor_->getRobotModel()->getJointModelGroupNames())
   {
@@ -172,9 +203,10 @@ void Servo::setSmoothingPlugin()
   }
 
   // Initialize the smoothing plugin
-  moveit::core::RobotStatePtr robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
-  const int num_joints =
-      robot_state->getJointModelGroup(servo_params_.move_group_name)->getActiveJointModelNames().size();
+  const int num_joints = planning_scene_monitor_->getRobotModel()
+                             ->getJointModelGroup(servo_params_.move_group_name)
+                             ->getActiveJointModelNames()
+                             .size();
   if (!smoother_->initialize(node_, planning_scene_monitor_->getRobotModel(), num_joints))
   {
     RCLCPP_ERROR(LOGGER, "Smoothing plugin could not be initialized");
@@ -190,8 +222,7 @@ void Servo::setCollisionChecking(const bool check_collision)
 bool Servo::validateParams(const servo::Params& servo_params) const
 {
   bool params_valid = true;
-  auto robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
-  auto joint_model_group = robot_state->getJointModelGroup(servo_params.move_group_name);
+  auto joint_model_group = planning_scene_monitor_->getRobotModel()->getJointModelGroup(servo_params.move_group_name);
   if (joint_model_group == nullptr)
   {
     RCLCPP_ERROR_STREAM(LOGGER, "Invalid move group name: `" << servo_params.move_group_name << '`');
@@ -242,6 +273,34 @@ bool Servo::validateParams(const servo::Params& servo_params) const
     params_valid = false;
   }
 
+  // Concurrent subgroups add up their joint deltas, so a joint commanded by two of them would move twice as far.
+  std::map<const moveit::core::JointModel*, std::string> subgroup_of_joint;
+  for (const std::string& subgroup : servo_params.concurrent_subgroups)
+  {
+    if (joint_model_group && subgroup != servo_params.move_group_name && !joint_model_group->isSubgroup(subgroup))
+    {
+      RCLCPP_ERROR(LOGGER, "The value '%s' in parameter 'concurrent_subgroups' does not name a valid subgroup of "
+                           "joint group '%s'.",
+                   subgroup.c_str(), servo_params.move_group_name.c_str());
+      params_valid = false;
+      continue;
+    }
+    const moveit::core::JointModelGroup* subgroup_model =
+        planning_scene_monitor_->getRobotModel()->getJointModelGroup(subgroup);
+    for (const moveit::core::JointModel* joint : subgroup_model ? subgroup_model->getActiveJointModels() :
+                                                                  std::vector<const moveit::core::JointModel*>())
+    {
+      const auto [it, inserted] = subgroup_of_joint.emplace(joint, subgroup);
+      if (!inserted)
+      {
+        RCLCPP_ERROR(LOGGER, "The subgroups '%s' and '%s' in parameter 'concurrent_subgroups' share joint '%s'.",
+                     it->second.c_str(), subgroup.c_str(), joint->getName().c_str());
+        params_valid = false;
+        break;
+      }
+    }
+  }
+
   return params_valid;
 }
 
@@ -261,6 +320,7 @@ bool Servo::updateParams()
       }
 
       servo_params_ = params;
+      subgroup_params_ = params;
       params_updated = true;
     }
     else
@@ -298,21 +358,36 @@ void Servo::setCommandType(const CommandType& command_type)
 
 Eigen::Isometry3d Servo::getEndEffectorPose() const
 {
-  return planning_scene_monitor_->getStateMonitor()->getCurrentState()->getGlobalLinkTransform(servo_params_.ee_frame);
+  std::scoped_lock lock(robot_state_mutex_);
+  planning_scene_monitor_->getStateMonitor()->setToCurrentState(*robot_state_);
+  return robot_state_->getGlobalLinkTransform(servo_params_.ee_frame);
 }
 
-KinematicState Servo::haltJoints(const std::vector<int>& joints_to_halt, const KinematicState& current_state,
-                                 const KinematicState& target_state) const
+void Servo::updateCurrentState(KinematicState& current_state) const
 {
-  KinematicState bounded_state(target_state.joint_names.size());
-  bounded_state.joint_names = target_state.joint_names;
+  planning_scene_monitor_->getStateMonitor()->setToCurrentState(*robot_state_);
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state_->getJointModelGroup(servo_params_.move_group_name);
 
-  std::stringstream halting_joint_names;
-  for (const int idx : joints_to_halt)
-  {
-    halting_joint_names << bounded_state.joint_names[idx] + " ";
-  }
-  RCLCPP_WARN_STREAM(LOGGER, "Joint position limit reached on joints: " << halting_joint_names.str());
+  // Assignment and copying reuse the storage of current_state once it has the right size.
+  current_state.joint_names = joint_model_group->getActiveJointModelNames();
+  robot_state_->copyJointGroupPositions(joint_model_group, current_state.positions);
+  robot_state_->copyJointGroupVelocities(joint_model_group, current_state.velocities);
+  robot_state_->copyJointGroupAccelerations(joint_model_group, current_state.accelerations);
+}
+
+void Servo::haltJoints(const std::vector<int>& joints_to_halt, const KinematicState& current_state,
+                       KinematicState& target_state) const
+{
+  // the limit stays reached on every cycle until the command changes, so a single message is logged now and then
+  const auto halted_joint_names = [&] {
+    std::string names;
+    for (const int idx : joints_to_halt)
+      names += target_state.joint_names[idx] + " ";
+    return names;
+  };
+  RCLCPP_WARN_STREAM_THROTTLE(LOGGER, *node_->get_clock(), JOINT_LIMIT_WARNING_PERIOD,
+                              "Joint position limit reached on joints: " << halted_joint_names());
 
   const bool all_joint_halt =
       (getCommandType() == CommandType::JOINT_JOG && servo_params_.halt_all_joints_in_joint_mode) ||
@@ -320,35 +395,33 @@ KinematicState Servo::haltJoints(const std::vector<int>& joints_to_halt, const K
 
   if (all_joint_halt)
   {
-    // The velocities are initialized to zero by default, so we dont need to set it here.
-    bounded_state.positions = current_state.positions;
+    target_state.positions = current_state.positions;
+    std::fill(target_state.velocities.begin(), target_state.velocities.end(), 0.0);
   }
   else
   {
     // Halt only the joints that are out of bounds
-    bounded_state.positions = target_state.positions;
-    bounded_state.velocities = target_state.velocities;
     for (const int idx : joints_to_halt)
     {
-      bounded_state.positions[idx] = current_state.positions[idx];
-      bounded_state.velocities[idx] = 0.0;
+      target_state.positions[idx] = current_state.positions[idx];
+      target_state.velocities[idx] = 0.0;
     }
   }
-
-  return bounded_state;
 }
 
-Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state)
+void Servo::jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state,
+                                  const servo::Params& servo_params, Eigen::VectorXd& joint_position_deltas)
 {
   // Determine joint_name_group_index_map, if no subgroup is active, the map is empty
+  static const JointNameToMoveGroupIndexMap EMPTY_INDEX_MAP;
   const auto& joint_name_group_index_map =
-      (!servo_params_.active_subgroup.empty() && servo_params_.active_subgroup != servo_params_.move_group_name) ?
-          joint_name_to_index_maps_.at(servo_params_.active_subgroup) :
-          JointNameToMoveGroupIndexMap();
+      (!servo_params.active_subgroup.empty() && servo_params.active_subgroup != servo_params.move_group_name) ?
+          joint_name_to_index_maps_.at(servo_params.active_subgroup) :
+          EMPTY_INDEX_MAP;
 
   const int num_joints =
-      robot_state->getJointModelGroup(servo_params_.move_group_name)->getActiveJointModelNames().size();
-  Eigen::VectorXd joint_position_deltas(num_joints);
+      robot_state->getJointModelGroup(servo_params.move_group_name)->getActiveJointModelNames().size();
+  joint_position_deltas.resize(num_joints);
   joint_position_deltas.setZero();
 
   JointDeltaResult delta_result;
@@ -358,18 +431,40 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
   {
     if (expected_type == CommandType::JOINT_JOG)
     {
-      delta_result = jointDeltaFromJointJog(std::get<JointJogCommand>(command), robot_state, servo_params_,
-                                            joint_name_group_index_map);
-      servo_status_ = delta_result.first;
+      // Joint jog commands are written directly into the output so that this path does not allocate.
+      ScopedStageTimer timer(stage_timings_, ServoStage::JOINT_DELTA);
+      servo_status_ = jointDeltaFromJointJog(std::get<JointJogCommand>(command), robot_state, servo_params,
+                                             joint_name_group_index_map, joint_position_deltas);
+      if (servo_status_ == StatusCode::INVALID)
+      {
+        joint_position_deltas.setZero();
+      }
     }
     else if (expected_type == CommandType::TWIST)
     {
       try
       {
-        const TwistCommand command_in_planning_frame = toPlanningFrame(std::get<TwistCommand>(command));
-        delta_result =
-            jointDeltaFromTwist(command_in_planning_frame, robot_state, servo_params_, joint_name_group_index_map);
-        servo_status_ = delta_result.first;
+        TwistCommand command_in_planning_frame;
+        {
+          ScopedStageTimer timer(stage_timings_, ServoStage::FRAME_CONVERSION);
+          command_in_planning_frame = toPlanningFrame(std::get<TwistCommand>(command));
+        }
+        {
+          ScopedStageTimer timer(stage_timings_, ServoStage::JOINT_DELTA);
+          delta_result = jointDeltaFromTwist(command_in_planning_frame, robot_state, servo_params,
+                                             joint_name_group_index_map, cartesian_position_delta_);
+          servo_status_ = delta_result.first;
+        }
+        if (servo_status_ != StatusCode::INVALID && cartesian_position_delta_.size() > 0)
+        {
+          ScopedStageTimer timer(stage_timings_, ServoStage::SINGULARITY_SCALING);
+          const StatusCode singularity_status = scaleForSingularity(
+              cartesian_position_delta_, robot_state, servo_params, singularity_caches_, delta_result.second);
+          if (singularity_status != StatusCode::NO_WARNING)
+          {
+            servo_status_ = singularity_status;
+          }
+        }
       }
       catch (tf2::TransformException& ex)
       {
@@ -381,9 +476,29 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
     {
       try
       {
-        const PoseCommand command_in_planning_frame = toPlanningFrame(std::get<PoseCommand>(command));
-        delta_result =
-            jointDeltaFromPose(command_in_planning_frame, robot_state, servo_params_, joint_name_group_index_map);
+        PoseCommand command_in_planning_frame;
+        {
+          ScopedStageTimer timer(stage_timings_, ServoStage::FRAME_CONVERSION);
+          command_in_planning_frame = toPlanningFrame(std::get<PoseCommand>(command));
+        }
+        ScopedStageTimer timer(stage_timings_, ServoStage::JOINT_DELTA);
+        if (servo_params.pose_tracking.use_iterative_ik)
+        {
+          delta_result = jointDeltaFromPoseTracking(command_in_planning_frame, robot_state, servo_params,
+                                                    joint_name_group_index_map, pose_tracking_state_);
+          if (!pose_tracking_state_.report.converged)
+          {
+            RCLCPP_DEBUG_STREAM(LOGGER, "Pose tracking did not converge within "
+                                            << pose_tracking_state_.report.iterations << " iterations, remaining error "
+                                            << pose_tracking_state_.report.linear_error << " m, "
+                                            << pose_tracking_state_.report.angular_error << " rad");
+          }
+        }
+        else
+        {
+          delta_result =
+              jointDeltaFromPose(command_in_planning_frame, robot_state, servo_params, joint_name_group_index_map);
+        }
         servo_status_ = delta_result.first;
       }
       catch (tf2::TransformException& ex)
@@ -393,7 +508,7 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
       }
     }
 
-    if (servo_status_ != StatusCode::INVALID)
+    if (servo_status_ != StatusCode::INVALID && expected_type != CommandType::JOINT_JOG)
     {
       joint_position_deltas = delta_result.second;
     }
@@ -403,11 +518,16 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
     servo_status_ = StatusCode::INVALID;
     RCLCPP_WARN_STREAM(LOGGER, "Incoming servo command type does not match known command types.");
   }
-
-  return joint_position_deltas;
 }
 
 KinematicState Servo::getNextJointState(const ServoInput& command)
+{
+  KinematicState target_state;
+  getNextJointState(command, target_state);
+  return target_state;
+}
+
+void Servo::getNextJointState(const ServoInput& command, KinematicState& target_state)
 {
   // Set status to clear
   servo_status_ = StatusCode::NO_WARNING;
@@ -415,40 +535,165 @@ KinematicState Servo::getNextJointState(const ServoInput& command)
   // Update the parameters
   updateParams();
 
-  // Get the robot state and joint model group info.
-  moveit::core::RobotStatePtr robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
+  std::scoped_lock lock(robot_state_mutex_);
+
+  // Update the robot state and the current kinematic state in place.
+  {
+    ScopedStageTimer timer(stage_timings_, ServoStage::STATE_UPDATE);
+    updateCurrentState(current_state_);
+  }
+
+  // Compute the change in joint position due to the incoming command
+  jointDeltaFromCommand(command, robot_state_, servo_params_, joint_position_delta_);
+
+  applyJointPositionDelta(target_state);
+}
+
+void Servo::getNextJointState(const std::vector<SubgroupCommand>& commands, KinematicState& target_state)
+{
+  // Set status to clear
+  servo_status_ = StatusCode::NO_WARNING;
+
+  // Update the parameters
+  updateParams();
+
+  std::scoped_lock lock(robot_state_mutex_);
+
+  // All subgroups are servoed from the same state.
+  {
+    ScopedStageTimer timer(stage_timings_, ServoStage::STATE_UPDATE);
+    updateCurrentState(current_state_);
+  }
+
+  const moveit::core::JointModelGroup* move_group = robot_state_->getJointModelGroup(servo_params_.move_group_name);
+  joint_position_delta_.setZero(current_state_.positions.size());
+  std::fill(commanded_joints_.begin(), commanded_joints_.end(), false);
+  StatusCode status = StatusCode::NO_WARNING;
+  for (const SubgroupCommand& subgroup_command : commands)
+  {
+    const moveit::core::JointModelGroup* subgroup = robot_state_->getJointModelGroup(subgroup_command.subgroup);
+    if (!subgroup || (subgroup != move_group && !move_group->isSubgroup(subgroup_command.subgroup)))
+    {
+      status = StatusCode::INVALID;
+      RCLCPP_WARN_STREAM(LOGGER, "'" << subgroup_command.subgroup << "' is not a subgroup of the move group.");
+      break;
+    }
+
+    // The joint deltas of the subgroups are added up, so no joint may be commanded twice.
+    if (!claimSubgroupJoints(subgroup_command.subgroup))
+    {
+      status = StatusCode::INVALID;
+      RCLCPP_WARN_STREAM(LOGGER, "Subgroup '" << subgroup_command.subgroup
+                                              << "' shares joints with another commanded subgroup.");
+      break;
+    }
+
+    // Only the parameters that differ between subgroups are set, the others are copied when the parameters change.
+    // Twist and pose commands move the tip of the subgroup unless another frame is given.
+    subgroup_params_.active_subgroup = subgroup_command.subgroup;
+    if (!subgroup_command.ee_frame.empty())
+    {
+      subgroup_params_.ee_frame = subgroup_command.ee_frame;
+    }
+    else if (const auto& solver = subgroup->getSolverInstance())
+    {
+      subgroup_params_.ee_frame = solver->getTipFrame();
+    }
+    else if (!subgroup->getLinkModelNames().empty())
+    {
+      subgroup_params_.ee_frame = subgroup->getLinkModelNames().back();
+    }
+    else
+    {
+      subgroup_params_.ee_frame = servo_params_.ee_frame;
+    }
+
+    jointDeltaFromCommand(subgroup_command.command, robot_state_, subgroup_params_, subgroup_joint_position_delta_);
+    if (servo_status_ == StatusCode::INVALID)
+    {
+      status = StatusCode::INVALID;
+      break;
+    }
+    // Keep warnings, e.g. about singularities, of any subgroup.
+    if (servo_status_ != StatusCode::NO_WARNING)
+    {
+      status = servo_status_;
+    }
+    joint_position_delta_ += subgroup_joint_position_delta_;
+  }
+  servo_status_ = status;
+  if (servo_status_ == StatusCode::INVALID)
+  {
+    joint_position_delta_.setZero();
+  }
+
+  applyJointPositionDelta(target_state);
+}
+
+bool Servo::claimSubgroupJoints(const std::string& subgroup)
+{
+  const auto index_map = joint_name_to_index_maps_.find(subgroup);
+  if (index_map == joint_name_to_index_maps_.end())
+  {
+    // The move group itself claims all joints.
+    const bool any_claimed =
+        std::find(commanded_joints_.begin(), commanded_joints_.end(), true) != commanded_joints_.end();
+    std::fill(commanded_joints_.begin(), commanded_joints_.end(), true);
+    return !any_claimed;
+  }
+  for (const auto& [joint_name, index] : index_map->second)
+  {
+    if (index >= commanded_joints_.size())
+    {
+      continue;
+    }
+    if (commanded_joints_[index])
+    {
+      return false;
+    }
+    commanded_joints_[index] = true;
+  }
+  return true;
+}
+
+void Servo::applyJointPositionDelta(KinematicState& target_state)
+{
+  const KinematicState& current_state = current_state_;
   const moveit::core::JointModelGroup* joint_model_group =
-      robot_state->getJointModelGroup(servo_params_.move_group_name);
+      robot_state_->getJointModelGroup(servo_params_.move_group_name);
 
   // Get necessary information about joints
-  const std::vector<std::string> joint_names = joint_model_group->getActiveJointModelNames();
-  const moveit::core::JointBoundsVector joint_bounds = joint_model_group->getActiveJointModelsBounds();
-  const int num_joints = joint_names.size();
-
-  // State variables
-  KinematicState current_state(num_joints), target_state(num_joints);
-  target_state.joint_names = joint_names;
+  const moveit::core::JointBoundsVector& joint_bounds = joint_model_group->getActiveJointModelsBounds();
+  const int num_joints = current_state.joint_names.size();
 
-  // Copy current kinematic data from RobotState.
-  robot_state->copyJointGroupPositions(joint_model_group, current_state.positions);
-  robot_state->copyJointGroupVelocities(joint_model_group, current_state.velocities);
+  // Reset the target state, this only allocates if its size changed.
+  target_state.joint_names = current_state.joint_names;
+  target_state.positions.assign(num_joints, 0.0);
+  target_state.velocities.assign(num_joints, 0.0);
+  target_state.accelerations.assign(num_joints, 0.0);
 
   // Create Eigen maps for cleaner operations.
-  Eigen::Map<Eigen::VectorXd> current_joint_positions(current_state.positions.data(), num_joints);
+  Eigen::Map<const Eigen::VectorXd> current_joint_positions(current_state.positions.data(), num_joints);
   Eigen::Map<Eigen::VectorXd> target_joint_positions(target_state.positions.data(), num_joints);
-  Eigen::Map<Eigen::VectorXd> current_joint_velocities(current_state.velocities.data(), num_joints);
   Eigen::Map<Eigen::VectorXd> target_joint_velocities(target_state.velocities.data(), num_joints);
 
-  // Compute the change in joint position due to the incoming command
-  Eigen::VectorXd joint_position_delta = jointDeltaFromCommand(command, robot_state);
-
-  if (collision_velocity_scale_ > 0 && collision_velocity_scale_ < 1)
-  {
-    servo_status_ = StatusCode::DECELERATE_FOR_COLLISION;
-  }
-  else if (collision_velocity_scale_ == 0)
   {
-    servo_status_ = StatusCode::HALT_FOR_COLLISION;
+    ScopedStageTimer timer(stage_timings_, ServoStage::COLLISION_SCALING);
+
+    // Let the collision monitor predict collisions along the commanded motion.
+    if (collision_monitor_ && servo_params_.collision_look_ahead.enabled)
+    {
+      collision_monitor_->setCommandedJointDelta(joint_position_delta_, servo_params_.publish_period);
+    }
+
+    if (collision_velocity_scale_ > 0 && collision_velocity_scale_ < 1)
+    {
+      servo_status_ = StatusCode::DECELERATE_FOR_COLLISION;
+    }
+    else if (collision_velocity_scale_ == 0)
+    {
+      servo_status_ = StatusCode::HALT_FOR_COLLISION;
+    }
   }
 
   // Continue rest of the computations only if the command is valid
@@ -456,20 +701,23 @@ KinematicState Servo::getNextJointState(const ServoInput& command)
   if (servo_status_ != StatusCode::INVALID && servo_status_ != StatusCode::HALT_FOR_COLLISION)
   {
     // Apply collision scaling to the joint position delta
-    joint_position_delta *= collision_velocity_scale_;
+    joint_position_delta_ *= collision_velocity_scale_;
 
     // Compute the next joint positions based on the joint position deltas
-    target_joint_positions = current_joint_positions + joint_position_delta;
+    target_joint_positions = current_joint_positions + joint_position_delta_;
 
     // TODO : apply filtering to the velocity instead of position
     // Apply smoothing to the positions if a smoother was provided.
     // Update filter state and apply filtering in position domain
     if (smoother_)
     {
+      ScopedStageTimer timer(stage_timings_, ServoStage::SMOOTHING);
       smoother_->reset(current_state.positions);
-      smoother_->doSmoothing(target_state.positions);
+      smoother_->doSmoothing(target_state.positions, target_state.velocities, target_state.accelerations);
     }
 
+    ScopedStageTimer timer(stage_timings_, ServoStage::LIMIT_ENFORCEMENT);
+
     // Compute velocities based on smoothed joint positions
     target_joint_velocities = (target_joint_positions - current_joint_positions) / servo_params_.publish_period;
 
@@ -487,27 +735,25 @@ KinematicState Servo::getNextJointState(const ServoInput& command)
     target_joint_positions = current_joint_positions + (target_joint_velocities * servo_params_.publish_period);
 
     // Check if any joints are going past joint position limits
-    const std::vector<int> joints_to_halt =
-        jointsToHalt(target_joint_positions, target_joint_velocities, joint_bounds, servo_params_.joint_limit_margin);
+    jointsToHalt(target_joint_positions, target_joint_velocities, joint_bounds, servo_params_.joint_limit_margin,
+                 joints_to_halt_);
 
     // Apply halting if any joints need to be halted.
-    if (!joints_to_halt.empty())
+    if (!joints_to_halt_.empty())
     {
       servo_status_ = StatusCode::JOINT_BOUND;
-      target_state = haltJoints(joints_to_halt, current_state, target_state);
+      haltJoints(joints_to_halt_, current_state, target_state);
     }
   }
-
-  return target_state;
 }
 
 Eigen::Isometry3d Servo::getPlanningToCommandFrameTransform(const std::string& command_frame) const
 {
-  const moveit::core::RobotStatePtr robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
-  if (robot_state->knowsFrameTransform(command_frame))
+  // Only called while computing the next joint state, so robot_state_ is current and robot_state_mutex_ is held.
+  if (robot_state_->knowsFrameTransform(command_frame))
   {
-    return robot_state->getGlobalLinkTransform(servo_params_.planning_frame).inverse() *
-           robot_state->getGlobalLinkTransform(command_frame);
+    return robot_state_->getGlobalLinkTransform(servo_params_.planning_frame).inverse() *
+           robot_state_->getGlobalLinkTransform(command_frame);
   }
   else
   {
@@ -574,19 +820,29 @@ PoseCommand Servo::toPlanningFrame(const PoseCommand& command) const
                       getPlanningToCommandFrameTransform(command.frame_id) * command.pose };
 }
 
-KinematicState Servo::getCurrentRobotState() const
+StageTimings Servo::getStageTimings() const
 {
-  moveit::core::RobotStatePtr robot_state = planning_scene_monitor_->getStateMonitor()->getCurrentState();
-  const moveit::core::JointModelGroup* joint_model_group =
-      robot_state->getJointModelGroup(servo_params_.move_group_name);
-  const auto joint_names = joint_model_group->getActiveJointModelNames();
+  std::scoped_lock lock(robot_state_mutex_);
+  return stage_timings_;
+}
 
-  KinematicState current_state(joint_names.size());
-  current_state.joint_names = joint_names;
-  robot_state->copyJointGroupPositions(joint_model_group, current_state.positions);
-  robot_state->copyJointGroupVelocities(joint_model_group, current_state.velocities);
-  robot_state->copyJointGroupAccelerations(joint_model_group, current_state.accelerations);
+PoseTrackingReport Servo::getPoseTrackingReport() const
+{
+  std::scoped_lock lock(robot_state_mutex_);
+  return pose_tracking_state_.report;
+}
+
+void Servo::resetStageTimings()
+{
+  std::scoped_lock lock(robot_state_mutex_);
+  stage_timings_ = StageTimings();
+}
 
+KinematicState Servo::getCurrentRobotState() const
+{
+  std::scoped_lock lock(robot_state_mutex_);
+  KinematicState current_state;
+  updateCurrentState(current_state);
   return current_state;
 }
 
@@ -594,7 +850,10 @@ std::pair<bool, KinematicState> Servo::smoothHalt(const KinematicState& halt_sta
 {
   bool stopped = false;
   auto target_state = halt_state;
-  const auto current_state = getCurrentRobotState();
+
+  std::scoped_lock lock(robot_state_mutex_);
+  updateCurrentState(current_state_);
+  const KinematicState& current_state = current_state_;
 
   const size_t num_joints = current_state.joint_names.size();
   for (size_t i = 0; i < num_joints; i++)
@@ -612,7 +871,7 @@ std::pair<bool, KinematicState> Servo::smoothHalt(const KinematicState& halt_sta
   if (smoother_)
   {
     smoother_->reset(current_state.positions);
-    smoother_->doSmoothing(target_state.positions);
+    smoother_->doSmoothing(target_state.positions, target_state.velocities, target_state.accelerations);
   }
 
   return std::make_pair(stopped, target_state);
@@ -40,10 +40,23 @@
 
 #include <moveit_servo/servo_node.hpp>
 #include <realtime_tools/thread_priority.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
 
 namespace
 {
 const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_servo.servo_node");
+
+void addDiagnosticValue(diagnostic_msgs::msg::DiagnosticStatus& status, const std::string& key,
+                        const std::string& value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  status.values.push_back(key_value);
+}
 }  // namespace
 
 namespace moveit_servo
@@ -68,6 +81,7 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
   , new_joint_jog_msg_{ false }
   , new_twist_msg_{ false }
   , new_pose_msg_{ false }
+  , subgroups_halting_{ false }
 {
   if (!options.use_intra_process_comms())
   {
@@ -76,23 +90,6 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
                                "in the launch file");
   }
 
-  // Check if a realtime kernel is available
-  if (realtime_tools::has_realtime_kernel())
-  {
-    if (realtime_tools::configure_sched_fifo(servo_params_.thread_priority))
-    {
-      RCLCPP_INFO_STREAM(LOGGER, "Realtime kernel available, higher thread priority has been set.");
-    }
-    else
-    {
-      RCLCPP_WARN_STREAM(LOGGER, "Could not enable FIFO RT scheduling policy.");
-    }
-  }
-  else
-  {
-    RCLCPP_WARN_STREAM(LOGGER, "Realtime kernel is recommended for better performance.");
-  }
-
   std::shared_ptr<servo::ParamListener> servo_param_listener =
       std::make_shared<servo::ParamListener>(node_, "moveit_servo");
 
@@ -117,6 +114,40 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
       servo_params_.pose_command_in_topic, rclcpp::SystemDefaultsQoS(),
       [this](const geometry_msgs::msg::PoseStamped::ConstSharedPtr& msg) { return poseCallback(msg); });
 
+  // Create the command subscribers of the concurrently servoed subgroups
+  for (const std::string& subgroup : servo_params_.concurrent_subgroups)
+  {
+    auto channel = std::make_unique<SubgroupChannel>();
+    SubgroupChannel* const channel_ptr = channel.get();
+    channel->subgroup = subgroup;
+    channel->joint_jog_subscriber = node_->create_subscription<control_msgs::msg::JointJog>(
+        "~/" + subgroup + "/delta_joint_cmds", rclcpp::SystemDefaultsQoS(),
+        [channel_ptr](const control_msgs::msg::JointJog::ConstSharedPtr& msg) {
+          if (!channel_ptr->joint_jog_queue.push(*msg))
+          {
+            RCLCPP_DEBUG_STREAM(LOGGER, "Joint jog command queue is full, dropping command.");
+          }
+        });
+    channel->twist_subscriber = node_->create_subscription<geometry_msgs::msg::TwistStamped>(
+        "~/" + subgroup + "/delta_twist_cmds", rclcpp::SystemDefaultsQoS(),
+        [channel_ptr](const geometry_msgs::msg::TwistStamped::ConstSharedPtr& msg) {
+          if (!channel_ptr->twist_queue.push(*msg))
+          {
+            RCLCPP_DEBUG_STREAM(LOGGER, "Twist command queue is full, dropping command.");
+          }
+        });
+    channel->pose_subscriber = node_->create_subscription<geometry_msgs::msg::PoseStamped>(
+        "~/" + subgroup + "/pose_target_cmds", rclcpp::SystemDefaultsQoS(),
+        [channel_ptr](const geometry_msgs::msg::PoseStamped::ConstSharedPtr& msg) {
+          if (!channel_ptr->pose_queue.push(*msg))
+          {
+            RCLCPP_DEBUG_STREAM(LOGGER, "Pose command queue is full, dropping command.");
+          }
+        });
+    subgroup_channels_.push_back(std::move(channel));
+  }
+  subgroup_commands_.reserve(subgroup_channels_.size());
+
   if (servo_params_.command_out_type == "trajectory_msgs/JointTrajectory")
   {
     trajectory_publisher_ = node_->create_publisher<trajectory_msgs::msg::JointTrajectory>(
@@ -131,6 +162,17 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
   status_publisher_ =
       node_->create_publisher<moveit_msgs::msg::ServoStatus>(servo_params_.status_topic, rclcpp::SystemDefaultsQoS());
 
+  // Create publisher for the servo loop jitter statistics
+  if (servo_params_.loop_statistics_period > 0.0)
+  {
+    loop_jitter_samples_.reserve(LOOP_JITTER_QUEUE_SIZE);
+    loop_statistics_publisher_ = node_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+        "~/loop_statistics", rclcpp::SystemDefaultsQoS());
+    loop_statistics_timer_ =
+        node_->create_wall_timer(std::chrono::duration<double>(servo_params_.loop_statistics_period),
+                                 [this]() { return publishLoopStatistics(); });
+  }
+
   // Create service to enable switching command type
   switch_command_type_ = node_->create_service<moveit_msgs::srv::ServoCommandType>(
       "~/switch_command_type", [this](const std::shared_ptr<moveit_msgs::srv::ServoCommandType::Request>& request,
@@ -184,20 +226,136 @@ void ServoNode::switchCommandType(const std::shared_ptr<moveit_msgs::srv::ServoC
 
 void ServoNode::jointJogCallback(const control_msgs::msg::JointJog::ConstSharedPtr& msg)
 {
-  latest_joint_jog_ = *msg;
-  new_joint_jog_msg_ = true;
+  if (!joint_jog_queue_.push(*msg))
+  {
+    RCLCPP_DEBUG_STREAM(LOGGER, "Joint jog command queue is full, dropping command.");
+  }
 }
 
 void ServoNode::twistCallback(const geometry_msgs::msg::TwistStamped::ConstSharedPtr& msg)
 {
-  latest_twist_ = *msg;
-  new_twist_msg_ = true;
+  if (!twist_queue_.push(*msg))
+  {
+    RCLCPP_DEBUG_STREAM(LOGGER, "Twist command queue is full, dropping command.");
+  }
 }
 
 void ServoNode::poseCallback(const geometry_msgs::msg::PoseStamped::ConstSharedPtr& msg)
 {
-  latest_pose_ = *msg;
-  new_pose_msg_ = true;
+  if (!pose_queue_.push(*msg))
+  {
+    RCLCPP_DEBUG_STREAM(LOGGER, "Pose command queue is full, dropping command.");
+  }
+}
+
+void ServoNode::receiveCommands()
+{
+  // Only the most recent command of each type is used, older ones are skipped.
+  if (joint_jog_queue_.popLatest(latest_joint_jog_))
+    new_joint_jog_msg_ = true;
+  if (twist_queue_.popLatest(latest_twist_))
+    new_twist_msg_ = true;
+  if (pose_queue_.popLatest(latest_pose_))
+    new_pose_msg_ = true;
+
+  for (const auto& channel : subgroup_channels_)
+  {
+    channel->joint_jog_queue.popLatest(channel->latest_joint_jog);
+    channel->twist_queue.popLatest(channel->latest_twist);
+    channel->pose_queue.popLatest(channel->latest_pose);
+  }
+}
+
+void ServoNode::publishLoopStatistics()
+{
+  loop_jitter_samples_.clear();
+  double jitter;
+  while (loop_jitter_queue_.pop(jitter))
+    loop_jitter_samples_.push_back(jitter);
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = std::string(node_->get_fully_qualified_name()) + ": servo loop";
+  status.hardware_id = servo_params_.move_group_name;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  if (loop_jitter_samples_.empty())
+  {
+    status.message = "No servo loop cycles recorded";
+  }
+  else
+  {
+    const std::size_t count = loop_jitter_samples_.size();
+    const double mean =
+        std::accumulate(loop_jitter_samples_.begin(), loop_jitter_samples_.end(), 0.0) / static_cast<double>(count);
+    const double max = *std::max_element(loop_jitter_samples_.begin(), loop_jitter_samples_.end());
+    const auto p99 = loop_jitter_samples_.begin() + static_cast<std::ptrdiff_t>(std::ceil(0.99 * count) - 1);
+    std::nth_element(loop_jitter_samples_.begin(), p99, loop_jitter_samples_.end());
+
+    // A cycle that is late by more than a full period means that a command was skipped.
+    if (max > servo_params_.publish_period)
+    {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      status.message = "Servo loop missed its period";
+    }
+    else
+    {
+      status.message = "Servo loop running";
+    }
+
+    addDiagnosticValue(status, "cycles", std::to_string(count));
+    addDiagnosticValue(status, "mean_jitter", std::to_string(mean));
+    addDiagnosticValue(status, "p99_jitter", std::to_string(*p99));
+    addDiagnosticValue(status, "max_jitter", std::to_string(max));
+  }
+
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = node_->now();
+  msg.status.push_back(status);
+  if (servo_params_.pose_tracking.use_iterative_ik)
+  {
+    msg.status.push_back(poseTrackingStatistics());
+  }
+  loop_statistics_publisher_->publish(msg);
+}
+
+diagnostic_msgs::msg::DiagnosticStatus ServoNode::poseTrackingStatistics()
+{
+  std::size_t count = 0, converged = 0, iterations = 0;
+  double total_latency = 0.0, max_latency = 0.0;
+  PoseTrackingReport report;
+  while (pose_tracking_queue_.pop(report))
+  {
+    ++count;
+    converged += report.converged ? 1 : 0;
+    iterations += report.iterations;
+    total_latency += report.latency;
+    max_latency = std::max(max_latency, report.latency);
+  }
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = std::string(node_->get_fully_qualified_name()) + ": pose tracking";
+  status.hardware_id = servo_params_.move_group_name;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  if (count == 0)
+  {
+    status.message = "No pose commands solved";
+    return status;
+  }
+
+  if (converged < count)
+  {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = "Pose tracking did not converge in " + std::to_string(count - converged) + " cycles";
+  }
+  else
+  {
+    status.message = "Pose tracking converged";
+  }
+  addDiagnosticValue(status, "cycles", std::to_string(count));
+  addDiagnosticValue(status, "converged", std::to_string(converged));
+  addDiagnosticValue(status, "mean_iterations", std::to_string(static_cast<double>(iterations) / count));
+  addDiagnosticValue(status, "mean_latency", std::to_string(total_latency / count));
+  addDiagnosticValue(status, "max_latency", std::to_string(max_latency));
+  return status;
 }
 
 std::optional<KinematicState> ServoNode::processJointJogCommand()
@@ -273,6 +431,11 @@ std::optional<KinematicState> ServoNode::processPoseCommand()
   {
     const PoseCommand command = poseFromPoseStamped(latest_pose_);
     next_joint_state = servo_->getNextJointState(command);
+    if (servo_params_.pose_tracking.use_iterative_ik && servo_params_.loop_statistics_period > 0.0)
+    {
+      // The reports are dropped if the statistics are not consumed in time.
+      pose_tracking_queue_.push(servo_->getPoseTrackingReport());
+    }
   }
   else
   {
@@ -288,22 +451,112 @@ std::optional<KinematicState> ServoNode::processPoseCommand()
   return next_joint_state;
 }
 
+std::optional<KinematicState> ServoNode::processSubgroupCommands()
+{
+  std::optional<KinematicState> next_joint_state = std::nullopt;
+
+  // Every subgroup with a recent command of the expected type takes part in this cycle.
+  const CommandType expected_type = servo_->getCommandType();
+  const rclcpp::Time now = node_->now();
+  const rclcpp::Duration timeout = rclcpp::Duration::from_seconds(servo_params_.incoming_command_timeout);
+  subgroup_commands_.clear();
+  for (const auto& channel : subgroup_channels_)
+  {
+    if (expected_type == CommandType::JOINT_JOG && (now - channel->latest_joint_jog.header.stamp) < timeout)
+    {
+      const auto& msg = channel->latest_joint_jog;
+      subgroup_commands_.push_back({ channel->subgroup, JointJogCommand{ msg.joint_names, msg.velocities }, "" });
+    }
+    else if (expected_type == CommandType::TWIST && (now - channel->latest_twist.header.stamp) < timeout)
+    {
+      const auto& twist = channel->latest_twist.twist;
+      const Eigen::Vector<double, 6> velocities{ twist.linear.x,  twist.linear.y,  twist.linear.z,
+                                                 twist.angular.x, twist.angular.y, twist.angular.z };
+      subgroup_commands_.push_back(
+          { channel->subgroup, TwistCommand{ channel->latest_twist.header.frame_id, velocities }, "" });
+    }
+    else if (expected_type == CommandType::POSE && (now - channel->latest_pose.header.stamp) < timeout)
+    {
+      subgroup_commands_.push_back({ channel->subgroup, poseFromPoseStamped(channel->latest_pose), "" });
+    }
+  }
+
+  if (!subgroup_commands_.empty())
+  {
+    KinematicState next_state;
+    servo_->getNextJointState(subgroup_commands_, next_state);
+    next_joint_state = std::move(next_state);
+    subgroups_halting_ = true;
+  }
+  else if (subgroups_halting_)
+  {
+    // All commands went stale, bring the robot to a stop.
+    auto result = servo_->smoothHalt(last_commanded_state_);
+    subgroups_halting_ = !result.first;
+    next_joint_state = result.second;
+    RCLCPP_DEBUG_STREAM(LOGGER, "Subgroup commands timed out. Halting to a stop.");
+  }
+
+  return next_joint_state;
+}
+
 void ServoNode::servoLoop()
 {
   moveit_msgs::msg::ServoStatus status_msg;
   std::optional<KinematicState> next_joint_state = std::nullopt;
   rclcpp::WallRate servo_frequency(1 / servo_params_.publish_period);
 
+  // The scheduling policy applies to the calling thread only, so it is set from within the servo loop thread.
+  if (realtime_tools::has_realtime_kernel())
+  {
+    if (realtime_tools::configure_sched_fifo(servo_params_.thread_priority))
+    {
+      RCLCPP_INFO_STREAM(LOGGER, "Realtime kernel available, higher thread priority has been set.");
+    }
+    else
+    {
+      RCLCPP_WARN_STREAM(LOGGER, "Could not enable FIFO RT scheduling policy.");
+    }
+  }
+  else
+  {
+    RCLCPP_WARN_STREAM(LOGGER, "Realtime kernel is recommended for better performance.");
+  }
+
+  const bool record_jitter = servo_params_.loop_statistics_period > 0.0;
+  const std::chrono::duration<double> publish_period(servo_params_.publish_period);
+  std::chrono::steady_clock::time_point last_cycle_start;
+
   while (rclcpp::ok() && !stop_servo_)
   {
     // Skip processing if servoing is disabled.
+    // The loop still has to sleep, a busy loop would starve other threads when running with realtime priority.
     if (servo_paused_)
+    {
+      last_cycle_start = std::chrono::steady_clock::time_point();
+      servo_frequency.sleep();
       continue;
+    }
+
+    const auto cycle_start = std::chrono::steady_clock::now();
+    if (record_jitter && last_cycle_start != std::chrono::steady_clock::time_point())
+    {
+      // The samples are dropped if the statistics are not consumed in time.
+      const std::chrono::duration<double> period = cycle_start - last_cycle_start;
+      loop_jitter_queue_.push(std::abs((period - publish_period).count()));
+    }
+    last_cycle_start = cycle_start;
+
+    receiveCommands();
 
     next_joint_state = std::nullopt;
     const CommandType expected_type = servo_->getCommandType();
 
-    if (expected_type == CommandType::JOINT_JOG && new_joint_jog_msg_)
+    if (!subgroup_channels_.empty())
+    {
+      next_joint_state = processSubgroupCommands();
+    }
+    else if (expected_type == CommandType::JOINT_JOG && new_joint_jog_msg_)
     {
       next_joint_state = processJointJogCommand();
     }
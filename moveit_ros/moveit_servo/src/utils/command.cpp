@@ -38,6 +38,7 @@
  */
 
 #include <moveit_servo/utils/command.hpp>
+#include <chrono>
 
 namespace
 {
@@ -78,17 +79,33 @@ namespace moveit_servo
 JointDeltaResult jointDeltaFromJointJog(const JointJogCommand& command, const moveit::core::RobotStatePtr& robot_state,
                                         const servo::Params& servo_params,
                                         const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
+{
+  Eigen::VectorXd joint_position_delta;
+  const StatusCode status =
+      jointDeltaFromJointJog(command, robot_state, servo_params, joint_name_group_index_map, joint_position_delta);
+  return std::make_pair(status, joint_position_delta);
+}
+
+StatusCode jointDeltaFromJointJog(const JointJogCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                  const servo::Params& servo_params,
+                                  const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                  Eigen::VectorXd& joint_position_delta)
 {
   // Find the target joint position based on the commanded joint velocity
   StatusCode status = StatusCode::NO_WARNING;
   const auto& group_name =
       servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
   const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup(group_name);
-  const auto joint_names = joint_model_group->getActiveJointModelNames();
-  Eigen::VectorXd joint_position_delta(joint_names.size());
-  Eigen::VectorXd velocities(joint_names.size());
+  const auto& joint_names = joint_model_group->getActiveJointModelNames();
+  const bool use_subgroup =
+      !servo_params.active_subgroup.empty() && servo_params.active_subgroup != servo_params.move_group_name;
 
-  velocities.setZero();
+  // The velocities are scattered directly into the move group sized delta vector, joints that are not part of an
+  // active subgroup stay zero.
+  const size_t num_joints =
+      robot_state->getJointModelGroup(servo_params.move_group_name)->getActiveJointModelNames().size();
+  joint_position_delta.resize(num_joints);
+  joint_position_delta.setZero();
   bool names_valid = true;
 
   for (size_t i = 0; i < command.names.size(); i++)
@@ -96,7 +113,9 @@ JointDeltaResult jointDeltaFromJointJog(const JointJogCommand& command, const mo
     auto it = std::find(joint_names.begin(), joint_names.end(), command.names[i]);
     if (it != std::end(joint_names))
     {
-      velocities[std::distance(joint_names.begin(), it)] = command.velocities[i];
+      const size_t index =
+          use_subgroup ? joint_name_group_index_map.at(*it) : std::distance(joint_names.begin(), it);
+      joint_position_delta[index] = command.velocities[i];
     }
     else
     {
@@ -106,10 +125,10 @@ JointDeltaResult jointDeltaFromJointJog(const JointJogCommand& command, const mo
       break;
     }
   }
-  const bool velocity_valid = isValidCommand(velocities);
+  const bool velocity_valid = isValidCommand(joint_position_delta);
   if (names_valid && velocity_valid)
   {
-    joint_position_delta = velocities * servo_params.publish_period;
+    joint_position_delta *= servo_params.publish_period;
     if (servo_params.command_in_type == "unitless")
     {
       joint_position_delta *= servo_params.scale.joint;
@@ -130,24 +149,39 @@ JointDeltaResult jointDeltaFromJointJog(const JointJogCommand& command, const mo
     }
   }
 
-  if (!servo_params.active_subgroup.empty() && servo_params.active_subgroup != servo_params.move_group_name)
+  return status;
+}
+
+JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                     const servo::Params& servo_params,
+                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
+{
+  Eigen::VectorXd cartesian_position_delta;
+  JointDeltaResult delta_result =
+      jointDeltaFromTwist(command, robot_state, servo_params, joint_name_group_index_map, cartesian_position_delta);
+  if (delta_result.first != StatusCode::INVALID && cartesian_position_delta.size() > 0)
   {
-    return std::make_pair(status, createMoveGroupDelta(joint_position_delta, robot_state, servo_params,
-                                                       joint_name_group_index_map));
+    SingularityDirectionCaches singularity_caches;
+    const StatusCode singularity_status = scaleForSingularity(cartesian_position_delta, robot_state, servo_params,
+                                                              singularity_caches, delta_result.second);
+    if (singularity_status != StatusCode::NO_WARNING)
+    {
+      delta_result.first = singularity_status;
+    }
   }
-
-  return std::make_pair(status, joint_position_delta);
+  return delta_result;
 }
 
 JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::core::RobotStatePtr& robot_state,
                                      const servo::Params& servo_params,
-                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
+                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                     Eigen::VectorXd& cartesian_position_delta)
 {
   StatusCode status = StatusCode::NO_WARNING;
   const int num_joints =
       robot_state->getJointModelGroup(servo_params.move_group_name)->getActiveJointModelNames().size();
   Eigen::VectorXd joint_position_delta(num_joints);
-  Eigen::VectorXd cartesian_position_delta;
+  cartesian_position_delta.resize(0);
 
   const bool valid_command = isValidCommand(command);
   const bool is_planning_frame = (command.frame_id == servo_params.planning_frame);
@@ -172,16 +206,6 @@ JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::
     if (status != StatusCode::INVALID)
     {
       joint_position_delta = delta_result.second;
-      // Get velocity scaling information for singularity.
-      const std::pair<double, StatusCode> singularity_scaling_info =
-          velocityScalingFactorForSingularity(robot_state, cartesian_position_delta, servo_params);
-      // Apply velocity scaling for singularity, if there was any scaling.
-      if (singularity_scaling_info.second != StatusCode::NO_WARNING)
-      {
-        status = singularity_scaling_info.second;
-        RCLCPP_WARN_STREAM(LOGGER, SERVO_STATUS_CODE_MAP.at(status));
-        joint_position_delta *= singularity_scaling_info.first;
-      }
     }
   }
   else if (is_zero)
@@ -204,6 +228,26 @@ JointDeltaResult jointDeltaFromTwist(const TwistCommand& command, const moveit::
   return std::make_pair(status, joint_position_delta);
 }
 
+StatusCode scaleForSingularity(const Eigen::VectorXd& cartesian_position_delta,
+                               const moveit::core::RobotStatePtr& robot_state, const servo::Params& servo_params,
+                               SingularityDirectionCaches& singularity_caches, Eigen::VectorXd& joint_position_delta)
+{
+  // The cache is kept per group, the same group selection as in velocityScalingFactorForSingularity.
+  const std::string& group_name =
+      servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
+  SingularityDirectionCache& singularity_cache = singularity_caches[group_name];
+  // Get velocity scaling information for singularity.
+  const std::pair<double, StatusCode> singularity_scaling_info =
+      velocityScalingFactorForSingularity(robot_state, cartesian_position_delta, servo_params, singularity_cache);
+  // Apply velocity scaling for singularity, if there was any scaling.
+  if (singularity_scaling_info.second != StatusCode::NO_WARNING)
+  {
+    RCLCPP_WARN_STREAM(LOGGER, SERVO_STATUS_CODE_MAP.at(singularity_scaling_info.second));
+    joint_position_delta *= singularity_scaling_info.first;
+  }
+  return singularity_scaling_info.second;
+}
+
 JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::core::RobotStatePtr& robot_state,
                                     const servo::Params& servo_params,
                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
@@ -254,6 +298,124 @@ JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::co
   return std::make_pair(status, joint_position_delta);
 }
 
+JointDeltaResult jointDeltaFromPoseTracking(const PoseCommand& command, const moveit::core::RobotStatePtr& robot_state,
+                                            const servo::Params& servo_params,
+                                            const JointNameToMoveGroupIndexMap& joint_name_group_index_map,
+                                            PoseTrackingState& tracking_state)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  PoseTrackingReport& report = tracking_state.report;
+  report = PoseTrackingReport();
+
+  StatusCode status = StatusCode::NO_WARNING;
+  const int num_joints =
+      robot_state->getJointModelGroup(servo_params.move_group_name)->getActiveJointModelNames().size();
+  Eigen::VectorXd joint_position_delta = Eigen::VectorXd::Zero(num_joints);
+
+  const bool valid_command = isValidCommand(command);
+  const bool is_planning_frame = command.frame_id == servo_params.planning_frame;
+  const moveit::core::LinkModel* ee_link = robot_state->getRigidlyConnectedParentLinkModel(servo_params.ee_frame);
+  if (!valid_command || !is_planning_frame || !ee_link)
+  {
+    status = StatusCode::INVALID;
+    if (!valid_command)
+    {
+      RCLCPP_WARN_STREAM(LOGGER, "Invalid pose command.");
+    }
+    if (!is_planning_frame)
+    {
+      RCLCPP_WARN_STREAM(LOGGER,
+                         "Command frame is: " << command.frame_id << " expected: " << servo_params.planning_frame);
+    }
+    if (!ee_link)
+    {
+      RCLCPP_WARN_STREAM(LOGGER, "Unknown end effector frame " << servo_params.ee_frame);
+    }
+    report.latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return std::make_pair(status, joint_position_delta);
+  }
+
+  const auto& group_name =
+      servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
+  const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup(group_name);
+
+  // The end effector frame is rigidly attached to ee_link, the offset does not change while iterating.
+  const Eigen::Isometry3d link_to_ee = robot_state->getGlobalLinkTransform(ee_link).inverse() *
+                                       robot_state->getFrameTransform(servo_params.ee_frame);
+
+  Eigen::VectorXd current_positions;
+  robot_state->copyJointGroupPositions(joint_model_group, current_positions);
+
+  // A pose target that moves smoothly is closer to the previous solution than to the current state, which lags behind.
+  report.warm_started = tracking_state.group_name == group_name &&
+                        tracking_state.solution.size() == current_positions.size() &&
+                        (tracking_state.solution - current_positions).lpNorm<Eigen::Infinity>() <=
+                            servo_params.pose_tracking.max_seed_distance;
+  Eigen::VectorXd positions = report.warm_started ? tracking_state.solution : current_positions;
+
+  const std::chrono::duration<double> time_budget(servo_params.pose_tracking.time_budget);
+  const double damping_squared = servo_params.pose_tracking.damping * servo_params.pose_tracking.damping;
+  Eigen::Vector<double, 6> pose_error;
+  Eigen::MatrixXd jacobian;
+  Eigen::Matrix<double, 6, 6> damped_jacobian_square;
+  while (true)
+  {
+    robot_state->setJointGroupPositions(joint_model_group, positions);
+    robot_state->enforceBounds(joint_model_group);
+    robot_state->copyJointGroupPositions(joint_model_group, positions);
+
+    // Compute linear and angular change needed.
+    const Eigen::Isometry3d ee_pose = robot_state->getGlobalLinkTransform(ee_link) * link_to_ee;
+    const Eigen::Quaterniond q_current(ee_pose.rotation()), q_target(command.pose.rotation());
+    const Eigen::AngleAxisd angle_axis_error(q_target * q_current.inverse());
+    pose_error.head<3>() = command.pose.translation() - ee_pose.translation();
+    pose_error.tail<3>() = angle_axis_error.axis() * angle_axis_error.angle();
+
+    report.linear_error = pose_error.head<3>().norm();
+    report.angular_error = std::abs(angle_axis_error.angle());
+    report.converged = report.linear_error <= servo_params.pose_tracking.linear_tolerance &&
+                       report.angular_error <= servo_params.pose_tracking.angular_tolerance;
+    if (report.converged || report.iterations >= servo_params.pose_tracking.max_iterations ||
+        std::chrono::steady_clock::now() - start_time >= time_budget)
+    {
+      break;
+    }
+
+    // Damped least squares step: J^T * (J * J^T + damping^2 * I)^-1 * error
+    if (!robot_state->getJacobian(joint_model_group, ee_link, link_to_ee.translation(), jacobian))
+    {
+      status = StatusCode::INVALID;
+      break;
+    }
+    damped_jacobian_square.noalias() = jacobian * jacobian.transpose();
+    damped_jacobian_square.diagonal().array() += damping_squared;
+    positions += jacobian.transpose() * damped_jacobian_square.ldlt().solve(pose_error);
+    ++report.iterations;
+  }
+
+  // Leave the robot state as it was.
+  robot_state->setJointGroupPositions(joint_model_group, current_positions);
+
+  if (status != StatusCode::INVALID)
+  {
+    tracking_state.group_name = group_name;
+    tracking_state.solution = positions;
+    joint_position_delta = positions - current_positions;
+    if (!servo_params.active_subgroup.empty() && servo_params.active_subgroup != servo_params.move_group_name)
+    {
+      joint_position_delta =
+          createMoveGroupDelta(joint_position_delta, robot_state, servo_params, joint_name_group_index_map);
+    }
+  }
+  else
+  {
+    tracking_state.solution.resize(0);
+  }
+
+  report.latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return std::make_pair(status, joint_position_delta);
+}
+
 JointDeltaResult jointDeltaFromIK(const Eigen::VectorXd& cartesian_position_delta,
                                   const moveit::core::RobotStatePtr& robot_state, const servo::Params& servo_params,
                                   const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
@@ -38,11 +38,27 @@
  */
 
 #include <moveit_servo/utils/common.hpp>
+#include <Eigen/Eigenvalues>
+#include <limits>
 
 namespace
 {
 // The threshold above which `override_velocity_scaling_factor` will be used instead of computing the scaling from joint bounds.
 const double SCALING_OVERRIDE_THRESHOLD = 0.01;
+// The smallest absolute cosine between the least singular vectors of two calls for which the sign is carried over.
+// An unrelated vector of the opposite sign cannot pass this test.
+const double SINGULAR_VECTOR_MIN_ALIGNMENT = 0.9;
+
+// Computes the condition number of a matrix from the squared singular values, sorted in increasing order.
+double conditionNumber(const Eigen::VectorXd& squared_singular_values)
+{
+  const double smallest = squared_singular_values(0);
+  if (smallest <= 0.0)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  return std::sqrt(squared_singular_values(squared_singular_values.size() - 1) / smallest);
+}
 }  // namespace
 
 namespace moveit_servo
@@ -152,61 +168,100 @@ std_msgs::msg::Float64MultiArray composeMultiArrayMessage(const servo::Params& s
 std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::core::RobotStatePtr& robot_state,
                                                                   const Eigen::VectorXd& target_delta_x,
                                                                   const servo::Params& servo_params)
+{
+  // Without a previous direction, it is always resolved by a perturbation step.
+  SingularityDirectionCache cache;
+  return velocityScalingFactorForSingularity(robot_state, target_delta_x, servo_params, cache);
+}
+
+std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::core::RobotStatePtr& robot_state,
+                                                                  const Eigen::VectorXd& target_delta_x,
+                                                                  const servo::Params& servo_params,
+                                                                  SingularityDirectionCache& cache)
 {
   // We need to send information back about if we are halting, moving away or towards the singularity.
   StatusCode servo_status = StatusCode::NO_WARNING;
 
-  const moveit::core::JointModelGroup* joint_model_group =
-      robot_state->getJointModelGroup(servo_params.move_group_name);
+  // The Jacobian is only defined for chains, so the commanded subgroup is used like in jointDeltaFromIK.
+  const std::string& group_name =
+      servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
+  const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup(group_name);
 
   // Get the thresholds.
   const double lower_singularity_threshold = servo_params.lower_singularity_threshold;
   const double hard_stop_singularity_threshold = servo_params.hard_stop_singularity_threshold;
   const double leaving_singularity_threshold_multiplier = servo_params.leaving_singularity_threshold_multiplier;
 
-  // Get size of total controllable dimensions.
-  const size_t dims = target_delta_x.size();
-
-  // Get the current Jacobian and compute SVD
-  const Eigen::JacobiSVD<Eigen::MatrixXd> current_svd = Eigen::JacobiSVD<Eigen::MatrixXd>(
-      robot_state->getJacobian(joint_model_group), Eigen::ComputeThinU | Eigen::ComputeThinV);
-  const Eigen::MatrixXd matrix_s = current_svd.singularValues().asDiagonal();
-
-  // Compute pseudo inverse
-  const Eigen::MatrixXd pseudo_inverse = current_svd.matrixV() * matrix_s.inverse() * current_svd.matrixU().transpose();
-
-  // Get the singular vector corresponding to least singular value.
-  // This vector represents the least responsive dimension. By convention this is the last column of the matrix U.
-  // The sign of the singular vector from result of SVD is not reliable, so we need to do extra checking to make sure of
-  // the sign. See R. Bro, "Resolving the Sign Ambiguity in the Singular Value Decomposition".
-  Eigen::VectorXd vector_towards_singularity = current_svd.matrixU().col(dims - 1);
+  // The singular values and left singular vectors of the Jacobian J are obtained from the eigen decomposition of the
+  // small square matrix J * J^T, which is considerably cheaper than an SVD of J. The eigenvalues are the squared
+  // singular values in increasing order. Their relative error is in the order of the machine precision times the
+  // squared condition number, i.e. below 1e-12 for condition numbers up to 1e2.
+  const Eigen::MatrixXd jacobian = robot_state->getJacobian(joint_model_group);
+  const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> current_eigen(jacobian * jacobian.transpose());
+  const Eigen::VectorXd& squared_singular_values = current_eigen.eigenvalues();
 
   // Compute the current condition number. The ratio of max and min singular values.
-  // By convention these are the first and last element of the diagonal.
-  const double current_condition_number = current_svd.singularValues()(0) / current_svd.singularValues()(dims - 1);
-
-  // Take a small step in the direction of vector_towards_singularity
-  const Eigen::VectorXd delta_x = vector_towards_singularity * servo_params.singularity_step_scale;
+  const double current_condition_number = conditionNumber(squared_singular_values);
 
-  // Compute the new joint angles if we take the small step delta_x
-  Eigen::VectorXd next_joint_angles;
-  robot_state->copyJointGroupPositions(joint_model_group, next_joint_angles);
-  next_joint_angles += pseudo_inverse * delta_x;
-
-  // Compute the Jacobian SVD for the new robot state.
-  robot_state->setJointGroupPositions(joint_model_group, next_joint_angles);
-  const Eigen::JacobiSVD<Eigen::MatrixXd> next_svd = Eigen::JacobiSVD<Eigen::MatrixXd>(
-      robot_state->getJacobian(joint_model_group), Eigen::ComputeThinU | Eigen::ComputeThinV);
-
-  // Compute condition number for the new Jacobian.
-  const double next_condition_number = next_svd.singularValues()(0) / next_svd.singularValues()(dims - 1);
+  // Get the singular vector corresponding to least singular value.
+  // This vector represents the least responsive dimension. It is the eigenvector of the smallest eigenvalue.
+  // The sign of the singular vector is not reliable, so we need to do extra checking to make sure of the sign.
+  // See R. Bro, "Resolving the Sign Ambiguity in the Singular Value Decomposition".
+  Eigen::VectorXd vector_towards_singularity = current_eigen.eigenvectors().col(0);
+
+  Eigen::VectorXd joint_angles;
+  robot_state->copyJointGroupPositions(joint_model_group, joint_angles);
+
+  // The least singular vector rotates continuously with the joint angles, so the sign resolved in the previous call
+  // stays valid as long as the vectors are aligned and the robot has not moved too far since it was last resolved.
+  const bool cache_applies =
+      servo_params.singularity_direction_reuse_distance > 0.0 && cache.group_name == group_name &&
+      cache.resolved_joint_positions.size() == joint_angles.size() &&
+      cache.vector_towards_singularity.size() == vector_towards_singularity.size() &&
+      (joint_angles - cache.resolved_joint_positions).lpNorm<Eigen::Infinity>() <=
+          servo_params.singularity_direction_reuse_distance;
+  const double alignment = cache_applies ? vector_towards_singularity.dot(cache.vector_towards_singularity) : 0.0;
+
+  if (std::abs(alignment) >= SINGULAR_VECTOR_MIN_ALIGNMENT)
+  {
+    if (alignment < 0.0)
+    {
+      vector_towards_singularity *= -1;
+    }
+    cache.vector_towards_singularity = vector_towards_singularity;
+  }
+  else if (squared_singular_values(0) > 0.0)
+  {
+    // Take a small step delta_x in the direction of vector_towards_singularity. For a left singular vector u with
+    // singular value s, the pseudo inverse of the Jacobian gives J^+ * u = J^T * u / s^2.
+    const Eigen::VectorXd next_joint_angles =
+        joint_angles + jacobian.transpose() * vector_towards_singularity *
+                           (servo_params.singularity_step_scale / squared_singular_values(0));
+
+    // Compute the condition number for the new robot state, then restore the current one.
+    robot_state->setJointGroupPositions(joint_model_group, next_joint_angles);
+    const Eigen::MatrixXd next_jacobian = robot_state->getJacobian(joint_model_group);
+    const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> next_eigen(next_jacobian * next_jacobian.transpose(),
+                                                                    Eigen::EigenvaluesOnly);
+    const double next_condition_number = conditionNumber(next_eigen.eigenvalues());
+    robot_state->setJointGroupPositions(joint_model_group, joint_angles);
+
+    // If the condition number has increased, we are moving towards singularity and the direction of the
+    // vector_towards_singularity is correct. If the condition number has decreased, it means the sign of
+    // vector_towards_singularity needs to be flipped.
+    if (next_condition_number <= current_condition_number)
+    {
+      vector_towards_singularity *= -1;
+    }
 
-  // If the condition number has increased, we are moving towards singularity and the direction of the
-  // vector_towards_singularity is correct. If the condition number has decreased, it means the sign of
-  // vector_towards_singularity needs to be flipped.
-  if (next_condition_number <= current_condition_number)
+    cache.group_name = group_name;
+    cache.resolved_joint_positions = joint_angles;
+    cache.vector_towards_singularity = vector_towards_singularity;
+  }
+  else
   {
-    vector_towards_singularity *= -1;
+    // The direction cannot be resolved at an exact singularity, the robot halts anyway.
+    cache = SingularityDirectionCache();
   }
 
   // Double check the direction using dot product.
@@ -247,42 +302,48 @@ std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::
   return std::make_pair(velocity_scale, servo_status);
 }
 
-double jointLimitVelocityScalingFactor(const Eigen::VectorXd& velocities,
+double jointLimitVelocityScalingFactor(const Eigen::Ref<const Eigen::VectorXd>& velocities,
                                        const moveit::core::JointBoundsVector& joint_bounds, double scaling_override)
 {
   // If override value is close to zero, user is not overriding the scaling
   if (scaling_override < SCALING_OVERRIDE_THRESHOLD)
   {
     scaling_override = 1.0;  // Set to no scaling.
-    double bounded_vel;
-    std::vector<double> velocity_scaling_factors;  // The allowable fraction of computed veclocity
 
+    // Find the lowest allowable fraction of computed velocity, this helps preserve Cartesian motion.
     for (size_t i = 0; i < joint_bounds.size(); i++)
     {
-      const auto joint_bound = (joint_bounds[i])->front();
+      const auto& joint_bound = (joint_bounds[i])->front();
       if (joint_bound.velocity_bounded_ && velocities(i) != 0.0)
       {
         // Find the ratio of clamped velocity to original velocity
-        bounded_vel = std::clamp(velocities(i), joint_bound.min_velocity_, joint_bound.max_velocity_);
-        velocity_scaling_factors.push_back(bounded_vel / velocities(i));
+        const double bounded_vel = std::clamp(velocities(i), joint_bound.min_velocity_, joint_bound.max_velocity_);
+        scaling_override = std::min(scaling_override, bounded_vel / velocities(i));
       }
     }
-    // Find the lowest scaling factor, this helps preserve Cartesian motion.
-    scaling_override = velocity_scaling_factors.empty() ?
-                           scaling_override :
-                           *std::min_element(velocity_scaling_factors.begin(), velocity_scaling_factors.end());
   }
 
   return scaling_override;
 }
 
-std::vector<int> jointsToHalt(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+std::vector<int> jointsToHalt(const Eigen::Ref<const Eigen::VectorXd>& positions,
+                              const Eigen::Ref<const Eigen::VectorXd>& velocities,
                               const moveit::core::JointBoundsVector& joint_bounds, double margin)
 {
   std::vector<int> joint_idxs_to_halt;
+  jointsToHalt(positions, velocities, joint_bounds, margin, joint_idxs_to_halt);
+  return joint_idxs_to_halt;
+}
+
+void jointsToHalt(const Eigen::Ref<const Eigen::VectorXd>& positions,
+                  const Eigen::Ref<const Eigen::VectorXd>& velocities,
+                  const moveit::core::JointBoundsVector& joint_bounds, double margin,
+                  std::vector<int>& joint_idxs_to_halt)
+{
+  joint_idxs_to_halt.clear();
   for (size_t i = 0; i < joint_bounds.size(); i++)
   {
-    const auto joint_bound = (joint_bounds[i])->front();
+    const auto& joint_bound = (joint_bounds[i])->front();
     if (joint_bound.position_bounded_)
     {
       const bool negative_bound = velocities[i] < 0 && positions[i] < (joint_bound.min_position_ + margin);
@@ -293,7 +354,26 @@ std::vector<int> jointsToHalt(const Eigen::VectorXd& positions, const Eigen::Vec
       }
     }
   }
-  return joint_idxs_to_halt;
+}
+
+double collisionFreeHorizonFraction(moveit::core::RobotState& predicted_state,
+                                    const moveit::core::JointModelGroup* joint_model_group,
+                                    const Eigen::VectorXd& start_positions, const Eigen::VectorXd& velocities,
+                                    double horizon, int steps,
+                                    const std::function<bool(const moveit::core::RobotState&)>& is_colliding)
+{
+  for (int step = 1; step <= steps; ++step)
+  {
+    const double time = horizon * step / steps;
+    predicted_state.setJointGroupPositions(joint_model_group, start_positions + velocities * time);
+    predicted_state.enforceBounds(joint_model_group);
+    predicted_state.updateCollisionBodyTransforms();
+    if (is_colliding(predicted_state))
+    {
+      return static_cast<double>(step - 1) / steps;
+    }
+  }
+  return 1.0;
 }
 
 /** \brief Helper function for converting Eigen::Isometry3d to geometry_msgs/TransformStamped **/
@@ -0,0 +1,345 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2026, PickNik Robotics, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+/*
+ * Title      : world_distance_field.cpp
+ * Project    : moveit_servo
+ * Created    : 10/17/2026
+ */
+
+#include <moveit_servo/world_distance_field.hpp>
+#include <geometric_shapes/shape_operations.h>
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+namespace moveit_servo
+{
+
+WorldDistanceField::WorldDistanceField(const moveit::core::RobotModelConstPtr& robot_model,
+                                       const Eigen::Vector3d& size, const Eigen::Vector3d& origin, double resolution,
+                                       double max_distance)
+  : size_(size), origin_(origin), max_distance_(max_distance), resolution_(resolution)
+{
+  fields_.push_back(makeField({}));
+  for (const moveit::core::LinkModel* link : robot_model->getLinkModelsWithCollisionGeometry())
+  {
+    if (link->getShapes().empty())
+    {
+      continue;
+    }
+    const auto decomposition = std::make_shared<const collision_detection::BodyDecomposition>(
+        link->getShapes(), link->getCollisionOriginTransforms(), resolution, 0.0);
+    link_spheres_.push_back(
+        LinkSpheres{ link, std::make_shared<collision_detection::PosedBodySphereDecomposition>(decomposition) });
+  }
+}
+
+std::unique_ptr<WorldDistanceField::Field> WorldDistanceField::makeField(std::set<std::string> allowed) const
+{
+  auto field = std::make_unique<Field>();
+  field->allowed = std::move(allowed);
+  field->distance_field = std::make_unique<distance_field::PropagationDistanceField>(
+      size_.x(), size_.y(), size_.z(), resolution_, origin_.x(), origin_.y(), origin_.z(), max_distance_);
+  return field;
+}
+
+std::size_t WorldDistanceField::update(const collision_detection::World& world)
+{
+  return updateObjects(world, {}, 0);
+}
+
+std::size_t WorldDistanceField::update(const collision_detection::World& world,
+                                       const collision_detection::AllowedCollisionMatrix& acm,
+                                       const moveit::core::RobotState& state)
+{
+  std::vector<std::string> body_names;
+  for (const LinkSpheres& link_spheres : link_spheres_)
+  {
+    body_names.push_back(link_spheres.link->getName());
+  }
+  std::vector<const moveit::core::AttachedBody*> attached_bodies;
+  state.getAttachedBodies(attached_bodies);
+  for (const moveit::core::AttachedBody* body : attached_bodies)
+  {
+    body_names.push_back(body->getName());
+  }
+
+  // Conditional collisions cannot be decided from distances, so only collisions that are always allowed are skipped.
+  std::map<std::string, std::set<std::string>> allowed;
+  for (const auto& [id, object] : world)
+  {
+    std::set<std::string>& object_allowed = allowed[id];
+    for (const std::string& name : body_names)
+    {
+      collision_detection::AllowedCollision::Type type;
+      if (acm.getAllowedCollision(id, name, type) && type == collision_detection::AllowedCollision::ALWAYS)
+      {
+        object_allowed.insert(name);
+      }
+    }
+  }
+  return updateObjects(world, allowed, body_names.size());
+}
+
+std::size_t WorldDistanceField::updateObjects(const collision_detection::World& world,
+                                              const std::map<std::string, std::set<std::string>>& allowed,
+                                              std::size_t body_count)
+{
+  static const std::set<std::string> NONE_ALLOWED;
+  const auto allowed_bodies = [&](const std::string& id) -> const std::set<std::string>& {
+    const auto it = allowed.find(id);
+    return it != allowed.end() ? it->second : NONE_ALLOWED;
+  };
+
+  // Remove the objects that no longer exist, were modified or whose allowed collisions changed.
+  std::size_t changes = 0;
+  for (const std::unique_ptr<Field>& field : fields_)
+  {
+    std::vector<collision_detection::World::ObjectConstPtr> removed;
+    for (auto it = field->objects.begin(); it != field->objects.end();)
+    {
+      const auto current = world.find(it->first);
+      if (current == world.end() || current->second != it->second || allowed_bodies(it->first) != field->allowed)
+      {
+        removed.push_back(it->second);
+        it = field->objects.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    changes += removed.size();
+    if (field->objects.empty())
+    {
+      field->distance_field->reset();
+    }
+    else
+    {
+      removeObjects(*field, removed);
+    }
+  }
+  // Only the field of the objects that no robot body may collide with is kept when it is empty.
+  fields_.erase(std::remove_if(fields_.begin() + 1, fields_.end(),
+                               [](const std::unique_ptr<Field>& field) { return field->objects.empty(); }),
+                fields_.end());
+
+  // Add the new, modified and moved objects.
+  for (const auto& [id, object] : world)
+  {
+    const std::set<std::string>& object_allowed = allowed_bodies(id);
+    if (body_count > 0 && object_allowed.size() == body_count)
+    {
+      continue;
+    }
+    auto field = std::find_if(fields_.begin(), fields_.end(), [&](const std::unique_ptr<Field>& candidate) {
+      return candidate->allowed == object_allowed;
+    });
+    if (field != fields_.end() && (*field)->objects.count(id))
+    {
+      continue;
+    }
+    if (field == fields_.end())
+    {
+      field = fields_.insert(fields_.end(), makeField(object_allowed));
+    }
+    addObject(**field, *object);
+    (*field)->objects.emplace(id, object);
+    ++changes;
+  }
+
+  return changes;
+}
+
+double WorldDistanceField::distance(const moveit::core::RobotState& state,
+                                    const std::map<std::string, double>& link_padding)
+{
+  const auto padding = [&link_padding](const std::string& link) {
+    const auto it = link_padding.find(link);
+    return it != link_padding.end() ? it->second : 0.0;
+  };
+
+  double min_distance = max_distance_;
+  for (LinkSpheres& link_spheres : link_spheres_)
+  {
+    const std::string& name = link_spheres.link->getName();
+    link_spheres.spheres->updatePose(state.getGlobalLinkTransform(link_spheres.link));
+    min_distance = distance(name, *link_spheres.spheres, padding(name), min_distance);
+  }
+
+  // Reuse the decompositions of the bodies that are still attached with the same shapes.
+  std::vector<const moveit::core::AttachedBody*> attached_bodies;
+  state.getAttachedBodies(attached_bodies);
+  std::map<std::string, AttachedBodySpheres> attached_body_spheres;
+  for (const moveit::core::AttachedBody* body : attached_bodies)
+  {
+    const auto previous = attached_body_spheres_.find(body->getName());
+    const bool unchanged =
+        previous != attached_body_spheres_.end() && previous->second.shapes == body->getShapes() &&
+        std::equal(previous->second.shape_poses.begin(), previous->second.shape_poses.end(),
+                   body->getShapePosesInLinkFrame().begin(), body->getShapePosesInLinkFrame().end(),
+                   [](const Eigen::Isometry3d& a, const Eigen::Isometry3d& b) { return a.isApprox(b); });
+    AttachedBodySpheres& body_spheres = attached_body_spheres[body->getName()];
+    if (unchanged)
+    {
+      body_spheres = std::move(previous->second);
+    }
+    else
+    {
+      body_spheres.shapes = body->getShapes();
+      body_spheres.shape_poses = body->getShapePosesInLinkFrame();
+      const auto decomposition = std::make_shared<const collision_detection::BodyDecomposition>(
+          body_spheres.shapes, body_spheres.shape_poses, resolution_, 0.0);
+      body_spheres.spheres = std::make_shared<collision_detection::PosedBodySphereDecomposition>(decomposition);
+    }
+    body_spheres.spheres->updatePose(state.getGlobalLinkTransform(body->getAttachedLink()));
+    min_distance =
+        distance(body->getName(), *body_spheres.spheres, padding(body->getAttachedLinkName()), min_distance);
+  }
+  attached_body_spheres_ = std::move(attached_body_spheres);
+
+  return min_distance;
+}
+
+double WorldDistanceField::distance(const std::string& name,
+                                    const collision_detection::PosedBodySphereDecomposition& spheres, double padding,
+                                    double min_distance) const
+{
+  const EigenSTL::vector_Vector3d& centers = spheres.getSphereCenters();
+  const std::vector<double>& radii = spheres.getSphereRadii();
+  for (const std::unique_ptr<Field>& field : fields_)
+  {
+    if (field->allowed.count(name))
+    {
+      continue;
+    }
+    for (std::size_t i = 0; i < centers.size(); ++i)
+    {
+      const double distance =
+          field->distance_field->getDistance(centers[i].x(), centers[i].y(), centers[i].z()) - radii[i] - padding;
+      min_distance = std::min(min_distance, distance);
+    }
+  }
+  return min_distance;
+}
+
+void WorldDistanceField::clear()
+{
+  fields_.resize(1);
+  fields_.front()->distance_field->reset();
+  fields_.front()->objects.clear();
+}
+
+void WorldDistanceField::addObject(Field& field, const collision_detection::World::Object& object)
+{
+  for (std::size_t i = 0; i < object.shapes_.size(); ++i)
+  {
+    field.distance_field->addShapeToField(object.shapes_[i].get(), object.global_shape_poses_[i]);
+  }
+}
+
+void WorldDistanceField::removeObjects(Field& field,
+                                       const std::vector<collision_detection::World::ObjectConstPtr>& objects)
+{
+  const distance_field::PropagationDistanceField& grid = *field.distance_field;
+  const auto cell = [&grid](const Eigen::Vector3d& point) {
+    int x, y, z;
+    grid.worldToGrid(point.x(), point.y(), point.z(), x, y, z);
+    return std::make_tuple(x, y, z);
+  };
+
+  // Collect the voxels occupied by the removed objects.
+  EigenSTL::vector_Vector3d points, shape_points;
+  std::set<std::tuple<int, int, int>> cells;
+  Eigen::AlignedBox3d bounds;
+  for (const collision_detection::World::ObjectConstPtr& object : objects)
+  {
+    for (std::size_t i = 0; i < object->shapes_.size(); ++i)
+    {
+      shape_points.clear();
+      grid.getShapePoints(object->shapes_[i].get(), object->global_shape_poses_[i], &shape_points);
+      for (const Eigen::Vector3d& point : shape_points)
+      {
+        if (cells.insert(cell(point)).second)
+        {
+          points.push_back(point);
+          bounds.extend(point);
+        }
+      }
+    }
+  }
+  if (points.empty())
+  {
+    return;
+  }
+
+  // Voxels that one of the remaining objects occupies as well stay in the field. Only objects whose bounding sphere
+  // reaches the removed voxels need to be decomposed.
+  bounds.min() -= Eigen::Vector3d::Constant(resolution_);
+  bounds.max() += Eigen::Vector3d::Constant(resolution_);
+  std::set<std::tuple<int, int, int>> kept;
+  for (const auto& [id, object] : field.objects)
+  {
+    for (std::size_t i = 0; i < object->shapes_.size(); ++i)
+    {
+      const shapes::Shape* shape = object->shapes_[i].get();
+      Eigen::Vector3d center;
+      double radius;
+      shapes::computeShapeBoundingSphere(shape, center, radius);
+      if (shape->type != shapes::OCTREE && bounds.exteriorDistance(object->global_shape_poses_[i] * center) > radius)
+      {
+        continue;
+      }
+      shape_points.clear();
+      grid.getShapePoints(object->shapes_[i].get(), object->global_shape_poses_[i], &shape_points);
+      for (const Eigen::Vector3d& point : shape_points)
+      {
+        const auto key = cell(point);
+        if (cells.count(key))
+        {
+          kept.insert(key);
+        }
+      }
+    }
+  }
+  if (!kept.empty())
+  {
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [&](const Eigen::Vector3d& point) { return kept.count(cell(point)) > 0; }),
+                 points.end());
+  }
+
+  field.distance_field->removePointsFromField(points);
+}
+
+}  // namespace moveit_servo
@@ -41,6 +41,48 @@
 
 #include "servo_cpp_fixture.hpp"
 
+#include <atomic>
+
+#ifdef __GLIBC__
+// Count the heap allocations made by the calling thread while counting is enabled. Interposing malloc also catches
+// allocations that bypass operator new, e.g. by Eigen and RobotState.
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+namespace
+{
+thread_local bool count_allocations = false;
+std::atomic<size_t> allocation_count = 0;
+
+void recordAllocation()
+{
+  if (count_allocations)
+  {
+    ++allocation_count;
+  }
+}
+}  // namespace
+
+extern "C" void* malloc(size_t size)
+{
+  recordAllocation();
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+  recordAllocation();
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+  recordAllocation();
+  return __libc_realloc(ptr, size);
+}
+#endif
+
 namespace
 {
 
@@ -68,6 +110,66 @@ TEST_F(ServoCppFixture, JointJogTest)
   ASSERT_NEAR(delta, 0.02, tol);
 }
 
+TEST_F(ServoCppFixture, SubgroupCommandsTest)
+{
+  moveit_servo::JointJogCommand joint_jog_z{ { "panda_joint7" }, { 1.0 } };
+  servo_test_instance_->setCommandType(moveit_servo::CommandType::JOINT_JOG);
+
+  moveit_servo::KinematicState curr_state = servo_test_instance_->getNextJointState(moveit_servo::JointJogCommand());
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+
+  // A command for the whole move group given as a subgroup command moves the robot like a plain command.
+  moveit_servo::KinematicState next_state;
+  servo_test_instance_->getNextJointState({ { "panda_arm", joint_jog_z, "" } }, next_state);
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  constexpr double tol = 0.00001;
+  ASSERT_NEAR(next_state.positions[6] - curr_state.positions[6], 0.02, tol);
+
+  // Groups that are not part of the move group are rejected and the robot does not move.
+  servo_test_instance_->getNextJointState({ { "hand", joint_jog_z, "" } }, next_state);
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::INVALID);
+}
+
+TEST_F(ServoCppFixture, ConcurrentSubgroupCommandsTest)
+{
+  // Servo the composite group of arm and hand, so that both subgroups can be commanded at once.
+  const std::string servo_param_namespace = "moveit_servo_test";
+  auto node = std::make_shared<rclcpp::Node>(
+      "moveit_servo_composite_test",
+      rclcpp::NodeOptions().parameter_overrides({ { servo_param_namespace + ".move_group_name", "panda_arm_hand" } }));
+  auto param_listener = std::make_shared<servo::ParamListener>(node, servo_param_namespace);
+  auto planning_scene_monitor = moveit_servo::createPlanningSceneMonitor(node, param_listener->get_params());
+  moveit_servo::Servo servo(node, param_listener, planning_scene_monitor);
+  servo.setCommandType(moveit_servo::CommandType::JOINT_JOG);
+
+  const moveit_servo::KinematicState curr_state = servo.getNextJointState(moveit_servo::JointJogCommand());
+  ASSERT_EQ(servo.getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  const auto joint_index = [&curr_state](const std::string& joint_name) {
+    return static_cast<std::size_t>(
+        std::find(curr_state.joint_names.begin(), curr_state.joint_names.end(), joint_name) -
+        curr_state.joint_names.begin());
+  };
+  const auto arm_joint = joint_index("panda_joint7");
+  const auto finger_joint = joint_index("panda_finger_joint1");
+  ASSERT_LT(arm_joint, curr_state.joint_names.size());
+  ASSERT_LT(finger_joint, curr_state.joint_names.size());
+
+  // Both subgroups move in the same cycle.
+  const moveit_servo::JointJogCommand arm_jog{ { "panda_joint7" }, { 1.0 } };
+  const moveit_servo::JointJogCommand finger_jog{ { "panda_finger_joint1" }, { 1.0 } };
+  moveit_servo::KinematicState next_state;
+  servo.getNextJointState({ { "panda_arm", arm_jog, "" }, { "hand", finger_jog, "" } }, next_state);
+  ASSERT_EQ(servo.getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  EXPECT_GT(next_state.positions[arm_joint] - curr_state.positions[arm_joint], 0.0);
+  EXPECT_GT(next_state.positions[finger_joint] - curr_state.positions[finger_joint], 0.0);
+
+  // Subgroups that share joints would add up their deltas, so they are rejected.
+  servo.getNextJointState({ { "panda_arm", arm_jog, "" }, { "panda_arm", arm_jog, "" } }, next_state);
+  EXPECT_EQ(servo.getStatus(), moveit_servo::StatusCode::INVALID);
+  servo.getNextJointState({ { "panda_arm", arm_jog, "" }, { "panda_arm_hand", arm_jog, "" } }, next_state);
+  EXPECT_EQ(servo.getStatus(), moveit_servo::StatusCode::INVALID);
+}
+
 TEST_F(ServoCppFixture, TwistTest)
 {
   moveit_servo::StatusCode status_curr, status_next, status_initial;
@@ -92,6 +194,40 @@ TEST_F(ServoCppFixture, TwistTest)
   ASSERT_NEAR(delta, expected_delta, tol);
 }
 
+TEST_F(ServoCppFixture, StageTimingsTest)
+{
+  moveit_servo::TwistCommand twist{ servo_params_.planning_frame, { 0.0, 0.0, 0.1, 0.0, 0.0, 0.0 } };
+  servo_test_instance_->setCommandType(moveit_servo::CommandType::TWIST);
+
+  servo_test_instance_->resetStageTimings();
+  for (const moveit_servo::StageTiming& timing : servo_test_instance_->getStageTimings())
+  {
+    ASSERT_EQ(timing.count, 0u);
+  }
+
+  constexpr std::size_t num_commands = 3;
+  for (std::size_t i = 0; i < num_commands; ++i)
+  {
+    servo_test_instance_->getNextJointState(twist);
+    ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  }
+
+  // Every stage runs once per cycle for a valid command, smoothing is disabled in the test config.
+  const moveit_servo::StageTimings timings = servo_test_instance_->getStageTimings();
+  ASSERT_EQ(timings[static_cast<std::size_t>(moveit_servo::ServoStage::SMOOTHING)].count, 0u);
+  for (const moveit_servo::ServoStage stage :
+       { moveit_servo::ServoStage::STATE_UPDATE, moveit_servo::ServoStage::FRAME_CONVERSION,
+         moveit_servo::ServoStage::JOINT_DELTA, moveit_servo::ServoStage::SINGULARITY_SCALING,
+         moveit_servo::ServoStage::COLLISION_SCALING, moveit_servo::ServoStage::LIMIT_ENFORCEMENT })
+  {
+    const moveit_servo::StageTiming& timing = timings[static_cast<std::size_t>(stage)];
+    ASSERT_EQ(timing.count, num_commands);
+    ASSERT_GE(timing.total, 0.0);
+    ASSERT_LE(timing.last, timing.max);
+    ASSERT_LE(timing.max, timing.total);
+  }
+}
+
 TEST_F(ServoCppFixture, NonPlanningFrameTwistTest)
 {
   moveit_servo::StatusCode status_curr, status_next, status_initial;
@@ -146,6 +282,38 @@ TEST_F(ServoCppFixture, PoseTest)
   ASSERT_NEAR(delta, expected_delta, tol);
 }
 
+TEST_F(ServoCppFixture, JointJogDoesNotAllocate)
+{
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Counting heap allocations requires glibc";
+#else
+  moveit_servo::JointJogCommand joint_jog{ { "panda_joint7" }, { 0.1 } };
+  // Construct the variant up front, converting the command on every call would copy it.
+  const moveit_servo::ServoInput command = joint_jog;
+  moveit_servo::KinematicState next_state;
+
+  servo_test_instance_->setCommandType(moveit_servo::CommandType::JOINT_JOG);
+
+  // Warm up, this sizes the output state and the internal buffers.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    servo_test_instance_->getNextJointState(command, next_state);
+  }
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+
+  allocation_count = 0;
+  count_allocations = true;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    servo_test_instance_->getNextJointState(command, next_state);
+  }
+  count_allocations = false;
+
+  EXPECT_EQ(allocation_count, 0u);
+  EXPECT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+#endif
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
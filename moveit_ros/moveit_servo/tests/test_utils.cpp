@@ -43,8 +43,12 @@
 #include <moveit_servo/servo.hpp>
 #include <moveit_servo/utils/common.hpp>
 #include <moveit_servo/utils/datatypes.hpp>
+#include <moveit_servo/utils/spsc_queue.hpp>
+#include <moveit_servo/world_distance_field.hpp>
+#include <geometric_shapes/shapes.h>
 #include <moveit/utils/robot_model_test_utils.h>
 #include <tf2_eigen/tf2_eigen.hpp>
+#include <thread>
 
 namespace
 {
@@ -168,6 +172,27 @@ TEST(ServoUtilsUnitTests, ApproachingSingularityScaling)
   ASSERT_EQ(scaling_result.second, moveit_servo::StatusCode::DECELERATE_FOR_APPROACHING_SINGULARITY);
 }
 
+TEST(ServoUtilsUnitTests, SubgroupSingularityScaling)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+  robot_state->setToDefaultValues();
+
+  // The composite group of arm and hand is not a chain, the Jacobian of the commanded subgroup is used instead.
+  servo::Params servo_params;
+  servo_params.move_group_name = "panda_arm_hand";
+  servo_params.active_subgroup = "panda_arm";
+  const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup("panda_arm");
+
+  Eigen::Vector<double, 6> cartesian_delta{ 0.005, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  Eigen::Vector<double, 7> state_approaching_singularity{ 0.0, 0.334, 0.0, -1.177, 0.0, 1.510, 0.785 };
+  robot_state->setJointGroupActivePositions(joint_model_group, state_approaching_singularity);
+  const auto scaling_result =
+      moveit_servo::velocityScalingFactorForSingularity(robot_state, cartesian_delta, servo_params);
+  ASSERT_EQ(scaling_result.second, moveit_servo::StatusCode::DECELERATE_FOR_APPROACHING_SINGULARITY);
+}
+
 TEST(ServoUtilsUnitTests, HaltForSingularityScaling)
 {
   using moveit::core::loadTestingRobotModel;
@@ -222,6 +247,408 @@ TEST(ServoUtilsUnitTests, LeavingSingularityScaling)
   ASSERT_EQ(scaling_result.second, moveit_servo::StatusCode::DECELERATE_FOR_LEAVING_SINGULARITY);
 }
 
+TEST(ServoUtilsUnitTests, CachedSingularityDirection)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+
+  servo::Params servo_params;
+  servo_params.move_group_name = "panda_arm";
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state->getJointModelGroup(servo_params.move_group_name);
+  robot_state->setToDefaultValues();
+
+  // Move from the ready state into the singularity, and back out of it.
+  const Eigen::Vector<double, 7> state_ready{ 0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785 };
+  const Eigen::Vector<double, 7> singular_state{ -0.0001, 0.5690, 0.0005, -0.7782, 0.0, 1.3453, 0.7845 };
+  const Eigen::Vector<double, 6> cartesian_delta{ 0.005, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+  moveit_servo::SingularityDirectionCache cache;
+  constexpr int num_steps = 200;
+  for (int i = 0; i <= 2 * num_steps; ++i)
+  {
+    const double fraction = 1.0 - std::abs(static_cast<double>(i - num_steps)) / num_steps;
+    const Eigen::VectorXd joint_positions = state_ready + fraction * (singular_state - state_ready);
+    robot_state->setJointGroupActivePositions(joint_model_group, joint_positions);
+
+    // The cached direction gives the same scaling as resolving it from scratch.
+    const auto expected = moveit_servo::velocityScalingFactorForSingularity(robot_state, cartesian_delta, servo_params);
+    const auto cached =
+        moveit_servo::velocityScalingFactorForSingularity(robot_state, cartesian_delta, servo_params, cache);
+    ASSERT_EQ(cached.second, expected.second) << "step " << i;
+    ASSERT_NEAR(cached.first, expected.first, 1e-9) << "step " << i;
+
+    // The robot state is left unchanged.
+    Eigen::VectorXd positions_after;
+    robot_state->copyJointGroupPositions(joint_model_group, positions_after);
+    ASSERT_TRUE(positions_after.isApprox(joint_positions));
+  }
+}
+
+TEST(ServoUtilsUnitTests, SingularityDirectionCachePerSubgroup)
+{
+  // Two 6R arms on a common base, servoed in turn like subgroups of one move group.
+  moveit::core::RobotModelBuilder builder("two_arms", "base");
+  const std::vector<urdf::Vector3> axes{ urdf::Vector3(0, 0, 1), urdf::Vector3(0, 1, 0), urdf::Vector3(0, 1, 0),
+                                         urdf::Vector3(0, 0, 1), urdf::Vector3(0, 1, 0), urdf::Vector3(0, 0, 1) };
+  const std::vector<double> offsets{ 0.1, 0.1, 0.3, 0.3, 0.1, 0.1 };
+  for (const auto& [arm, y] : { std::make_pair(std::string("left"), 0.5), std::make_pair(std::string("right"), -0.5) })
+  {
+    std::string parent = "base";
+    for (std::size_t i = 0; i < axes.size(); ++i)
+    {
+      geometry_msgs::msg::Pose origin;
+      origin.position.y = i == 0 ? y : 0.0;
+      origin.position.z = offsets[i];
+      origin.orientation.w = 1.0;
+      const std::string link = arm + "_link" + std::to_string(i + 1);
+      builder.addChain(parent + "->" + link, "continuous", { origin }, axes[i]);
+      parent = link;
+    }
+    builder.addGroupChain("base", parent, arm + "_arm");
+  }
+  ASSERT_TRUE(builder.isValid());
+  moveit::core::RobotModelPtr robot_model = builder.build();
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+  robot_state->setToDefaultValues();
+
+  servo::Params servo_params;
+  servo_params.move_group_name = "both_arms";
+  const Eigen::Vector<double, 6> arm_positions{ 0.0, 0.8, -1.0, 0.3, 0.6, 0.2 };
+  const Eigen::Vector<double, 6> cartesian_delta{ 0.005, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+  const std::vector<std::string> subgroups{ "left_arm", "right_arm" };
+  moveit_servo::SingularityDirectionCaches caches;
+  constexpr int num_steps = 10;
+  for (int i = 0; i < num_steps; ++i)
+  {
+    for (const std::string& subgroup : subgroups)
+    {
+      // Move slightly, staying within the reuse distance of the first cycle.
+      const Eigen::VectorXd joint_positions = (arm_positions.array() + 0.001 * i).matrix();
+      robot_state->setJointGroupActivePositions(subgroup, joint_positions);
+      servo_params.active_subgroup = subgroup;
+      Eigen::VectorXd joint_position_delta = Eigen::VectorXd::Zero(6);
+      moveit_servo::scaleForSingularity(cartesian_delta, robot_state, servo_params, caches, joint_position_delta);
+
+      // The direction resolved in the first cycle is reused, although the other subgroup was servoed in between.
+      const moveit_servo::SingularityDirectionCache& cache = caches.at(subgroup);
+      EXPECT_EQ(cache.group_name, subgroup);
+      ASSERT_EQ(cache.resolved_joint_positions.size(), arm_positions.size());
+      EXPECT_TRUE(cache.resolved_joint_positions.isApprox(arm_positions)) << subgroup << " step " << i;
+    }
+  }
+  EXPECT_EQ(caches.size(), subgroups.size());
+}
+
+TEST(ServoUtilsUnitTests, IterativePoseTracking)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+
+  servo::Params servo_params;
+  servo_params.move_group_name = "panda_arm";
+  servo_params.planning_frame = "panda_link0";
+  servo_params.ee_frame = "panda_link8";
+  servo_params.pose_tracking.max_iterations = 50;
+  servo_params.pose_tracking.time_budget = 1.0;
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state->getJointModelGroup(servo_params.move_group_name);
+  robot_state->setToDefaultValues();
+
+  const Eigen::Vector<double, 7> state_ready{ 0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785 };
+  robot_state->setJointGroupActivePositions(joint_model_group, state_ready);
+  moveit_servo::PoseCommand command{ servo_params.planning_frame,
+                                     robot_state->getGlobalLinkTransform(servo_params.ee_frame) };
+  command.pose.translation().x() += 0.02;
+  command.pose.rotate(Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitZ()));
+
+  const moveit_servo::JointNameToMoveGroupIndexMap joint_name_group_index_map;
+  moveit_servo::PoseTrackingState tracking_state;
+  auto delta_result = moveit_servo::jointDeltaFromPoseTracking(command, robot_state, servo_params,
+                                                               joint_name_group_index_map, tracking_state);
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::NO_WARNING);
+  EXPECT_TRUE(tracking_state.report.converged);
+  EXPECT_FALSE(tracking_state.report.warm_started);
+  EXPECT_GT(tracking_state.report.iterations, 0);
+  EXPECT_GT(tracking_state.report.latency, 0.0);
+
+  // The robot state is left unchanged, applying the delta reaches the pose.
+  Eigen::VectorXd positions;
+  robot_state->copyJointGroupPositions(joint_model_group, positions);
+  ASSERT_TRUE(positions.isApprox(state_ready));
+  robot_state->setJointGroupPositions(joint_model_group, positions + delta_result.second);
+  const Eigen::Isometry3d reached_pose = robot_state->getGlobalLinkTransform(servo_params.ee_frame);
+  EXPECT_LE((reached_pose.translation() - command.pose.translation()).norm(),
+            servo_params.pose_tracking.linear_tolerance);
+  EXPECT_LE(Eigen::AngleAxisd(reached_pose.linear().transpose() * command.pose.linear()).angle(),
+            servo_params.pose_tracking.angular_tolerance);
+
+  // Starting from the previous solution, the same target is reached without iterating.
+  robot_state->setJointGroupActivePositions(joint_model_group, state_ready);
+  delta_result = moveit_servo::jointDeltaFromPoseTracking(command, robot_state, servo_params,
+                                                          joint_name_group_index_map, tracking_state);
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::NO_WARNING);
+  EXPECT_TRUE(tracking_state.report.converged);
+  EXPECT_TRUE(tracking_state.report.warm_started);
+  EXPECT_EQ(tracking_state.report.iterations, 0);
+
+  // The number of iterations is bounded.
+  command.pose.translation().z() -= 0.1;
+  servo_params.pose_tracking.max_iterations = 1;
+  delta_result = moveit_servo::jointDeltaFromPoseTracking(command, robot_state, servo_params,
+                                                          joint_name_group_index_map, tracking_state);
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::NO_WARNING);
+  EXPECT_FALSE(tracking_state.report.converged);
+  EXPECT_EQ(tracking_state.report.iterations, 1);
+}
+
+TEST(ServoUtilsUnitTests, WorldDistanceField)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotState robot_state(robot_model);
+  robot_state.setToDefaultValues();
+  robot_state.updateLinkTransforms();
+
+  moveit_servo::WorldDistanceField distance_field(robot_model, Eigen::Vector3d::Constant(3.0),
+                                                  Eigen::Vector3d::Constant(-1.5), 0.02, 0.5);
+  collision_detection::World world;
+
+  // Without obstacles every link sphere is at the maximum distance.
+  ASSERT_EQ(distance_field.update(world), 0u);
+  const double free_distance = distance_field.distance(robot_state);
+
+  // Place a box next to the end effector.
+  Eigen::Isometry3d box_pose = robot_state.getGlobalLinkTransform("panda_link8");
+  box_pose.translation().x() += 0.2;
+  world.addToObject("box", std::make_shared<const shapes::Box>(0.05, 0.05, 0.05), box_pose);
+  ASSERT_EQ(distance_field.update(world), 1u);
+  const double box_distance = distance_field.distance(robot_state);
+  EXPECT_LT(box_distance, free_distance);
+  EXPECT_GT(box_distance, 0.0);
+
+  // Unchanged objects are not updated again.
+  ASSERT_EQ(distance_field.update(world), 0u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), box_distance);
+
+  // Moving the box closer replaces it in the field.
+  world.moveObject("box", Eigen::Isometry3d(Eigen::Translation3d(-0.1, 0.0, 0.0)));
+  ASSERT_EQ(distance_field.update(world), 1u);
+  EXPECT_LT(distance_field.distance(robot_state), box_distance);
+
+  // Removing the box clears the field again.
+  world.removeObject("box");
+  ASSERT_EQ(distance_field.update(world), 1u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), free_distance);
+}
+
+TEST(ServoUtilsUnitTests, WorldDistanceFieldOverlappingObjects)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotState robot_state(robot_model);
+  robot_state.setToDefaultValues();
+  robot_state.updateLinkTransforms();
+
+  moveit_servo::WorldDistanceField distance_field(robot_model, Eigen::Vector3d::Constant(3.0),
+                                                  Eigen::Vector3d::Constant(-1.5), 0.02, 0.5);
+  collision_detection::World world;
+  distance_field.update(world);
+  const double free_distance = distance_field.distance(robot_state);
+
+  // Two boxes occupy the same space next to the end effector.
+  Eigen::Isometry3d box_pose = robot_state.getGlobalLinkTransform("panda_link8");
+  box_pose.translation().x() += 0.2;
+  world.addToObject("box", std::make_shared<const shapes::Box>(0.05, 0.05, 0.05), box_pose);
+  world.addToObject("larger_box", std::make_shared<const shapes::Box>(0.1, 0.1, 0.1), box_pose);
+  ASSERT_EQ(distance_field.update(world), 2u);
+  const double box_distance = distance_field.distance(robot_state);
+
+  // Removing the smaller box keeps the voxels the larger box still occupies.
+  world.removeObject("box");
+  ASSERT_EQ(distance_field.update(world), 1u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), box_distance);
+
+  world.removeObject("larger_box");
+  ASSERT_EQ(distance_field.update(world), 1u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), free_distance);
+}
+
+TEST(ServoUtilsUnitTests, WorldDistanceFieldAttachedBodies)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotState robot_state(robot_model);
+  robot_state.setToDefaultValues();
+  robot_state.updateLinkTransforms();
+
+  moveit_servo::WorldDistanceField distance_field(robot_model, Eigen::Vector3d::Constant(3.0),
+                                                  Eigen::Vector3d::Constant(-1.5), 0.02, 0.5);
+  collision_detection::World world;
+  const Eigen::Isometry3d& link_pose = robot_state.getGlobalLinkTransform("panda_link8");
+  Eigen::Isometry3d box_pose = link_pose;
+  box_pose.translation().x() += 0.2;
+  world.addToObject("box", std::make_shared<const shapes::Box>(0.05, 0.05, 0.05), box_pose);
+  distance_field.update(world);
+  const double box_distance = distance_field.distance(robot_state);
+  ASSERT_GT(box_distance, 0.0);
+
+  // A sphere attached to the end effector reaches into the box.
+  const Eigen::Isometry3d sphere_pose = link_pose.inverse() * box_pose;
+  robot_state.attachBody("sphere", sphere_pose, { std::make_shared<const shapes::Sphere>(0.05) },
+                         { Eigen::Isometry3d::Identity() }, std::set<std::string>(), "panda_link8");
+  EXPECT_LT(distance_field.distance(robot_state), 0.0);
+
+  // Detached bodies are not considered anymore.
+  robot_state.clearAttachedBody("sphere");
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), box_distance);
+}
+
+TEST(ServoUtilsUnitTests, WorldDistanceFieldAllowedCollisionsAndPadding)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotState robot_state(robot_model);
+  robot_state.setToDefaultValues();
+  robot_state.updateLinkTransforms();
+
+  moveit_servo::WorldDistanceField distance_field(robot_model, Eigen::Vector3d::Constant(3.0),
+                                                  Eigen::Vector3d::Constant(-1.5), 0.02, 0.5);
+  collision_detection::World world;
+  collision_detection::AllowedCollisionMatrix acm;
+  distance_field.update(world, acm, robot_state);
+  const double free_distance = distance_field.distance(robot_state);
+
+  Eigen::Isometry3d box_pose = robot_state.getGlobalLinkTransform("panda_link8");
+  box_pose.translation().x() += 0.2;
+  world.addToObject("box", std::make_shared<const shapes::Box>(0.05, 0.05, 0.05), box_pose);
+  ASSERT_EQ(distance_field.update(world, acm, robot_state), 1u);
+  const double box_distance = distance_field.distance(robot_state);
+  ASSERT_LT(box_distance, free_distance);
+
+  // Padding every link brings it closer to the box by the padding.
+  std::map<std::string, double> link_padding;
+  for (const moveit::core::LinkModel* link : robot_model->getLinkModelsWithCollisionGeometry())
+  {
+    link_padding[link->getName()] = 0.01;
+  }
+  EXPECT_NEAR(distance_field.distance(robot_state, link_padding), box_distance - 0.01, 1e-9);
+
+  // A box that every link may collide with is left out of the field.
+  acm.setDefaultEntry("box", true);
+  ASSERT_EQ(distance_field.update(world, acm, robot_state), 1u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), free_distance);
+
+  // Allowing a distant link to collide with the box keeps it an obstacle for the links next to it.
+  acm.setDefaultEntry("box", false);
+  acm.setEntry("box", "panda_link0", true);
+  ASSERT_EQ(distance_field.update(world, acm, robot_state), 1u);
+  EXPECT_DOUBLE_EQ(distance_field.distance(robot_state), box_distance);
+  ASSERT_EQ(distance_field.update(world, acm, robot_state), 0u);
+}
+
+TEST(ServoUtilsUnitTests, CollisionFreeHorizonFraction)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("panda");
+  moveit::core::RobotState predicted_state(robot_model);
+  predicted_state.setToDefaultValues();
+  const moveit::core::JointModelGroup* joint_model_group = robot_model->getJointModelGroup("panda_arm");
+
+  Eigen::VectorXd start_positions;
+  predicted_state.copyJointGroupPositions(joint_model_group, start_positions);
+  Eigen::VectorXd velocities = Eigen::VectorXd::Zero(start_positions.size());
+  velocities[0] = 1.0;
+
+  // Treat every state where the first joint moved more than 0.25 rad as colliding.
+  const double start = start_positions[0];
+  const auto is_colliding = [&](const moveit::core::RobotState& state) {
+    return state.getVariablePosition("panda_joint1") - start > 0.25;
+  };
+
+  // Samples at 0.1, 0.2, ..., 0.5 s, the first colliding one is at 0.3 s.
+  constexpr double tol = 1e-9;
+  EXPECT_NEAR(moveit_servo::collisionFreeHorizonFraction(predicted_state, joint_model_group, start_positions,
+                                                         velocities, 0.5, 5, is_colliding),
+              0.4, tol);
+
+  // A short horizon does not reach the collision.
+  EXPECT_NEAR(moveit_servo::collisionFreeHorizonFraction(predicted_state, joint_model_group, start_positions,
+                                                         velocities, 0.2, 5, is_colliding),
+              1.0, tol);
+
+  // A collision at the first sample halts.
+  velocities[0] = 10.0;
+  EXPECT_NEAR(moveit_servo::collisionFreeHorizonFraction(predicted_state, joint_model_group, start_positions,
+                                                         velocities, 0.5, 5, is_colliding),
+              0.0, tol);
+}
+
+TEST(ServoUtilsUnitTests, SpscQueue)
+{
+  moveit_servo::SpscQueue<std::vector<int>, 4> queue;
+  std::vector<int> value;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.pop(value));
+
+  // The queue holds at most its capacity.
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.push({ i }));
+  }
+  EXPECT_FALSE(queue.push({ 4 }));
+
+  // Values come out in order.
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, std::vector<int>{ i });
+  }
+  EXPECT_TRUE(queue.empty());
+
+  // Only the newest value is kept when skipping older ones.
+  EXPECT_FALSE(queue.popLatest(value));
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(queue.push({ i }));
+  }
+  ASSERT_TRUE(queue.popLatest(value));
+  EXPECT_EQ(value, std::vector<int>{ 2 });
+  EXPECT_TRUE(queue.empty());
+
+  // All values pushed by a producer thread arrive in order at the consumer.
+  constexpr int count = 10000;
+  std::thread producer([&queue] {
+    for (int i = 0; i < count;)
+    {
+      if (queue.push({ i }))
+      {
+        ++i;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int expected = 0; expected < count;)
+  {
+    if (queue.pop(value))
+    {
+      ASSERT_EQ(value, std::vector<int>{ expected });
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
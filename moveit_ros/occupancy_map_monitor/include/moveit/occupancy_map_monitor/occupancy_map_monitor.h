@@ -44,10 +44,12 @@
 #include <rclcpp/rclcpp.hpp>
 #include <tf2_ros/buffer.h>
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -64,6 +66,7 @@ public:
     double map_resolution;
     std::string map_frame;
     std::vector<std::pair<std::string, std::string>> sensor_plugins;
+    double snapshot_rate = 0.0; /*!< Maximum rate [Hz] of published snapshots, 0 disables snapshots */
   };
 
   /**
@@ -179,6 +182,31 @@ public:
     return tree_const_;
   }
 
+  /** @brief Get the most recently published immutable copy of the octree. Snapshots are published at most at the
+   *  configured snapshot rate after the updaters changed the octree. No lock is needed to read a snapshot, the
+   *  updaters keep writing to the octree returned by getOcTreePtr() meanwhile.
+   *  @return The snapshot, or nullptr if snapshots are disabled */
+  collision_detection::OccMapTreeConstPtr getOcTreeSnapshot() const
+  {
+    return std::atomic_load(&snapshot_);
+  }
+
+  /**
+   * @brief      Determines if collision consumers should read the octree through snapshots.
+   *
+   * @return     True if snapshots are published, False otherwise.
+   */
+  bool hasSnapshots() const
+  {
+    return parameters_.snapshot_rate > 0.0;
+  }
+
+  /**
+   * @brief      Request a new snapshot of the octree, e.g. after modifying it outside of the updaters. Does nothing
+   *             if snapshots are disabled.
+   */
+  void requestSnapshot();
+
   /**
    * @brief      Gets the map frame (this is set either by the constor or a parameter).
    *
@@ -240,14 +268,12 @@ public:
   void forgetShape(ShapeHandle handle);
 
   /**
-   * @brief      Set the callback to trigger when updates to the maintained octomap are received
+   * @brief      Set the callback to trigger when updates to the maintained octomap are received. If snapshots are
+   *             enabled, the callback is called once a new snapshot is available instead.
    *
    * @param[in]  update_callback  The update callback function
    */
-  void setUpdateCallback(const std::function<void()>& update_callback)
-  {
-    tree_->setUpdateCallback(update_callback);
-  }
+  void setUpdateCallback(const std::function<void()>& update_callback);
 
   /**
    * @brief      Sets the transform cache callback.
@@ -313,6 +339,11 @@ private:
   bool getShapeTransformCache(std::size_t index, const std::string& target_frame, const rclcpp::Time& target_time,
                               ShapeTransformCache& cache) const;
 
+  /**
+   * @brief      Copies the octree into a new snapshot whenever one is requested, at most at the snapshot rate.
+   */
+  void snapshotThread();
+
   std::unique_ptr<MiddlewareHandle> middleware_handle_; /*!< The abstract interface to ros */
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;          /*!< TF buffer */
   Parameters parameters_;
@@ -321,6 +352,14 @@ private:
   collision_detection::OccMapTreePtr tree_;            /*!< Oct map tree */
   collision_detection::OccMapTreeConstPtr tree_const_; /*!< Shared pointer to a const oct map tree */
 
+  collision_detection::OccMapTreeConstPtr snapshot_; /*!< Latest immutable copy of the tree, swapped atomically */
+  std::function<void()> update_callback_;            /*!< Callback triggered when a new snapshot is published */
+  std::mutex snapshot_lock_;                         /*!< Mutex for synchronizing the snapshot requests */
+  std::condition_variable snapshot_condition_;       /*!< Signals snapshot requests and shutdown */
+  bool snapshot_requested_;                          /*!< True when the tree changed since the last snapshot */
+  bool stop_snapshots_;                              /*!< True when the snapshot thread should exit */
+  std::thread snapshot_thread_;                      /*!< Thread copying the tree into snapshots */
+
   std::vector<OccupancyMapUpdaterPtr> map_updaters_;             /*!< The Occupancy map updaters */
   std::vector<std::map<ShapeHandle, ShapeHandle>> mesh_handles_; /*!< The mesh handles */
   TransformCacheProvider transform_cache_callback_;              /*!< Callback for the transform cache */
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <octomap/OcTreeKey.h>
+#include <Eigen/Core>
+
+#include <cstdint>
+#include <vector>
+
+namespace occupancy_map_monitor
+{
+/** \brief Collapses the points of a sensor update that fall into the same leaf of an octree.
+
+    Dense sensors produce many points per leaf. Adding the points to this grid first reduces them to one entry per leaf,
+    with the centroid of its points and the union of the flags they were added with, before the rays are cast.
+    The entries are kept in an open addressing hash table keyed by the octree keys, the storage is reused by the
+    following updates after clear(). */
+class VoxelGrid
+{
+public:
+  struct Voxel
+  {
+    octomap::OcTreeKey key;
+    Eigen::Vector3f sum;
+    unsigned int count;
+    unsigned int flags;
+
+    Eigen::Vector3f centroid() const
+    {
+      return sum / static_cast<float>(count);
+    }
+  };
+
+  VoxelGrid();
+
+  /** \brief Remove all voxels, keeping the allocated storage */
+  void clear();
+
+  /** \brief Add a point to the voxel of the leaf with key \e key.
+      \return true if the voxel did not exist before */
+  bool insert(const octomap::OcTreeKey& key, const Eigen::Vector3f& point, unsigned int flags = 0);
+
+  std::size_t size() const
+  {
+    return voxels_.size();
+  }
+
+  bool empty() const
+  {
+    return voxels_.empty();
+  }
+
+  /** \brief The voxels in the order of their insertion */
+  const std::vector<Voxel>& getVoxels() const
+  {
+    return voxels_;
+  }
+
+private:
+  void rehash(std::size_t buckets);
+
+  std::vector<Voxel> voxels_;
+  /* indices into voxels_ plus one, 0 marks empty buckets; the number of buckets is a power of two */
+  std::vector<std::uint32_t> buckets_;
+  std::uint64_t mask_;
+};
+}  // namespace occupancy_map_monitor
@@ -43,6 +43,7 @@
 #include <rclcpp/logger.hpp>
 #include <rclcpp/logging.hpp>
 #include <rclcpp/node.hpp>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -76,6 +77,8 @@ OccupancyMapMonitor::OccupancyMapMonitor(std::unique_ptr<MiddlewareHandle> middl
   , debug_info_{ false }
   , mesh_handle_count_{ 0 }
   , active_{ false }
+  , snapshot_requested_{ false }
+  , stop_snapshots_{ false }
 {
   if (middleware_handle_ == nullptr)
   {
@@ -99,6 +102,12 @@ OccupancyMapMonitor::OccupancyMapMonitor(std::unique_ptr<MiddlewareHandle> middl
 
   tree_ = std::make_shared<collision_detection::OccMapTree>(parameters_.map_resolution);
   tree_const_ = tree_;
+  if (hasSnapshots())
+  {
+    RCLCPP_DEBUG(LOGGER, "Publishing octomap snapshots at up to %lf Hz", parameters_.snapshot_rate);
+    snapshot_ = std::make_shared<const collision_detection::OccMapTree>(*tree_);
+    tree_->setUpdateCallback([this] { requestSnapshot(); });
+  }
 
   for (const auto& [sensor_name, sensor_type] : parameters_.sensor_plugins)
   {
@@ -143,6 +152,9 @@ OccupancyMapMonitor::OccupancyMapMonitor(std::unique_ptr<MiddlewareHandle> middl
 
   middleware_handle_->createSaveMapService(save_map_service_callback);
   middleware_handle_->createLoadMapService(load_map_service_callback);
+
+  if (hasSnapshots())
+    snapshot_thread_ = std::thread([this] { snapshotThread(); });
 }
 
 void OccupancyMapMonitor::addUpdater(const OccupancyMapUpdaterPtr& updater)
@@ -233,6 +245,61 @@ void OccupancyMapMonitor::forgetShape(ShapeHandle handle)
   }
 }
 
+void OccupancyMapMonitor::setUpdateCallback(const std::function<void()>& update_callback)
+{
+  if (!hasSnapshots())
+  {
+    tree_->setUpdateCallback(update_callback);
+    return;
+  }
+  std::lock_guard<std::mutex> _(snapshot_lock_);
+  update_callback_ = update_callback;
+}
+
+void OccupancyMapMonitor::requestSnapshot()
+{
+  if (!hasSnapshots())
+    return;
+  {
+    std::lock_guard<std::mutex> _(snapshot_lock_);
+    snapshot_requested_ = true;
+  }
+  snapshot_condition_.notify_one();
+}
+
+void OccupancyMapMonitor::snapshotThread()
+{
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / parameters_.snapshot_rate));
+  std::chrono::steady_clock::time_point last_snapshot;
+
+  std::unique_lock<std::mutex> lock(snapshot_lock_);
+  while (true)
+  {
+    snapshot_condition_.wait(lock, [this] { return snapshot_requested_ || stop_snapshots_; });
+    // limit the rate, all requests received meanwhile are served by the same snapshot
+    snapshot_condition_.wait_until(lock, last_snapshot + period, [this] { return stop_snapshots_; });
+    if (stop_snapshots_)
+      break;
+    snapshot_requested_ = false;
+    const std::function<void()> update_callback = update_callback_;
+    lock.unlock();
+
+    // the updaters are only blocked while copying, readers of the previous snapshot are never blocked
+    collision_detection::OccMapTreeConstPtr snapshot;
+    {
+      collision_detection::OccMapTree::ReadLock tree_lock = tree_->reading();
+      snapshot = std::make_shared<const collision_detection::OccMapTree>(*tree_);
+    }
+    std::atomic_store(&snapshot_, snapshot);
+    last_snapshot = std::chrono::steady_clock::now();
+
+    if (update_callback)
+      update_callback();
+    lock.lock();
+  }
+}
+
 void OccupancyMapMonitor::setTransformCacheCallback(const TransformCacheProvider& transform_callback)
 {
   // if we have just one updater, we connect it directly to the transform provider
@@ -339,5 +406,16 @@ void OccupancyMapMonitor::stopMonitor()
 OccupancyMapMonitor::~OccupancyMapMonitor()
 {
   stopMonitor();
+  if (snapshot_thread_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> _(snapshot_lock_);
+      stop_snapshots_ = true;
+    }
+    snapshot_condition_.notify_one();
+    snapshot_thread_.join();
+    // the tree may outlive the monitor
+    tree_->setUpdateCallback(std::function<void()>());
+  }
 }
 }  // namespace occupancy_map_monitor
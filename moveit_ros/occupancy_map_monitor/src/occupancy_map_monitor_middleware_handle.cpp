@@ -88,6 +88,9 @@ OccupancyMapMonitorMiddlewareHandle::OccupancyMapMonitorMiddlewareHandle(const r
     }
   }
 
+  // optional, collision consumers read the live octree if snapshots are disabled
+  node_->get_parameter("octomap_snapshot_rate", parameters_.snapshot_rate);
+
   std::vector<std::string> sensor_names;
   if (!node_->get_parameter("sensors", sensor_names))
   {
@@ -0,0 +1,104 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/occupancy_map_monitor/voxel_grid.h>
+
+#include <algorithm>
+
+namespace occupancy_map_monitor
+{
+namespace
+{
+constexpr std::size_t MIN_BUCKETS = 1024;
+
+std::uint64_t hashKey(const octomap::OcTreeKey& key)
+{
+  const std::uint64_t value = static_cast<std::uint64_t>(key[0]) | (static_cast<std::uint64_t>(key[1]) << 16) |
+                              (static_cast<std::uint64_t>(key[2]) << 32);
+  // Fibonacci hashing, the high bits are well mixed
+  return (value * 0x9e3779b97f4a7c15ULL) >> 32;
+}
+}  // namespace
+
+VoxelGrid::VoxelGrid() : buckets_(MIN_BUCKETS, 0), mask_(MIN_BUCKETS - 1)
+{
+}
+
+void VoxelGrid::clear()
+{
+  if (voxels_.empty())
+    return;
+  voxels_.clear();
+  std::fill(buckets_.begin(), buckets_.end(), 0);
+}
+
+bool VoxelGrid::insert(const octomap::OcTreeKey& key, const Eigen::Vector3f& point, unsigned int flags)
+{
+  // keep the load factor below one half
+  if (2 * (voxels_.size() + 1) > buckets_.size())
+    rehash(2 * buckets_.size());
+
+  for (std::uint64_t bucket = hashKey(key) & mask_;; bucket = (bucket + 1) & mask_)
+  {
+    const std::uint32_t index = buckets_[bucket];
+    if (index == 0)
+    {
+      voxels_.push_back(Voxel{ key, point, 1, flags });
+      buckets_[bucket] = static_cast<std::uint32_t>(voxels_.size());
+      return true;
+    }
+    Voxel& voxel = voxels_[index - 1];
+    if (voxel.key == key)
+    {
+      voxel.sum += point;
+      ++voxel.count;
+      voxel.flags |= flags;
+      return false;
+    }
+  }
+}
+
+void VoxelGrid::rehash(std::size_t buckets)
+{
+  buckets_.assign(buckets, 0);
+  mask_ = buckets - 1;
+  for (std::size_t i = 0; i < voxels_.size(); ++i)
+  {
+    std::uint64_t bucket = hashKey(voxels_[i].key) & mask_;
+    while (buckets_[bucket] != 0)
+      bucket = (bucket + 1) & mask_;
+    buckets_[bucket] = static_cast<std::uint32_t>(i + 1);
+  }
+}
+}  // namespace occupancy_map_monitor
@@ -40,6 +40,8 @@
 #include <gtest/gtest.h>
 #include <tf2_ros/buffer.h>
 
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -77,6 +79,49 @@ TEST(OccupancyMapMonitorTests, ConstructorTest)
   };
 }
 
+TEST(OccupancyMapMonitorTests, SnapshotTest)
+{
+  // GIVEN a mocked middleware handle that enables snapshots
+  auto mock_middleware_handle = std::make_unique<MockMiddlewareHandle>();
+  occupancy_map_monitor::OccupancyMapMonitor::Parameters parameters{ 0.1, "", {} };
+  parameters.snapshot_rate = 100.0;
+  EXPECT_CALL(*mock_middleware_handle, getParameters).WillOnce(::testing::Return(parameters));
+
+  // WHEN we construct the occupancy map monitor
+  occupancy_map_monitor::OccupancyMapMonitor occupancy_map_monitor{
+    std::move(mock_middleware_handle), std::make_shared<tf2_ros::Buffer>(std::make_shared<rclcpp::Clock>())
+  };
+
+  // THEN an empty snapshot separate from the live tree is available
+  ASSERT_TRUE(occupancy_map_monitor.hasSnapshots());
+  const collision_detection::OccMapTreeConstPtr initial = occupancy_map_monitor.getOcTreeSnapshot();
+  ASSERT_NE(initial, nullptr);
+  EXPECT_NE(initial, occupancy_map_monitor.getOcTreePtr());
+  EXPECT_EQ(initial->size(), 0u);
+
+  // WHEN the live tree is updated
+  std::promise<void> published;
+  occupancy_map_monitor.setUpdateCallback([&published] { published.set_value(); });
+  const collision_detection::OccMapTreePtr& tree = occupancy_map_monitor.getOcTreePtr();
+  tree->lockWrite();
+  tree->updateNode(octomap::point3d(0.5, 0.5, 0.5), true);
+  tree->unlockWrite();
+  tree->triggerUpdateCallback();
+
+  // THEN a new snapshot containing the update is published
+  ASSERT_EQ(published.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  const collision_detection::OccMapTreeConstPtr snapshot = occupancy_map_monitor.getOcTreeSnapshot();
+  EXPECT_NE(snapshot, initial);
+  EXPECT_EQ(initial->size(), 0u);
+  ASSERT_NE(snapshot->search(octomap::point3d(0.5, 0.5, 0.5)), nullptr);
+
+  // WHEN the live tree is cleared, THEN the published snapshot is left untouched
+  tree->lockWrite();
+  tree->clear();
+  tree->unlockWrite();
+  EXPECT_NE(snapshot->search(octomap::point3d(0.5, 0.5, 0.5)), nullptr);
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
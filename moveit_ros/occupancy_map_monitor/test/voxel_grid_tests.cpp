@@ -0,0 +1,112 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/occupancy_map_monitor/voxel_grid.h>
+
+#include <gtest/gtest.h>
+#include <octomap/OcTree.h>
+
+#include <map>
+#include <random>
+#include <tuple>
+
+namespace
+{
+struct ExpectedVoxel
+{
+  Eigen::Vector3f sum = Eigen::Vector3f::Zero();
+  unsigned int count = 0;
+  unsigned int flags = 0;
+};
+}  // namespace
+
+TEST(VoxelGridTests, CollapsesPointsPerLeaf)
+{
+  // GIVEN random points and an octree with a resolution coarser than their spacing
+  const octomap::OcTree tree(0.05);
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  // WHEN the points are added to the grid
+  occupancy_map_monitor::VoxelGrid grid;
+  std::map<std::tuple<int, int, int>, ExpectedVoxel> expected;
+  for (unsigned int i = 0; i < 100000; ++i)
+  {
+    const Eigen::Vector3f point(distribution(generator), distribution(generator), distribution(generator));
+    const octomap::OcTreeKey key = tree.coordToKey(point.x(), point.y(), point.z());
+    const unsigned int flags = 1 << (i % 3);
+
+    ExpectedVoxel& voxel = expected[std::make_tuple(key[0], key[1], key[2])];
+    EXPECT_EQ(grid.insert(key, point, flags), voxel.count == 0);
+    voxel.sum += point;
+    ++voxel.count;
+    voxel.flags |= flags;
+  }
+
+  // THEN there is one voxel per leaf with the centroid and the flags of the points in the leaf
+  ASSERT_EQ(grid.size(), expected.size());
+  for (const occupancy_map_monitor::VoxelGrid::Voxel& voxel : grid.getVoxels())
+  {
+    const ExpectedVoxel& expected_voxel = expected.at(std::make_tuple(voxel.key[0], voxel.key[1], voxel.key[2]));
+    EXPECT_EQ(voxel.count, expected_voxel.count);
+    EXPECT_EQ(voxel.flags, expected_voxel.flags);
+    EXPECT_TRUE(voxel.centroid().isApprox(expected_voxel.sum / expected_voxel.count, 1e-5f));
+  }
+}
+
+TEST(VoxelGridTests, ClearKeepsNoVoxels)
+{
+  // GIVEN a grid with points in one leaf
+  const octomap::OcTree tree(0.1);
+  occupancy_map_monitor::VoxelGrid grid;
+  EXPECT_TRUE(grid.insert(tree.coordToKey(0.01, 0.01, 0.01), Eigen::Vector3f::Constant(0.01f)));
+  EXPECT_FALSE(grid.insert(tree.coordToKey(0.02, 0.02, 0.02), Eigen::Vector3f::Constant(0.02f)));
+  EXPECT_EQ(grid.size(), 1u);
+
+  // WHEN the grid is cleared
+  grid.clear();
+
+  // THEN the next point of the same leaf starts a new voxel
+  EXPECT_TRUE(grid.empty());
+  EXPECT_TRUE(grid.insert(tree.coordToKey(0.03, 0.03, 0.03), Eigen::Vector3f::Constant(0.03f)));
+  ASSERT_EQ(grid.size(), 1u);
+  EXPECT_EQ(grid.getVoxels()[0].count, 1u);
+  EXPECT_TRUE(grid.getVoxels()[0].centroid().isApprox(Eigen::Vector3f::Constant(0.03f)));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
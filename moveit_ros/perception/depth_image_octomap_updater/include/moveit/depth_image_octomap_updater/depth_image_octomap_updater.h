@@ -39,7 +39,9 @@
 #include <rclcpp/rclcpp.hpp>
 #include <tf2_ros/buffer.h>
 #include <moveit/occupancy_map_monitor/occupancy_map_updater.h>
+#include <moveit/occupancy_map_monitor/voxel_grid.h>
 #include <moveit/mesh_filter/mesh_filter.h>
+#include <moveit/mesh_filter/software_mesh_filter.h>
 #include <moveit/mesh_filter/stereo_camera_model.h>
 #include <moveit/lazy_free_space_updater/lazy_free_space_updater.h>
 #include <image_transport/image_transport.hpp>
@@ -94,18 +96,22 @@ private:
   double max_update_rate_;
   unsigned int skip_vertical_pixels_;
   unsigned int skip_horizontal_pixels_;
+  bool software_rendering_;
+  bool voxel_filter_;
 
   unsigned int image_callback_count_;
   double average_callback_dt_;
   unsigned int good_tf_;
   unsigned int failed_tf_;
 
-  std::unique_ptr<mesh_filter::MeshFilter<mesh_filter::StereoCameraModel> > mesh_filter_;
+  std::unique_ptr<mesh_filter::MeshFilterInterface> mesh_filter_;
   std::unique_ptr<LazyFreeSpaceUpdater> free_space_updater_;
 
   std::vector<double> x_cache_, y_cache_;
   double inv_fx_, inv_fy_, K0_, K2_, K4_, K5_;
   std::vector<unsigned int> filtered_labels_;
+  std::vector<double> depth_buffer_;
+  VoxelGrid voxel_grid_;
   rclcpp::Time last_depth_callback_start_;
 };
 }  // namespace occupancy_map_monitor
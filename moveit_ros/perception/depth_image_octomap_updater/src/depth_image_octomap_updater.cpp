@@ -36,6 +36,7 @@
 
 #include <moveit/depth_image_octomap_updater/depth_image_octomap_updater.h>
 #include <moveit/occupancy_map_monitor/occupancy_map_monitor.h>
+#include <algorithm>
 #include <cmath>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <tf2/LinearMath/Vector3.h>
@@ -50,6 +51,16 @@ namespace occupancy_map_monitor
 {
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit.ros.perception.depth_image_octomap_updater");
 
+namespace
+{
+// flags of the voxels the pixels are collapsed into
+enum CellFlags
+{
+  OCCUPIED_CELL = 1,
+  MODEL_CELL = 2
+};
+}  // namespace
+
 DepthImageOctomapUpdater::DepthImageOctomapUpdater()
   : OccupancyMapUpdater("DepthImageUpdater")
   , image_topic_("depth")
@@ -62,6 +73,8 @@ DepthImageOctomapUpdater::DepthImageOctomapUpdater()
   , max_update_rate_(0)
   , skip_vertical_pixels_(4)
   , skip_horizontal_pixels_(6)
+  , software_rendering_(false)
+  , voxel_filter_(false)
   , image_callback_count_(0)
   , average_callback_dt_(0.0)
   , good_tf_(5)
@@ -83,6 +96,8 @@ bool DepthImageOctomapUpdater::setParams(const std::string& name_space)
 {
   try
   {
+    node_->get_parameter_or(name_space + ".software_rendering", software_rendering_, false);
+    node_->get_parameter_or(name_space + ".voxel_filter", voxel_filter_, false);
     node_->get_parameter(name_space + ".image_topic", image_topic_) &&
         node_->get_parameter(name_space + ".queue_size", queue_size_) &&
         node_->get_parameter(name_space + ".near_clipping_plane_distance", near_clipping_plane_distance_) &&
@@ -115,10 +130,18 @@ bool DepthImageOctomapUpdater::initialize(const rclcpp::Node::SharedPtr& node)
   tf_buffer_ = monitor_->getTFClient();
   free_space_updater_ = std::make_unique<LazyFreeSpaceUpdater>(tree_);
 
-  // create our mesh filter
-  mesh_filter_ = std::make_unique<mesh_filter::MeshFilter<mesh_filter::StereoCameraModel>>(
-      mesh_filter::MeshFilterBase::TransformCallback(), mesh_filter::StereoCameraModel::REGISTERED_PSDK_PARAMS);
-  mesh_filter_->parameters().setDepthRange(near_clipping_plane_distance_, far_clipping_plane_distance_);
+  // create our mesh filter, the software renderer does not need an OpenGL context and works without a display
+  if (software_rendering_)
+  {
+    mesh_filter_ = std::make_unique<mesh_filter::SoftwareMeshFilter<mesh_filter::StereoCameraModel>>(
+        mesh_filter::MeshFilterInterface::TransformCallback(), mesh_filter::StereoCameraModel::REGISTERED_PSDK_PARAMS);
+  }
+  else
+  {
+    mesh_filter_ = std::make_unique<mesh_filter::MeshFilter<mesh_filter::StereoCameraModel>>(
+        mesh_filter::MeshFilterBase::TransformCallback(), mesh_filter::StereoCameraModel::REGISTERED_PSDK_PARAMS);
+  }
+  mesh_filter_->getSensorParameters().setDepthRange(near_clipping_plane_distance_, far_clipping_plane_distance_);
   mesh_filter_->setShadowThreshold(shadow_threshold_);
   mesh_filter_->setPaddingOffset(padding_offset_);
   mesh_filter_->setPaddingScale(padding_scale_);
@@ -359,14 +382,15 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
   const int h = depth_msg->height;
 
   // call the mesh filter
-  mesh_filter::StereoCameraModel::Parameters& params = mesh_filter_->parameters();
+  mesh_filter::StereoCameraModel::Parameters& params =
+      static_cast<mesh_filter::StereoCameraModel::Parameters&>(mesh_filter_->getSensorParameters());
   params.setCameraParameters(info_msg->k[0], info_msg->k[4], info_msg->k[2], info_msg->k[5]);
   params.setImageSize(w, h);
 
   const bool is_u_short = depth_msg->encoding == sensor_msgs::image_encodings::TYPE_16UC1;
   if (is_u_short)
   {
-    mesh_filter_->filter(&depth_msg->data[0], GL_UNSIGNED_SHORT);
+    mesh_filter_->filter(&depth_msg->data[0], mesh_filter::MeshFilterInterface::UNSIGNED_SHORT_DEPTH);
   }
   else
   {
@@ -379,7 +403,7 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
 #pragma GCC diagnostic pop
       return;
     }
-    mesh_filter_->filter(&depth_msg->data[0], GL_FLOAT);
+    mesh_filter_->filter(&depth_msg->data[0], mesh_filter::MeshFilterInterface::FLOAT_DEPTH);
   }
 
   // the mesh filter runs in background; compute extra things in the meantime
@@ -429,6 +453,8 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
   std::size_t img_size = h * w;
   if (filtered_labels_.size() < img_size)
     filtered_labels_.resize(img_size);
+  if (depth_buffer_.size() < img_size)
+    depth_buffer_.resize(img_size);
 
   // get the labels of the filtered data
   const unsigned int* labels_row = &filtered_labels_[0];
@@ -445,7 +471,8 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
     debug_msg.encoding = sensor_msgs::image_encodings::TYPE_32FC1;
     debug_msg.step = w * sizeof(float);
     debug_msg.data.resize(img_size * sizeof(float));
-    mesh_filter_->getModelDepth(reinterpret_cast<double*>(&debug_msg.data[0]));
+    mesh_filter_->getModelDepth(&depth_buffer_[0]);
+    std::copy(depth_buffer_.begin(), depth_buffer_.begin() + img_size, reinterpret_cast<float*>(&debug_msg.data[0]));
     pub_model_depth_image_.publish(debug_msg, *info_msg);
 
     sensor_msgs::msg::Image filtered_depth_msg;
@@ -456,7 +483,9 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
     filtered_depth_msg.encoding = sensor_msgs::image_encodings::TYPE_32FC1;
     filtered_depth_msg.step = w * sizeof(float);
     filtered_depth_msg.data.resize(img_size * sizeof(float));
-    mesh_filter_->getFilteredDepth(reinterpret_cast<double*>(&filtered_depth_msg.data[0]));
+    mesh_filter_->getFilteredDepth(&depth_buffer_[0]);
+    std::copy(depth_buffer_.begin(), depth_buffer_.begin() + img_size,
+              reinterpret_cast<float*>(&filtered_depth_msg.data[0]));
     pub_filtered_depth_image_.publish(filtered_depth_msg, *info_msg);
 
     sensor_msgs::msg::Image label_msg;
@@ -483,22 +512,29 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
     filtered_msg.step = w * sizeof(unsigned short);
     filtered_msg.data.resize(img_size * sizeof(unsigned short));
 
-    // reuse float buffer across callbacks
-    static std::vector<float> filtered_data;
-    if (filtered_data.size() < img_size)
-      filtered_data.resize(img_size);
-
-    mesh_filter_->getFilteredDepth(reinterpret_cast<double*>(&filtered_data[0]));
+    mesh_filter_->getFilteredDepth(&depth_buffer_[0]);
     unsigned short* msg_data = reinterpret_cast<unsigned short*>(&filtered_msg.data[0]);
     for (std::size_t i = 0; i < img_size; ++i)
     {
       // rescale depth to millimeter to work with `unsigned short`
-      msg_data[i] = static_cast<unsigned short>(filtered_data[i] * 1000 + 0.5);
+      msg_data[i] = static_cast<unsigned short>(depth_buffer_[i] * 1000 + 0.5);
     }
     pub_filtered_depth_image_.publish(filtered_msg, *info_msg);
   }
 
   // figure out occupied cells and model cells
+  // with the voxel filter, the pixels are collapsed per leaf first and every leaf is added to the cell sets once
+  voxel_grid_.clear();
+  const auto add_cell = [this, &occupied_cells, &model_cells](const tf2::Vector3& point_tf, CellFlags flag) {
+    const octomap::OcTreeKey key = tree_->coordToKey(point_tf.getX(), point_tf.getY(), point_tf.getZ());
+    if (voxel_filter_)
+      voxel_grid_.insert(key, Eigen::Vector3f(point_tf.getX(), point_tf.getY(), point_tf.getZ()), flag);
+    else if (flag == MODEL_CELL)
+      model_cells.insert(key);
+    else
+      occupied_cells.insert(key);
+  };
+
   tree_->lockRead();
 
   try
@@ -522,7 +558,7 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
             float xx = x_cache_[x] * zz;
             /* transform to map frame */
             tf2::Vector3 point_tf = map_h_sensor * tf2::Vector3(xx, yy, zz);
-            occupied_cells.insert(tree_->coordToKey(point_tf.getX(), point_tf.getY(), point_tf.getZ()));
+            add_cell(point_tf, OCCUPIED_CELL);
           }
           // on far plane or a model point -> remove
           else if (labels_row[x] >= mesh_filter::MeshFilterBase::FAR_CLIP)
@@ -533,7 +569,7 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
             /* transform to map frame */
             tf2::Vector3 point_tf = map_h_sensor * tf2::Vector3(xx, yy, zz);
             // add to the list of model cells
-            model_cells.insert(tree_->coordToKey(point_tf.getX(), point_tf.getY(), point_tf.getZ()));
+            add_cell(point_tf, MODEL_CELL);
           }
         }
       }
@@ -553,7 +589,7 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
             float xx = x_cache_[x] * zz;
             /* transform to map frame */
             tf2::Vector3 point_tf = map_h_sensor * tf2::Vector3(xx, yy, zz);
-            occupied_cells.insert(tree_->coordToKey(point_tf.getX(), point_tf.getY(), point_tf.getZ()));
+            add_cell(point_tf, OCCUPIED_CELL);
           }
           else if (labels_row[x] >= mesh_filter::MeshFilterBase::FAR_CLIP)
           {
@@ -563,7 +599,7 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
             /* transform to map frame */
             tf2::Vector3 point_tf = map_h_sensor * tf2::Vector3(xx, yy, zz);
             // add to the list of model cells
-            model_cells.insert(tree_->coordToKey(point_tf.getX(), point_tf.getY(), point_tf.getZ()));
+            add_cell(point_tf, MODEL_CELL);
           }
         }
       }
@@ -577,6 +613,14 @@ void DepthImageOctomapUpdater::depthImageCallback(const sensor_msgs::msg::Image:
   }
   tree_->unlockRead();
 
+  for (const VoxelGrid::Voxel& voxel : voxel_grid_.getVoxels())
+  {
+    if (voxel.flags & MODEL_CELL)
+      model_cells.insert(voxel.key);
+    else
+      occupied_cells.insert(voxel.key);
+  }
+
   /* cells that overlap with the model are not occupied */
   for (const octomap::OcTreeKey& model_cell : model_cells)
     occupied_cells.erase(model_cell);
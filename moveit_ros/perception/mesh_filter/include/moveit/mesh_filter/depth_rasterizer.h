@@ -0,0 +1,224 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.h>
+#include <moveit/mesh_filter/mesh_filter_interface.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <array>
+#include <vector>
+
+namespace mesh_filter
+{
+MOVEIT_CLASS_FORWARD(RasterMesh);       // Defines RasterMeshPtr, ConstPtr, WeakPtr... etc
+MOVEIT_CLASS_FORWARD(DepthRasterizer);  // Defines DepthRasterizerPtr, ConstPtr, WeakPtr... etc
+
+/**
+ * \brief Triangle mesh with vertex normals as rendered by DepthRasterizer, the CPU counterpart of GLMesh.
+ */
+class RasterMesh
+{
+public:
+  /**
+   * \brief copies the vertices, vertex normals and triangles of a mesh
+   * \param[in] mesh the mesh, its vertex normals need to be computed
+   * \param[in] mesh_label the label written for pixels covered by the mesh
+   */
+  RasterMesh(const shapes::Mesh& mesh, LabelType mesh_label);
+
+  LabelType getLabel() const
+  {
+    return mesh_label_;
+  }
+
+  const Eigen::Matrix3Xf& getVertices() const
+  {
+    return vertices_;
+  }
+
+  const Eigen::Matrix3Xf& getNormals() const
+  {
+    return normals_;
+  }
+
+  /** \brief the vertex indices of the triangles, three per triangle */
+  const std::vector<unsigned int>& getTriangles() const
+  {
+    return triangles_;
+  }
+
+private:
+  Eigen::Matrix3Xf vertices_;
+  Eigen::Matrix3Xf normals_;
+  std::vector<unsigned int> triangles_;
+  LabelType mesh_label_;
+};
+
+/**
+ * \brief Renders meshes into a depth and a label buffer on the CPU, following the conventions of the OpenGL pipeline
+ * set up by GLRenderer and the render shaders of StereoCameraModel.
+ *
+ * Vertices are pushed along their normals by the depth dependent padding, clipped at the near plane and projected with
+ * the pinhole camera model. Triangles that are counter-clockwise in window coordinates are culled like the GL_FRONT
+ * faces of MeshFilterBase. As the window y axis points downwards in the image, these are the faces pointing away from
+ * the camera for meshes with outward facing, counter-clockwise triangles. The depth buffer holds normalized window
+ * depth values, i.e. 0 on the near and 1 on the far clipping plane, and is initialized with 1. Pixels are sampled at
+ * their centers.
+ *
+ * Triangles are binned into square tiles while they are added and the tiles are rasterized in parallel. Within a tile,
+ * whole rows are processed at once with Eigen's vectorized array operations.
+ */
+class DepthRasterizer
+{
+public:
+  /** \brief edge length of the tiles in pixels */
+  static constexpr unsigned TILE_SIZE = 32;
+
+  /**
+   * \brief Constructor
+   * \param[in] width the width of the buffers
+   * \param[in] height the height of the buffers
+   * \param[in] near distance of the near clipping plane in meters
+   * \param[in] far distance of the far clipping plane in meters
+   */
+  DepthRasterizer(unsigned width, unsigned height, float near = 0.1, float far = 10.0);
+
+  /** \brief resizes the buffers, the content is lost */
+  void setBufferSize(unsigned width, unsigned height);
+
+  /** \brief sets the distances of the clipping planes in meters */
+  void setClippingRange(float near, float far);
+
+  /** \brief sets the intrinsic parameters of the pinhole camera */
+  void setCameraParameters(float fx, float fy, float cx, float cy);
+
+  /**
+   * \brief sets the coefficients of the padding along the vertex normals
+   * \note padding in meters = coeff[0] * z^2 + coeff[1] * z + coeff[2], with z being the depth in OpenGL eye
+   * coordinates
+   */
+  void setPaddingCoefficients(const Eigen::Vector3f& padding_coefficients);
+
+  /** \brief clears the buffers and starts a new frame */
+  void begin();
+
+  /**
+   * \brief transforms the triangles of a mesh into the camera frame and assigns them to the tiles they cover
+   * \param[in] mesh the mesh
+   * \param[in] transform the pose of the mesh in the camera frame
+   */
+  void addMesh(const RasterMesh& mesh, const Eigen::Isometry3d& transform);
+
+  /** \brief rasterizes all triangles added since begin() */
+  void end();
+
+  /**
+   * \brief copies the normalized depth buffer
+   * \param[out] depth buffer of width * height values
+   */
+  void getDepthBuffer(double* depth) const;
+
+  /**
+   * \brief copies the label buffer
+   * \param[out] labels buffer of width * height values
+   */
+  void getLabelBuffer(LabelType* labels) const;
+
+  /** \brief returns the normalized depth values of an image row */
+  const float* getDepthRow(unsigned row) const
+  {
+    return &depth_[row * stride_];
+  }
+
+  /** \brief returns the labels of an image row */
+  const LabelType* getLabelRow(unsigned row) const
+  {
+    return &labels_[row * stride_];
+  }
+
+  unsigned getWidth() const
+  {
+    return width_;
+  }
+
+  unsigned getHeight() const
+  {
+    return height_;
+  }
+
+private:
+  /** \brief a projected triangle, with its edge functions and its depth as linear functions of the pixel position */
+  struct Triangle
+  {
+    std::array<Eigen::Vector3d, 3> edges;
+    Eigen::Vector3f depth;
+    std::array<bool, 3> inclusive;
+    int min_x, max_x, min_y, max_y;
+    LabelType label;
+  };
+
+  /** \brief clips a triangle in camera coordinates at the near plane and sets up the remaining triangles */
+  void clipTriangle(const Eigen::Vector3f& p0, const Eigen::Vector3f& p1, const Eigen::Vector3f& p2, LabelType label);
+
+  /** \brief projects a triangle in front of the near plane and adds it to the tiles it covers, if it faces away */
+  void setupTriangle(const Eigen::Vector3f& p0, const Eigen::Vector3f& p1, const Eigen::Vector3f& p2,
+                     LabelType label);
+
+  void rasterizeTile(unsigned tile_x, unsigned tile_y);
+
+  unsigned width_;
+  unsigned height_;
+  float near_;
+  float far_;
+  float fx_;
+  float fy_;
+  float cx_;
+  float cy_;
+  Eigen::Vector3f padding_coefficients_;
+
+  /** \brief the buffers are padded to full tiles, stride_ is the padded width */
+  unsigned stride_;
+  unsigned tiles_x_;
+  unsigned tiles_y_;
+  std::vector<float> depth_;
+  std::vector<LabelType> labels_;
+
+  std::vector<Triangle> triangles_;
+  /** \brief indices of the triangles covering each tile, in the order they were added */
+  std::vector<std::vector<unsigned>> tile_triangles_;
+  Eigen::Matrix3Xf camera_vertices_;
+};
+}  // namespace mesh_filter
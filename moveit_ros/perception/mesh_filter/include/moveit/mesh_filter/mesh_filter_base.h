@@ -39,6 +39,7 @@
 #include <map>
 #include <moveit/macros/class_forward.h>
 #include <moveit/mesh_filter/gl_renderer.h>
+#include <moveit/mesh_filter/mesh_filter_interface.h>
 #include <moveit/mesh_filter/sensor_model.h>
 #include <Eigen/Geometry>  // for Isometry3d
 #include <queue>
@@ -46,37 +47,16 @@
 #include <condition_variable>
 #include <mutex>
 
-// forward declarations
-namespace shapes
-{
-class Mesh;
-}
-
 namespace mesh_filter
 {
 MOVEIT_CLASS_FORWARD(Job);     // Defines JobPtr, ConstPtr, WeakPtr... etc
 MOVEIT_CLASS_FORWARD(GLMesh);  // Defines GLMeshPtr, ConstPtr, WeakPtr... etc
 
-typedef unsigned int MeshHandle;
-typedef uint32_t LabelType;
-
-class MeshFilterBase
+/**
+ * \brief Mesh filter rendering the meshes with OpenGL in a dedicated thread that holds the OpenGL context.
+ */
+class MeshFilterBase : public MeshFilterInterface
 {
-  // inner types and typedefs
-public:
-  typedef std::function<bool(MeshHandle, Eigen::Isometry3d&)> TransformCallback;
-  // \todo @suat: to avoid a few comparisons, it would be much nicer if background = 14 and shadow = 15 (near/far clip
-  // can be anything below that)
-  // this would allow me to do a single comparison instead of 3, in the code i write
-  enum
-  {
-    BACKGROUND = 0,
-    SHADOW = 1,
-    NEAR_CLIP = 2,
-    FAR_CLIP = 3,
-    FIRST_LABEL = 16
-  };
-
 public:
   /**
    * \brief Constructor
@@ -90,7 +70,7 @@ public:
                  const std::string& filter_vertex_shader = "", const std::string& filter_fragment_shader = "");
 
   /** \brief Destructor */
-  ~MeshFilterBase();
+  ~MeshFilterBase() override;
 
   /**
    * \brief adds a mesh to the filter object.
@@ -99,14 +79,14 @@ public:
    * \return handle to the mesh. This handle is used in the transform callback function to identify the mesh and
    * retrieve the correct transformation.
    */
-  MeshHandle addMesh(const shapes::Mesh& mesh);
+  MeshHandle addMesh(const shapes::Mesh& mesh) override;
 
   /**
    * \brief removes a mesh given by its handle
    * \author Suat Gedikli (gedikli@willowgarage.com)
    * \param[in] mesh_handle the handle of the mesh to be removed.
    */
-  void removeMesh(MeshHandle mesh_handle);
+  void removeMesh(MeshHandle mesh_handle) override;
 
   /**
    * \brief label/remove pixels from input depth-image
@@ -114,7 +94,7 @@ public:
    * \param[in] sensor_data pointer to the input depth image from sensor readings.
    * \todo what is type?
    */
-  void filter(const void* sensor_data, GLushort type, bool wait = false) const;
+  void filter(const void* sensor_data, GLushort type, bool wait = false) const override;
 
   /**
    * \brief retrieves the labels of the input data
@@ -124,14 +104,14 @@ public:
    * shadow (1)
    *       The upper 8bit of a label is filled with the user given flag (see addMesh)
    */
-  void getFilteredLabels(LabelType* labels) const;
+  void getFilteredLabels(LabelType* labels) const override;
 
   /**
    * \brief retrieves the filtered depth values
    * \author Suat Gedikli (gedikli@willowgarage.com)
    * \param[out] depth pointer to buffer to be filled with depth values.
    */
-  void getFilteredDepth(double* depth) const;
+  void getFilteredDepth(double* depth) const override;
 
   /**
    * \brief retrieves the labels of the rendered model
@@ -142,14 +122,14 @@ public:
    *       The upper 8bit of a label is filled with the user given flag (see addMesh)
    * \todo How is this data different from the filtered labels?
    */
-  void getModelLabels(LabelType* labels) const;
+  void getModelLabels(LabelType* labels) const override;
 
   /**
    * \brief retrieves the depth values of the rendered model
    * \author Suat Gedikli (gedikli@willowgarage.com)
    * \param[out] depth pointer to buffer to be filled with depth values.
    */
-  void getModelDepth(double* depth) const;
+  void getModelDepth(double* depth) const override;
 
   /**
    * \brief set the shadow threshold. points that are further away than the rendered model are filtered out.
@@ -158,27 +138,31 @@ public:
    * \author Suat Gedikli (gedikli@willowgarage.com)
    * \param[in] threshold shadow threshold in meters
    */
-  void setShadowThreshold(float threshold);
+  void setShadowThreshold(float threshold) override;
 
   /**
    * \brief set the callback for retrieving transformations for each mesh.
    * \author Suat Gedikli (gedikli@willowgarage.com)
    * \param[in] transform_callback the callback
    */
-  void setTransformCallback(const TransformCallback& transform_callback);
+  void setTransformCallback(const TransformCallback& transform_callback) override;
 
   /**
    * \brief set the scale component of padding used to multiply with sensor-specific padding coefficients to get final
    * coefficients.
    * \param[in] scale the scale value
    */
-  void setPaddingScale(float scale);
+  void setPaddingScale(float scale) override;
 
   /**
    * \brief set the offset component of padding. This value is added to the scaled sensor-specific constant component.
    * \param[in] offset the offset value
    */
-  void setPaddingOffset(float offset);
+  void setPaddingOffset(float offset) override;
+
+  SensorModel::Parameters& getSensorParameters() override;
+
+  const SensorModel::Parameters& getSensorParameters() const override;
 
 protected:
   /**
@@ -0,0 +1,166 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.h>
+#include <moveit/mesh_filter/sensor_model.h>
+#include <Eigen/Geometry>  // for Isometry3d
+#include <cstdint>
+#include <functional>
+
+// forward declarations
+namespace shapes
+{
+class Mesh;
+}
+
+namespace mesh_filter
+{
+MOVEIT_CLASS_FORWARD(MeshFilterInterface);  // Defines MeshFilterInterfacePtr, ConstPtr, WeakPtr... etc
+
+typedef unsigned int MeshHandle;
+typedef uint32_t LabelType;
+
+/**
+ * \brief Interface of the mesh filters, i.e. of the backends that render meshes into a depth image and label the
+ * pixels of sensor readings that belong to them.
+ *
+ * MeshFilterBase renders with OpenGL, SoftwareMeshFilterBase rasterizes on the CPU and does not need an OpenGL
+ * context. Both produce the same labels and depth values.
+ */
+class MeshFilterInterface
+{
+public:
+  typedef std::function<bool(MeshHandle, Eigen::Isometry3d&)> TransformCallback;
+
+  enum
+  {
+    BACKGROUND = 0,
+    SHADOW = 1,
+    NEAR_CLIP = 2,
+    FAR_CLIP = 3,
+    FIRST_LABEL = 16
+  };
+
+  /** \brief encodings of the depth images passed to filter(). The values are the ones of GL_UNSIGNED_SHORT and
+   * GL_FLOAT, so the OpenGL constants can be used as well. */
+  enum DepthEncoding : unsigned short
+  {
+    UNSIGNED_SHORT_DEPTH = 0x1403,  // depth in millimeters
+    FLOAT_DEPTH = 0x1406            // depth in meters
+  };
+
+  virtual ~MeshFilterInterface() = default;
+
+  /**
+   * \brief adds a mesh to the filter object.
+   * \param[in] mesh the mesh to be added
+   * \return handle to the mesh. This handle is used in the transform callback function to identify the mesh and
+   * retrieve the correct transformation.
+   */
+  virtual MeshHandle addMesh(const shapes::Mesh& mesh) = 0;
+
+  /**
+   * \brief removes a mesh given by its handle
+   * \param[in] mesh_handle the handle of the mesh to be removed.
+   */
+  virtual void removeMesh(MeshHandle mesh_handle) = 0;
+
+  /**
+   * \brief label/remove pixels from input depth-image
+   * \param[in] sensor_data pointer to the input depth image from sensor readings.
+   * \param[in] type the encoding of the depth image, one of DepthEncoding
+   * \param[in] wait whether to block until the image is filtered, backends may always block
+   */
+  virtual void filter(const void* sensor_data, unsigned short type, bool wait = false) const = 0;
+
+  /**
+   * \brief retrieves the labels of the input data
+   * \param[out] labels pointer to buffer to be filled with labels
+   */
+  virtual void getFilteredLabels(LabelType* labels) const = 0;
+
+  /**
+   * \brief retrieves the filtered depth values
+   * \param[out] depth pointer to buffer to be filled with metric depth values, 0 for removed pixels
+   */
+  virtual void getFilteredDepth(double* depth) const = 0;
+
+  /**
+   * \brief retrieves the labels of the rendered model
+   * \param[out] labels pointer to buffer to be filled with labels
+   */
+  virtual void getModelLabels(LabelType* labels) const = 0;
+
+  /**
+   * \brief retrieves the depth values of the rendered model
+   * \param[out] depth pointer to buffer to be filled with metric depth values, 0 where no mesh was rendered
+   */
+  virtual void getModelDepth(double* depth) const = 0;
+
+  /**
+   * \brief set the shadow threshold. points that are further away than the rendered model are filtered out.
+   *        Except they are further away than this threshold. Then these points are kept, but its label is set to
+   *        1 indicating that it is in the shadow of the model
+   * \param[in] threshold shadow threshold in meters
+   */
+  virtual void setShadowThreshold(float threshold) = 0;
+
+  /**
+   * \brief set the callback for retrieving transformations for each mesh.
+   * \param[in] transform_callback the callback
+   */
+  virtual void setTransformCallback(const TransformCallback& transform_callback) = 0;
+
+  /**
+   * \brief set the scale component of padding used to multiply with sensor-specific padding coefficients to get final
+   * coefficients.
+   * \param[in] scale the scale value
+   */
+  virtual void setPaddingScale(float scale) = 0;
+
+  /**
+   * \brief set the offset component of padding. This value is added to the scaled sensor-specific constant component.
+   * \param[in] offset the offset value
+   */
+  virtual void setPaddingOffset(float offset) = 0;
+
+  /** \brief returns the parameters of the sensor model used by the filter */
+  virtual SensorModel::Parameters& getSensorParameters() = 0;
+
+  /** \brief returns the parameters of the sensor model used by the filter */
+  virtual const SensorModel::Parameters& getSensorParameters() const = 0;
+};
+}  // namespace mesh_filter
@@ -43,6 +43,7 @@ namespace mesh_filter
 {
 // forward declarations
 class GLRenderer;
+class DepthRasterizer;
 
 /**
  * \brief Abstract Interface defining a sensor model for mesh filtering
@@ -87,6 +88,13 @@ public:
      */
     virtual void setFilterParameters(GLRenderer& renderer) const = 0;
 
+    /**
+     * \brief sets the parameters of the software rasterizer, i.e. the counterpart of setRenderParameters for
+     * rendering without OpenGL.
+     * \param rasterizer the rasterizer that needs to be updated
+     */
+    virtual void setRenderParameters(DepthRasterizer& rasterizer) const = 0;
+
     /**
      * \brief polymorphic clone method
      * \return clones object as base class
@@ -0,0 +1,170 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/declare_ptr.h>
+#include <moveit/mesh_filter/depth_rasterizer.h>
+#include <moveit/mesh_filter/mesh_filter_interface.h>
+#include <moveit/mesh_filter/sensor_model.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mesh_filter
+{
+/**
+ * \brief Mesh filter that rasterizes the meshes on the CPU with DepthRasterizer.
+ *
+ * It produces the same labels and depth values as the OpenGL based MeshFilterBase, but does not need an OpenGL
+ * context or a display. Filtering is done synchronously within filter().
+ */
+class SoftwareMeshFilterBase : public MeshFilterInterface
+{
+public:
+  /**
+   * \brief Constructor
+   * \param[in] transform_callback Callback function that is called for each mesh to obtain the current transformation.
+   * \param[in] sensor_parameters the parameters of the sensor model
+   */
+  SoftwareMeshFilterBase(const TransformCallback& transform_callback, const SensorModel::Parameters& sensor_parameters);
+
+  MeshHandle addMesh(const shapes::Mesh& mesh) override;
+
+  void removeMesh(MeshHandle mesh_handle) override;
+
+  void filter(const void* sensor_data, unsigned short type, bool wait = false) const override;
+
+  void getFilteredLabels(LabelType* labels) const override;
+
+  void getFilteredDepth(double* depth) const override;
+
+  void getModelLabels(LabelType* labels) const override;
+
+  void getModelDepth(double* depth) const override;
+
+  void setShadowThreshold(float threshold) override;
+
+  void setTransformCallback(const TransformCallback& transform_callback) override;
+
+  void setPaddingScale(float scale) override;
+
+  void setPaddingOffset(float offset) override;
+
+  SensorModel::Parameters& getSensorParameters() override;
+
+  const SensorModel::Parameters& getSensorParameters() const override;
+
+protected:
+  /**
+   * \brief compares the sensor readings with the rendered model, the CPU version of the filter shader
+   * \param[in] sensor_data pointer to the buffer containing the depth readings
+   * \param[in] scale the factor converting the depth readings to meters
+   */
+  template <typename Type>
+  void filterDepth(const Type* sensor_data, float scale) const;
+
+  /** \brief storage for meshes to be filtered */
+  std::map<MeshHandle, RasterMeshConstPtr> meshes_;
+
+  /** \brief the parameters of the used sensor model*/
+  SensorModel::ParametersPtr sensor_parameters_;
+
+  /** \brief next handle to be used for next mesh that is added*/
+  MeshHandle next_handle_;
+
+  /** \brief Handle values below this are all taken */
+  MeshHandle min_handle_;
+
+  /** \brief mutex for synchronization of the meshes and the buffers */
+  mutable std::mutex mutex_;
+
+  /** \brief mutex for synchronization of setting/calling transform_callback_ */
+  mutable std::mutex transform_callback_mutex_;
+
+  /** \brief renders the meshes into the model depth and label buffers */
+  mutable DepthRasterizer rasterizer_;
+
+  /** \brief filtered depth normalized to the clipping range, 0 for removed pixels */
+  mutable std::vector<float> filtered_depth_;
+
+  /** \brief labels of the filtered pixels */
+  mutable std::vector<LabelType> filtered_labels_;
+
+  /** \brief callback function for retrieving the mesh transformations*/
+  TransformCallback transform_callback_;
+
+  /** \brief padding scale*/
+  float padding_scale_;
+
+  /** \brief padding offset*/
+  float padding_offset_;
+
+  /** \brief threshold for shadowed pixels vs. filtered pixels*/
+  float shadow_threshold_;
+};
+
+/**
+ * \brief SoftwareMeshFilter filters out points that belong to given meshes in depth-images without OpenGL
+ */
+template <typename SensorType>
+class SoftwareMeshFilter : public SoftwareMeshFilterBase
+{
+public:
+  MOVEIT_DECLARE_PTR_MEMBER(SoftwareMeshFilter);
+
+  /**
+   * \brief Constructor
+   * \param[in] transform_callback Callback function that is called for each mesh to obtain the current transformation.
+   * \param[in] sensor_parameters the parameters of the sensor
+   */
+  SoftwareMeshFilter(const TransformCallback& transform_callback = TransformCallback(),
+                     const typename SensorType::Parameters& sensor_parameters = typename SensorType::Parameters())
+    : SoftwareMeshFilterBase(transform_callback, sensor_parameters)
+  {
+  }
+
+  /** \brief returns the Sensor Parameters */
+  typename SensorType::Parameters& parameters()
+  {
+    return static_cast<typename SensorType::Parameters&>(*sensor_parameters_);
+  }
+
+  /** \brief returns the Sensor Parameters */
+  const typename SensorType::Parameters& parameters() const
+  {
+    return static_cast<const typename SensorType::Parameters&>(*sensor_parameters_);
+  }
+};
+}  // namespace mesh_filter
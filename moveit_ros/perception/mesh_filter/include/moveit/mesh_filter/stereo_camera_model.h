@@ -93,6 +93,12 @@ public:
      */
     void setFilterParameters(GLRenderer& renderer) const override;
 
+    /**
+     * \brief set the camera parameters of the software rasterizer
+     * \param[in] rasterizer the rasterizer used to render the meshes without OpenGL
+     */
+    void setRenderParameters(DepthRasterizer& rasterizer) const override;
+
     /**
      * \brief sets the camera parameters of the pinhole camera where the disparities were obtained. Usually the left
      * camera
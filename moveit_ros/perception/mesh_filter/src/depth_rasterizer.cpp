@@ -0,0 +1,339 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/mesh_filter/depth_rasterizer.h>
+#include <geometric_shapes/shapes.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace mesh_filter
+{
+namespace
+{
+typedef Eigen::Array<float, DepthRasterizer::TILE_SIZE, 1> TileRow;
+typedef Eigen::Array<double, DepthRasterizer::TILE_SIZE, 1> TileEdgeRow;
+typedef Eigen::Array<LabelType, DepthRasterizer::TILE_SIZE, 1> TileLabelRow;
+typedef Eigen::Array<bool, DepthRasterizer::TILE_SIZE, 1> TileMask;
+
+// clamps a pixel coordinate before it is converted to an integer, projected coordinates can be huge close to the near
+// plane
+inline int clampedPixel(double value, int max)
+{
+  return static_cast<int>(std::max(-1.0, std::min(value, max + 1.0)));
+}
+
+// window coordinates are snapped to 1/256 pixel like OpenGL implementations do. The edge functions are then exact in
+// double precision, so pixel centers on a shared edge are never dropped by rounding errors.
+inline double snapped(float value)
+{
+  return std::round(value * 256.0) / 256.0;
+}
+}  // namespace
+
+RasterMesh::RasterMesh(const shapes::Mesh& mesh, LabelType mesh_label) : mesh_label_(mesh_label)
+{
+  if (!mesh.vertex_normals)
+  {
+    throw std::runtime_error("Vertex normals are not computed for input mesh. Call computeVertexNormals() before "
+                             "passing as input to mesh_filter.");
+  }
+
+  vertices_ = Eigen::Map<const Eigen::Matrix3Xd>(mesh.vertices, 3, mesh.vertex_count).cast<float>();
+  normals_ = Eigen::Map<const Eigen::Matrix3Xd>(mesh.vertex_normals, 3, mesh.vertex_count).cast<float>();
+  triangles_.assign(mesh.triangles, mesh.triangles + 3 * mesh.triangle_count);
+}
+
+DepthRasterizer::DepthRasterizer(unsigned width, unsigned height, float near, float far)
+  : width_(0)
+  , height_(0)
+  , near_(near)
+  , far_(far)
+  , fx_(width >> 1)
+  , fy_(width >> 1)
+  , cx_(width >> 1)
+  , cy_(height >> 1)
+  , padding_coefficients_(Eigen::Vector3f::Zero())
+  , stride_(0)
+  , tiles_x_(0)
+  , tiles_y_(0)
+{
+  setBufferSize(width, height);
+}
+
+void DepthRasterizer::setBufferSize(unsigned width, unsigned height)
+{
+  if (width == width_ && height == height_)
+    return;
+
+  width_ = width;
+  height_ = height;
+  tiles_x_ = (width + TILE_SIZE - 1) / TILE_SIZE;
+  tiles_y_ = (height + TILE_SIZE - 1) / TILE_SIZE;
+  stride_ = tiles_x_ * TILE_SIZE;
+  depth_.assign(stride_ * tiles_y_ * TILE_SIZE, 1.0f);
+  labels_.assign(stride_ * tiles_y_ * TILE_SIZE, 0);
+  tile_triangles_.assign(tiles_x_ * tiles_y_, std::vector<unsigned>());
+}
+
+void DepthRasterizer::setClippingRange(float near, float far)
+{
+  if (near <= 0)
+    throw std::runtime_error("Near clipping plane distance needs to be larger than zero!");
+
+  if (far <= near)
+    throw std::runtime_error("Far clipping plane distance must be larger than the near clipping plane distance!");
+
+  near_ = near;
+  far_ = far;
+}
+
+void DepthRasterizer::setCameraParameters(float fx, float fy, float cx, float cy)
+{
+  fx_ = fx;
+  fy_ = fy;
+  cx_ = cx;
+  cy_ = cy;
+}
+
+void DepthRasterizer::setPaddingCoefficients(const Eigen::Vector3f& padding_coefficients)
+{
+  padding_coefficients_ = padding_coefficients;
+}
+
+void DepthRasterizer::begin()
+{
+  std::fill(depth_.begin(), depth_.end(), 1.0f);
+  std::fill(labels_.begin(), labels_.end(), 0);
+  triangles_.clear();
+  for (std::vector<unsigned>& tile : tile_triangles_)
+    tile.clear();
+}
+
+void DepthRasterizer::addMesh(const RasterMesh& mesh, const Eigen::Isometry3d& transform)
+{
+  const Eigen::Matrix3f rotation = transform.linear().cast<float>();
+  const Eigen::Vector3f translation = transform.translation().cast<float>();
+
+  // same as the render vertex shader: move the vertices along the normals by the depth dependent padding, the depth
+  // in OpenGL eye coordinates is the negated camera z coordinate
+  camera_vertices_.noalias() = rotation * mesh.getVertices();
+  camera_vertices_.colwise() += translation;
+  Eigen::Matrix3Xf normals = rotation * mesh.getNormals();
+  normals.colwise().normalize();
+  const Eigen::ArrayXf eye_z = -camera_vertices_.row(2).transpose().array();
+  const Eigen::ArrayXf padding =
+      (padding_coefficients_.x() * eye_z + padding_coefficients_.y()) * eye_z + padding_coefficients_.z();
+  camera_vertices_ += (normals.array().rowwise() * padding.transpose()).matrix();
+
+  const std::vector<unsigned int>& triangles = mesh.getTriangles();
+  for (std::size_t i = 0; i + 2 < triangles.size(); i += 3)
+  {
+    clipTriangle(camera_vertices_.col(triangles[i]), camera_vertices_.col(triangles[i + 1]),
+                 camera_vertices_.col(triangles[i + 2]), mesh.getLabel());
+  }
+}
+
+void DepthRasterizer::clipTriangle(const Eigen::Vector3f& p0, const Eigen::Vector3f& p1, const Eigen::Vector3f& p2,
+                                   LabelType label)
+{
+  const std::array<const Eigen::Vector3f*, 3> vertices = { &p0, &p1, &p2 };
+  int in_front = 0;
+  int behind_far = 0;
+  for (const Eigen::Vector3f* p : vertices)
+  {
+    in_front += (p->z() > near_);
+    behind_far += (p->z() > far_);
+  }
+
+  // completely behind the near or the far clipping plane
+  if (in_front == 0 || behind_far == 3)
+    return;
+
+  if (in_front == 3)
+  {
+    setupTriangle(p0, p1, p2, label);
+    return;
+  }
+
+  // clip the polygon at the near plane, which leaves a triangle or a quad
+  std::array<Eigen::Vector3f, 4> polygon;
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    const Eigen::Vector3f& a = *vertices[i];
+    const Eigen::Vector3f& b = *vertices[(i + 1) % 3];
+    if (a.z() > near_)
+      polygon[size++] = a;
+    if ((a.z() > near_) != (b.z() > near_))
+    {
+      const float t = (near_ - a.z()) / (b.z() - a.z());
+      polygon[size] = a + t * (b - a);
+      polygon[size++].z() = near_;
+    }
+  }
+
+  for (std::size_t i = 1; i + 1 < size; ++i)
+    setupTriangle(polygon[0], polygon[i], polygon[i + 1], label);
+}
+
+void DepthRasterizer::setupTriangle(const Eigen::Vector3f& p0, const Eigen::Vector3f& p1, const Eigen::Vector3f& p2,
+                                    LabelType label)
+{
+  // window coordinates and normalized depth, as produced by the frustum set up in GLRenderer
+  std::array<Eigen::Vector3d, 3> v;
+  const std::array<const Eigen::Vector3f*, 3> points = { &p0, &p1, &p2 };
+  const float depth_scale = far_ / (far_ - near_);
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    const Eigen::Vector3f& p = *points[i];
+    v[i] = Eigen::Vector3d(snapped(fx_ * p.x() / p.z() + cx_), snapped(fy_ * p.y() / p.z() + cy_),
+                           depth_scale * (1.0f - near_ / p.z()));
+  }
+
+  // counter-clockwise triangles are front faces, which are culled. Reorder the remaining clockwise ones to have
+  // positive edge functions inside.
+  const double area = (v[1].x() - v[0].x()) * (v[2].y() - v[0].y()) - (v[2].x() - v[0].x()) * (v[1].y() - v[0].y());
+  if (!(area < 0.0))
+    return;
+  std::swap(v[1], v[2]);
+
+  Triangle triangle;
+  triangle.label = label;
+  Eigen::Vector3d depth = Eigen::Vector3d::Zero();
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    // edge function of the edge opposite to vertex i, positive on the inner side
+    const Eigen::Vector3d& a = v[(i + 1) % 3];
+    const Eigen::Vector3d& b = v[(i + 2) % 3];
+    const double dx = b.x() - a.x();
+    const double dy = b.y() - a.y();
+    triangle.edges[i] = Eigen::Vector3d(-dy, dx, dy * a.x() - dx * a.y());
+    // pixel centers on an edge shared by two triangles belong to exactly one of them
+    triangle.inclusive[i] = dy > 0.0 || (dy == 0.0 && dx < 0.0);
+    depth += triangle.edges[i] * (v[i].z() / -area);
+  }
+  triangle.depth = depth.cast<float>();
+
+  const double min_x = std::min({ v[0].x(), v[1].x(), v[2].x() });
+  const double max_x = std::max({ v[0].x(), v[1].x(), v[2].x() });
+  const double min_y = std::min({ v[0].y(), v[1].y(), v[2].y() });
+  const double max_y = std::max({ v[0].y(), v[1].y(), v[2].y() });
+  triangle.min_x = std::max(0, clampedPixel(std::ceil(min_x - 0.5), width_));
+  triangle.max_x = std::min(static_cast<int>(width_) - 1, clampedPixel(std::floor(max_x - 0.5), width_));
+  triangle.min_y = std::max(0, clampedPixel(std::ceil(min_y - 0.5), height_));
+  triangle.max_y = std::min(static_cast<int>(height_) - 1, clampedPixel(std::floor(max_y - 0.5), height_));
+  if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+    return;
+
+  const unsigned index = triangles_.size();
+  triangles_.push_back(triangle);
+  for (unsigned tile_y = triangle.min_y / TILE_SIZE; tile_y <= triangle.max_y / TILE_SIZE; ++tile_y)
+  {
+    for (unsigned tile_x = triangle.min_x / TILE_SIZE; tile_x <= triangle.max_x / TILE_SIZE; ++tile_x)
+      tile_triangles_[tile_y * tiles_x_ + tile_x].push_back(index);
+  }
+}
+
+void DepthRasterizer::end()
+{
+  const int tile_count = tiles_x_ * tiles_y_;
+#pragma omp parallel for schedule(dynamic)
+  for (int tile = 0; tile < tile_count; ++tile)
+    rasterizeTile(tile % tiles_x_, tile / tiles_x_);
+}
+
+void DepthRasterizer::rasterizeTile(unsigned tile_x, unsigned tile_y)
+{
+  const std::vector<unsigned>& tile_triangles = tile_triangles_[tile_y * tiles_x_ + tile_x];
+  if (tile_triangles.empty())
+    return;
+
+  const int first_x = tile_x * TILE_SIZE;
+  const int first_y = tile_y * TILE_SIZE;
+  const TileRow columns = TileRow::LinSpaced(TILE_SIZE, 0.0f, static_cast<float>(TILE_SIZE - 1));
+  const TileRow sample_x = columns + (first_x + 0.5f);
+  const TileEdgeRow edge_sample_x = sample_x.cast<double>();
+
+  for (unsigned index : tile_triangles)
+  {
+    const Triangle& triangle = triangles_[index];
+    const int begin_y = std::max(triangle.min_y, first_y);
+    const int end_y = std::min(triangle.max_y, first_y + static_cast<int>(TILE_SIZE) - 1);
+    const TileMask covered_columns = (columns >= static_cast<float>(triangle.min_x - first_x)) &&
+                                     (columns <= static_cast<float>(triangle.max_x - first_x));
+
+    // the edge functions and the depth are linear in x, evaluate them for all pixels of a tile row at once
+    std::array<TileEdgeRow, 3> edges;
+    for (std::size_t i = 0; i < 3; ++i)
+      edges[i] = triangle.edges[i].x() * edge_sample_x;
+    const TileRow depth_x = triangle.depth.x() * sample_x;
+
+    for (int y = begin_y; y <= end_y; ++y)
+    {
+      const float sample_y = y + 0.5f;
+      TileMask inside = covered_columns;
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        const TileEdgeRow edge = edges[i] + (triangle.edges[i].y() * sample_y + triangle.edges[i].z());
+        if (triangle.inclusive[i])
+          inside = inside && (edge >= 0.0);
+        else
+          inside = inside && (edge > 0.0);
+      }
+      if (!inside.any())
+        continue;
+
+      const TileRow depth = depth_x + (triangle.depth.y() * sample_y + triangle.depth.z());
+      Eigen::Map<TileRow> depth_row(&depth_[y * stride_ + first_x]);
+      Eigen::Map<TileLabelRow> label_row(&labels_[y * stride_ + first_x]);
+      const TileMask visible = inside && (depth < depth_row);
+      depth_row = visible.select(depth, depth_row);
+      label_row = visible.select(TileLabelRow::Constant(triangle.label), label_row);
+    }
+  }
+}
+
+void DepthRasterizer::getDepthBuffer(double* depth) const
+{
+  for (unsigned y = 0; y < height_; ++y)
+    std::copy(getDepthRow(y), getDepthRow(y) + width_, depth + y * width_);
+}
+
+void DepthRasterizer::getLabelBuffer(LabelType* labels) const
+{
+  for (unsigned y = 0; y < height_; ++y)
+    std::copy(getLabelRow(y), getLabelRow(y) + width_, labels + y * width_);
+}
+}  // namespace mesh_filter
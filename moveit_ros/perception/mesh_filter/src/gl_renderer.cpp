@@ -43,6 +43,7 @@
 #endif
 #include <GL/freeglut.h>
 #include <moveit/mesh_filter/gl_renderer.h>
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <stdexcept>
@@ -216,10 +217,13 @@ void mesh_filter::GLRenderer::getColorBuffer(unsigned char* buffer) const
 
 void mesh_filter::GLRenderer::getDepthBuffer(double* buffer) const
 {
+  // OpenGL returns single precision values, widen them to the doubles expected by the caller
+  std::vector<float> depth(width_ * height_);
   glBindFramebuffer(GL_FRAMEBUFFER, fbo_id_);
   glBindTexture(GL_TEXTURE_2D, depth_id_);
-  glGetTexImage(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, GL_FLOAT, buffer);
+  glGetTexImage(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, GL_FLOAT, &depth[0]);
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  std::copy(depth.begin(), depth.end(), buffer);
 }
 
 GLuint mesh_filter::GLRenderer::setShadersFromFile(const string& vertex_filename, const string& fragment_filename)
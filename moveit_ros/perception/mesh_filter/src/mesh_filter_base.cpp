@@ -51,6 +51,10 @@
 #include <xmmintrin.h>
 #endif
 
+static_assert(mesh_filter::MeshFilterInterface::UNSIGNED_SHORT_DEPTH == GL_UNSIGNED_SHORT &&
+                  mesh_filter::MeshFilterInterface::FLOAT_DEPTH == GL_FLOAT,
+              "depth encodings need to match the OpenGL types");
+
 mesh_filter::MeshFilterBase::MeshFilterBase(const TransformCallback& transform_callback,
                                             const SensorModel::Parameters& sensor_parameters,
                                             const std::string& render_vertex_shader,
@@ -404,3 +408,13 @@ void mesh_filter::MeshFilterBase::setPaddingScale(float scale)
 {
   padding_scale_ = scale;
 }
+
+mesh_filter::SensorModel::Parameters& mesh_filter::MeshFilterBase::getSensorParameters()
+{
+  return *sensor_parameters_;
+}
+
+const mesh_filter::SensorModel::Parameters& mesh_filter::MeshFilterBase::getSensorParameters() const
+{
+  return *sensor_parameters_;
+}
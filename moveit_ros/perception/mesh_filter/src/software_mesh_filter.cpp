@@ -0,0 +1,222 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/mesh_filter/software_mesh_filter.h>
+#include <geometric_shapes/shapes.h>
+#include <Eigen/Core>
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace mesh_filter
+{
+SoftwareMeshFilterBase::SoftwareMeshFilterBase(const TransformCallback& transform_callback,
+                                               const SensorModel::Parameters& sensor_parameters)
+  : sensor_parameters_(sensor_parameters.clone())
+  , next_handle_(FIRST_LABEL)  // 0 and 1 are reserved!
+  , min_handle_(FIRST_LABEL)
+  , rasterizer_(sensor_parameters.getWidth(), sensor_parameters.getHeight(),
+                sensor_parameters.getNearClippingPlaneDistance(), sensor_parameters.getFarClippingPlaneDistance())
+  , transform_callback_(transform_callback)
+  , padding_scale_(1.0)
+  , padding_offset_(0.01)
+  , shadow_threshold_(0.5)
+{
+}
+
+MeshHandle SoftwareMeshFilterBase::addMesh(const shapes::Mesh& mesh)
+{
+  std::unique_lock<std::mutex> _(mutex_);
+
+  meshes_[next_handle_] = std::make_shared<const RasterMesh>(mesh, next_handle_);
+  MeshHandle ret = next_handle_;
+  const std::size_t sz = min_handle_ + meshes_.size() + 1;
+  for (std::size_t i = min_handle_; i < sz; ++i)
+  {
+    if (meshes_.find(i) == meshes_.end())
+    {
+      next_handle_ = i;
+      break;
+    }
+  }
+  min_handle_ = next_handle_;
+  return ret;
+}
+
+void SoftwareMeshFilterBase::removeMesh(MeshHandle handle)
+{
+  std::unique_lock<std::mutex> _(mutex_);
+  if (meshes_.erase(handle) == 0)
+    throw std::runtime_error("Could not remove mesh. Mesh not found!");
+  min_handle_ = std::min(handle, min_handle_);
+}
+
+void SoftwareMeshFilterBase::setShadowThreshold(float threshold)
+{
+  shadow_threshold_ = threshold;
+}
+
+void SoftwareMeshFilterBase::setTransformCallback(const TransformCallback& transform_callback)
+{
+  std::unique_lock<std::mutex> _(transform_callback_mutex_);
+  transform_callback_ = transform_callback;
+}
+
+void SoftwareMeshFilterBase::setPaddingScale(float scale)
+{
+  padding_scale_ = scale;
+}
+
+void SoftwareMeshFilterBase::setPaddingOffset(float offset)
+{
+  padding_offset_ = offset;
+}
+
+SensorModel::Parameters& SoftwareMeshFilterBase::getSensorParameters()
+{
+  return *sensor_parameters_;
+}
+
+const SensorModel::Parameters& SoftwareMeshFilterBase::getSensorParameters() const
+{
+  return *sensor_parameters_;
+}
+
+void SoftwareMeshFilterBase::filter(const void* sensor_data, unsigned short type, bool /*wait*/) const
+{
+  if (type != FLOAT_DEPTH && type != UNSIGNED_SHORT_DEPTH)
+  {
+    std::stringstream msg;
+    msg << "unknown type \"" << type << "\". Allowed values are GL_FLOAT or GL_UNSIGNED_SHORT.";
+    throw std::runtime_error(msg.str());
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  {
+    std::unique_lock<std::mutex> _(transform_callback_mutex_);
+    sensor_parameters_->setRenderParameters(rasterizer_);
+    rasterizer_.setPaddingCoefficients(sensor_parameters_->getPaddingCoefficients() * padding_scale_ +
+                                       Eigen::Vector3f(0, 0, padding_offset_));
+    rasterizer_.begin();
+    Eigen::Isometry3d transform;
+    for (const std::pair<const MeshHandle, RasterMeshConstPtr>& mesh : meshes_)
+    {
+      if (transform_callback_(mesh.first, transform))
+        rasterizer_.addMesh(*mesh.second, transform);
+    }
+  }
+  rasterizer_.end();
+
+  if (type == UNSIGNED_SHORT_DEPTH)
+    filterDepth(static_cast<const unsigned short*>(sensor_data), 0.001f);
+  else
+    filterDepth(static_cast<const float*>(sensor_data), 1.0f);
+}
+
+template <typename Type>
+void SoftwareMeshFilterBase::filterDepth(const Type* sensor_data, float scale) const
+{
+  const int width = rasterizer_.getWidth();
+  const int height = rasterizer_.getHeight();
+  filtered_depth_.resize(width * height);
+  filtered_labels_.resize(width * height);
+
+  // depth values are normalized to the clipping range like the depth texture of the OpenGL filter
+  const float near = sensor_parameters_->getNearClippingPlaneDistance();
+  const float far = sensor_parameters_->getFarClippingPlaneDistance();
+  const float f_n = far - near;
+  const float threshold = shadow_threshold_ / f_n;
+  const float sensor_scale = scale / f_n;
+  const float sensor_offset = -near / f_n;
+
+#pragma omp parallel
+  {
+    Eigen::ArrayXf sensor(width);
+    Eigen::ArrayXf diff(width);
+#pragma omp for schedule(static)
+    for (int y = 0; y < height; ++y)
+    {
+      const Eigen::Map<const Eigen::Array<Type, Eigen::Dynamic, 1>> sensor_row(sensor_data + y * width, width);
+      const Eigen::Map<const Eigen::ArrayXf> model_depth(rasterizer_.getDepthRow(y), width);
+      const Eigen::Map<const Eigen::Array<LabelType, Eigen::Dynamic, 1>> model_labels(rasterizer_.getLabelRow(y),
+                                                                                     width);
+      Eigen::Map<Eigen::ArrayXf> depth_row(&filtered_depth_[y * width], width);
+      Eigen::Map<Eigen::Array<LabelType, Eigen::Dynamic, 1>> label_row(&filtered_labels_[y * width], width);
+
+      // clamp to [0, 1] as done when uploading the depth texture, invalid readings (0, NaN) end up at 0
+      sensor = sensor_row.template cast<float>() * sensor_scale + sensor_offset;
+      sensor = (sensor > 0.0f).select(sensor.min(1.0f), 0.0f);
+      // model depth as normalized distance, 1 where no mesh was rendered
+      diff = sensor - model_depth * near / (far - model_depth * f_n);
+
+      const auto near_clip = sensor <= 0.0f;
+      const auto background = (diff < 0.0f) && (sensor < 1.0f);
+      const auto shadow = diff > threshold;
+      const auto far_clip = sensor == 1.0f;
+      label_row = near_clip.select(
+          LabelType(NEAR_CLIP),
+          background.select(LabelType(BACKGROUND),
+                            shadow.select(LabelType(SHADOW), far_clip.select(LabelType(FAR_CLIP), model_labels))));
+      depth_row = (!near_clip && (background || shadow || far_clip)).select(sensor, 0.0f);
+    }
+  }
+}
+
+void SoftwareMeshFilterBase::getFilteredLabels(LabelType* labels) const
+{
+  std::unique_lock<std::mutex> _(mutex_);
+  std::copy(filtered_labels_.begin(), filtered_labels_.end(), labels);
+}
+
+void SoftwareMeshFilterBase::getFilteredDepth(double* depth) const
+{
+  std::unique_lock<std::mutex> _(mutex_);
+  std::copy(filtered_depth_.begin(), filtered_depth_.end(), depth);
+  sensor_parameters_->transformFilteredDepthToMetricDepth(depth);
+}
+
+void SoftwareMeshFilterBase::getModelLabels(LabelType* labels) const
+{
+  std::unique_lock<std::mutex> _(mutex_);
+  rasterizer_.getLabelBuffer(labels);
+}
+
+void SoftwareMeshFilterBase::getModelDepth(double* depth) const
+{
+  std::unique_lock<std::mutex> _(mutex_);
+  rasterizer_.getDepthBuffer(depth);
+  sensor_parameters_->transformModelDepthToMetricDepth(depth);
+}
+}  // namespace mesh_filter
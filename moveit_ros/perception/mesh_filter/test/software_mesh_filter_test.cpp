@@ -0,0 +1,215 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/mesh_filter/software_mesh_filter.h>
+#include <moveit/mesh_filter/stereo_camera_model.h>
+#include <geometric_shapes/shapes.h>
+#include <geometric_shapes/shape_operations.h>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace mesh_filter;
+
+namespace
+{
+constexpr unsigned WIDTH = 500;
+constexpr unsigned HEIGHT = 500;
+constexpr double NEAR = 0.5;
+constexpr double FAR = 5.0;
+constexpr double SHADOW = 0.1;
+
+StereoCameraModel::Parameters sensorParameters()
+{
+  return StereoCameraModel::Parameters(WIDTH, HEIGHT, NEAR, FAR, WIDTH >> 1, HEIGHT >> 1, WIDTH >> 1, HEIGHT >> 1, 0.1,
+                                       0.1);
+}
+
+// a large double sided plane that covers the whole visible area
+shapes::Mesh createPlane()
+{
+  shapes::Mesh mesh(4, 4);
+  const double vertices[] = { -5, -5, 0, -5, 5, 0, 5, 5, 0, 5, -5, 0 };
+  const unsigned int triangles[] = { 0, 3, 2, 0, 2, 1, 0, 2, 3, 0, 1, 2 };
+  std::copy(vertices, vertices + 12, mesh.vertices);
+  std::copy(triangles, triangles + 12, mesh.triangles);
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    mesh.vertex_normals[3 * i] = 0;
+    mesh.vertex_normals[3 * i + 1] = 0;
+    mesh.vertex_normals[3 * i + 2] = 1;
+  }
+  return mesh;
+}
+
+template <typename Type>
+struct DepthTraits;
+
+template <>
+struct DepthTraits<float>
+{
+  static constexpr unsigned short ENCODING = MeshFilterInterface::FLOAT_DEPTH;
+  static constexpr double TO_METRIC_SCALE = 1.0;
+};
+
+template <>
+struct DepthTraits<unsigned short>
+{
+  static constexpr unsigned short ENCODING = MeshFilterInterface::UNSIGNED_SHORT_DEPTH;
+  static constexpr double TO_METRIC_SCALE = 0.001;
+};
+
+template <typename Type>
+void testPlane(double distance)
+{
+  SoftwareMeshFilter<StereoCameraModel> filter(
+      [distance](MeshHandle /*handle*/, Eigen::Isometry3d& transform) {
+        transform = Eigen::Isometry3d::Identity();
+        transform.translation().z() = distance;
+        return true;
+      },
+      sensorParameters());
+  filter.setShadowThreshold(SHADOW);
+  // no padding
+  filter.setPaddingOffset(0.0);
+  filter.setPaddingScale(0.0);
+  const MeshHandle handle = filter.addMesh(createPlane());
+
+  // make it random but reproducible
+  std::srand(0);
+  const double scale = DepthTraits<Type>::TO_METRIC_SCALE;
+  std::vector<Type> sensor_data(WIDTH * HEIGHT);
+  for (Type& value : sensor_data)
+    value = static_cast<Type>(10.0 / scale * std::rand() / RAND_MAX);
+
+  filter.filter(&sensor_data[0], DepthTraits<Type>::ENCODING, true);
+  std::vector<double> filtered_depth(WIDTH * HEIGHT);
+  std::vector<LabelType> filtered_labels(WIDTH * HEIGHT);
+  filter.getFilteredDepth(&filtered_depth[0]);
+  filter.getFilteredLabels(&filtered_labels[0]);
+
+  const bool visible = distance > NEAR && distance < FAR;
+  for (std::size_t idx = 0; idx < sensor_data.size(); ++idx)
+  {
+    const double depth = sensor_data[idx] * scale;
+    // skip readings close to the mesh, the shadow boundary or the clipping planes
+    if (std::fabs(depth - distance) < 1e-3 || std::fabs(depth - distance - SHADOW) < 1e-3 ||
+        std::fabs(depth - NEAR) < 1e-3 || std::fabs(depth - FAR) < 1e-3)
+      continue;
+
+    LabelType label;
+    if (depth < NEAR)
+      label = MeshFilterInterface::NEAR_CLIP;
+    else if (!visible || depth < distance)
+      label = depth < FAR ? MeshFilterInterface::BACKGROUND : MeshFilterInterface::FAR_CLIP;
+    else if (depth - distance > SHADOW)
+      label = MeshFilterInterface::SHADOW;
+    else if (depth >= FAR)
+      label = MeshFilterInterface::FAR_CLIP;
+    else
+      label = handle;
+
+    const bool keep = label != MeshFilterInterface::NEAR_CLIP && label != handle && depth < FAR;
+    ASSERT_EQ(filtered_labels[idx], label) << "pixel " << idx << " at depth " << depth;
+    ASSERT_NEAR(filtered_depth[idx], keep ? depth : 0.0, 1e-4) << "pixel " << idx;
+  }
+}
+}  // namespace
+
+class SoftwareMeshFilterTest : public testing::TestWithParam<double>
+{
+};
+
+TEST_P(SoftwareMeshFilterTest, FloatDepth)
+{
+  testPlane<float>(GetParam());
+}
+
+TEST_P(SoftwareMeshFilterTest, UnsignedShortDepth)
+{
+  testPlane<unsigned short>(GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(MeshDistances, SoftwareMeshFilterTest, testing::Range(0.0, 6.0, 0.5));
+
+TEST(SoftwareMeshFilter, RendersPaddedMesh)
+{
+  const double padding = 0.02;
+  SoftwareMeshFilter<StereoCameraModel> filter(
+      [](MeshHandle /*handle*/, Eigen::Isometry3d& transform) {
+        transform = Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.0, 1.0));
+        return true;
+      },
+      sensorParameters());
+  filter.setPaddingScale(0.0);
+  filter.setPaddingOffset(padding);
+
+  std::unique_ptr<shapes::Mesh> box(shapes::createMeshFromShape(shapes::Box(0.2, 0.2, 0.2)));
+  box->computeVertexNormals();
+  const MeshHandle handle = filter.addMesh(*box);
+
+  // the box is seen in front of a wall at 3m
+  std::vector<float> sensor_data(WIDTH * HEIGHT, 3.0f);
+  filter.filter(&sensor_data[0], MeshFilterInterface::FLOAT_DEPTH, true);
+
+  std::vector<double> model_depth(WIDTH * HEIGHT);
+  std::vector<LabelType> model_labels(WIDTH * HEIGHT);
+  std::vector<LabelType> filtered_labels(WIDTH * HEIGHT);
+  filter.getModelDepth(&model_depth[0]);
+  filter.getModelLabels(&model_labels[0]);
+  filter.getFilteredLabels(&filtered_labels[0]);
+
+  // the side of the box facing the camera is rendered, pulled closer by the padding along the vertex normals
+  const std::size_t center = (HEIGHT / 2) * WIDTH + WIDTH / 2;
+  EXPECT_LT(model_depth[center], 0.9);
+  EXPECT_GT(model_depth[center], 0.9 - padding - 1e-3);
+  EXPECT_EQ(model_labels[center], handle);
+  EXPECT_EQ(filtered_labels[center], MeshFilterInterface::SHADOW);
+
+  // the padded box spans 0.24m, i.e. less than 0.24 * 250 / 0.88 pixels around the center
+  EXPECT_EQ(model_labels[center + 70], static_cast<LabelType>(MeshFilterInterface::BACKGROUND));
+  EXPECT_EQ(model_depth[center + 70], 0.0);
+  EXPECT_EQ(filtered_labels[center + 70], static_cast<LabelType>(MeshFilterInterface::BACKGROUND));
+
+  filter.removeMesh(handle);
+  EXPECT_THROW(filter.removeMesh(handle), std::runtime_error);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -38,6 +38,7 @@
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <geometric_shapes/bodies.h>
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <map>
@@ -76,6 +77,13 @@ public:
   /** \brief Compute the containment mask (INSIDE or OUTSIDE) for a given pointcloud. If a mask element is INSIDE, the
      point
       is inside the robot. The point is outside if the mask element is OUTSIDE.
+
+      The points are processed in parallel chunks. Each chunk is copied into separate x, y and z arrays, points far
+      from all bodies are rejected with a coarse voxel grid of the body bounds and the remaining points are tested
+      against one body at a time. Spheres, boxes, cylinders and convex meshes are tested with vectorized expressions,
+      other bodies fall back to bodies::Body::containsPoint().
+      Convex meshes are tested against the hull of their scaled and padded vertices, which encloses the padded mesh
+      used by bodies::ConvexMesh::containsPoint().
   */
   void maskContainment(const sensor_msgs::msg::PointCloud2& data_in, const Eigen::Vector3d& sensor_pos,
                        const double min_sensor_dist, const double max_sensor_dist, std::vector<int>& mask);
@@ -99,6 +107,41 @@ protected:
     bodies::Body* body;
     ShapeHandle handle;
     double volume;
+
+    /** \brief Scaled and padded half extents of boxes, radius and half length (x, z) of cylinders */
+    Eigen::Vector3f extents;
+
+    /** \brief Face planes of convex meshes in the body frame, offset to the outermost scaled and padded vertex of
+        each face. The mesh is contained in these planes. Empty for other bodies. */
+    Eigen::Matrix4Xf planes;
+
+    /** \brief Face planes offset to the innermost scaled and padded vertex of each face, and the bounding box of
+        the scaled and padded vertices. The mesh contains the points within these planes, points between the two sets
+        of planes are tested with containsPoint(). Empty for other bodies. */
+    Eigen::Matrix4Xf inner_planes;
+  };
+
+  /** \brief A body in its pose for the current call of maskContainment() */
+  struct PosedBody
+  {
+    const SeeShape* shape;
+
+    /** \brief Transform from the frame of the cloud to the frame of the body */
+    Eigen::Matrix3f rotation;
+    Eigen::Vector3f translation;
+
+    Eigen::Vector3f center;
+    float radius_squared;
+  };
+
+  /** \brief Coarse grid over the bounding spheres of the bodies. Bit (i % 64) of a cell is set if the bounding sphere
+      of posed_bodies_[i] may overlap the cell. */
+  struct BodyGrid
+  {
+    Eigen::Vector3f origin;
+    Eigen::Array3f size;
+    float inv_resolution;
+    std::vector<std::uint64_t> cells;
   };
 
   struct SortBodies
@@ -115,15 +158,25 @@ protected:
 
   TransformCallback transform_callback_;
 
-  /** \brief Protects, bodies_ and bspheres_. All public methods acquire this mutex for their whole duration. */
+  /** \brief Protects, bodies_, bspheres_, posed_bodies_ and grid_. All public methods acquire this mutex for their
+      whole duration. */
   mutable std::mutex shapes_lock_;
   std::set<SeeShape, SortBodies> bodies_;
   std::vector<bodies::BoundingSphere> bspheres_;
+  std::vector<PosedBody> posed_bodies_;
+  BodyGrid grid_;
 
 private:
   /** \brief Free memory. */
   void freeMemory();
 
+  /** \brief Update the poses of the bodies, posed_bodies_ and grid_ */
+  void updateBodies();
+
+  /** \brief Compute the mask of \e count points starting at \e begin */
+  void maskChunk(const sensor_msgs::msg::PointCloud2& data_in, int begin, int count, double min_sensor_dist,
+                 double max_sensor_dist, std::vector<int>& mask) const;
+
   ShapeHandle next_handle_;
   ShapeHandle min_handle_;
   std::map<ShapeHandle, std::set<SeeShape, SortBodies>::iterator> used_handles_;
@@ -39,9 +39,108 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <rclcpp/logger.hpp>
 #include <rclcpp/logging.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit.ros.perception.shape_mask");
 
+namespace
+{
+// Number of points processed together, small enough for the buffers of a chunk to stay in cache
+constexpr int CHUNK_SIZE = 512;
+// Maximum number of cells of the body grid along each axis
+constexpr int GRID_CELLS = 32;
+
+typedef Eigen::Array<float, Eigen::Dynamic, 1, Eigen::ColMajor, CHUNK_SIZE, 1> ChunkArray;
+typedef Eigen::Array<bool, Eigen::Dynamic, 1, Eigen::ColMajor, CHUNK_SIZE, 1> ChunkMask;
+typedef Eigen::Array<int, Eigen::Dynamic, 1, Eigen::ColMajor, CHUNK_SIZE, 1> ChunkIndices;
+
+void computeExtents(const bodies::Body& body, Eigen::Vector3f& extents)
+{
+  const std::vector<double> dimensions = body.getDimensions();
+  const double scale = body.getScale();
+  const double padding = body.getPadding();
+  switch (body.getType())
+  {
+    case shapes::BOX:
+      for (int i = 0; i < 3; ++i)
+        extents[i] = dimensions[i] * scale / 2.0 + padding;
+      break;
+    case shapes::CYLINDER:
+      extents.x() = extents.y() = dimensions[0] * scale + padding;
+      extents.z() = dimensions[1] * scale / 2.0 + padding;
+      break;
+    default:
+      extents.setZero();
+  }
+}
+
+// Margin that moves the hull planes away from the mesh surface, so that float rounding leaves the classification of
+// points close to the surface to containsPoint()
+constexpr double HULL_MARGIN = 1e-5;
+
+void computeHullPlanes(const bodies::ConvexMesh& mesh, Eigen::Matrix4Xf& planes, Eigen::Matrix4Xf& inner_planes)
+{
+  const EigenSTL::vector_Vector4d& mesh_planes = mesh.getPlanes();
+  const EigenSTL::vector_Vector3d& vertices = mesh.getVertices();
+  const EigenSTL::vector_Vector3d& scaled_vertices = mesh.getScaledVertices();
+  if (mesh_planes.empty() || vertices.empty() || vertices.size() != scaled_vertices.size())
+  {
+    planes.resize(4, 0);
+    inner_planes.resize(4, 0);
+    return;
+  }
+
+  // Scaling and padding move the vertices of a face by different amounts along its normal unless the face is
+  // parallel to the padding directions, as for boxes. ConvexMesh passes each face plane through one of its scaled
+  // and padded vertices, the mesh therefore lies between the planes through the outermost and the innermost ones.
+  double vertex_tolerance = 0.0;
+  for (const Eigen::Vector3d& vertex : vertices)
+    vertex_tolerance = std::max(vertex_tolerance, vertex.cwiseAbs().maxCoeff());
+  vertex_tolerance = 1e-6 * std::max(vertex_tolerance, 1.0);
+
+  Eigen::AlignedBox3d bounds;
+  for (const Eigen::Vector3d& vertex : scaled_vertices)
+    bounds.extend(vertex);
+
+  planes.resize(4, mesh_planes.size());
+  inner_planes.resize(4, mesh_planes.size() + 6);
+  for (std::size_t i = 0; i < mesh_planes.size(); ++i)
+  {
+    const Eigen::Vector3d normal = mesh_planes[i].head<3>();
+    double outer = -std::numeric_limits<double>::infinity();
+    double inner = std::numeric_limits<double>::infinity();
+    for (std::size_t j = 0; j < vertices.size(); ++j)
+    {
+      if (std::abs(normal.dot(vertices[j]) + mesh_planes[i].w()) > vertex_tolerance)
+        continue;
+      const double offset = normal.dot(scaled_vertices[j]);
+      outer = std::max(outer, offset);
+      inner = std::min(inner, offset);
+    }
+    // a face without vertices leaves the classification to containsPoint()
+    if (outer < inner)
+    {
+      outer = std::numeric_limits<double>::infinity();
+      inner = -std::numeric_limits<double>::infinity();
+    }
+    planes.col(i) << normal.cast<float>(), static_cast<float>(-(outer + HULL_MARGIN));
+    inner_planes.col(i) << normal.cast<float>(), static_cast<float>(-(inner - HULL_MARGIN));
+  }
+
+  // ConvexMesh also rejects points outside the bounding box of the scaled and padded vertices
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const Eigen::Vector3f normal = Eigen::Vector3f::Unit(axis);
+    inner_planes.col(mesh_planes.size() + 2 * axis) << normal,
+        static_cast<float>(-(bounds.max()[axis] - HULL_MARGIN));
+    inner_planes.col(mesh_planes.size() + 2 * axis + 1) << -normal,
+        static_cast<float>(bounds.min()[axis] + HULL_MARGIN);
+  }
+}
+}  // namespace
+
 point_containment_filter::ShapeMask::ShapeMask(const TransformCallback& transform_callback)
   : transform_callback_(transform_callback), next_handle_(1), min_handle_(1)
 {
@@ -79,6 +178,9 @@ point_containment_filter::ShapeHandle point_containment_filter::ShapeMask::addSh
     ss.body->updateInternalData();
     ss.volume = ss.body->computeVolume();
     ss.handle = next_handle_;
+    computeExtents(*ss.body, ss.extents);
+    if (shape->type == shapes::MESH)
+      computeHullPlanes(*static_cast<const bodies::ConvexMesh*>(ss.body), ss.planes, ss.inner_planes);
     std::pair<std::set<SeeShape, SortBodies>::iterator, bool> insert_op = bodies_.insert(ss);
     if (!insert_op.second)
       RCLCPP_ERROR(LOGGER, "Internal error in management of bodies in ShapeMask. This is a serious error.");
@@ -132,62 +234,236 @@ void point_containment_filter::ShapeMask::maskContainment(const sensor_msgs::msg
   }
   else
   {
-    Eigen::Isometry3d tmp;
-    bspheres_.resize(bodies_.size());
-    std::size_t j = 0;
-    for (std::set<SeeShape>::const_iterator it = bodies_.begin(); it != bodies_.end(); ++it)
+    updateBodies();
+
+    // the chunks write disjoint parts of the mask
+    const int chunks = (static_cast<int>(np) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+#pragma omp parallel for schedule(static) if (chunks > 1)
+    for (int chunk = 0; chunk < chunks; ++chunk)
     {
-      if (!transform_callback_(it->handle, tmp))
+      const int begin = chunk * CHUNK_SIZE;
+      maskChunk(data_in, begin, std::min(CHUNK_SIZE, static_cast<int>(np) - begin), min_sensor_dist, max_sensor_dist,
+                mask);
+    }
+  }
+}
+
+void point_containment_filter::ShapeMask::updateBodies()
+{
+  Eigen::Isometry3d tmp;
+  bspheres_.resize(bodies_.size());
+  posed_bodies_.resize(bodies_.size());
+  std::size_t j = 0;
+  for (std::set<SeeShape>::const_iterator it = bodies_.begin(); it != bodies_.end(); ++it, ++j)
+  {
+    if (!transform_callback_(it->handle, tmp))
+    {
+      if (!it->body)
       {
-        if (!it->body)
-        {
-          RCLCPP_ERROR_STREAM(LOGGER, "Missing transform for shape with handle " << it->handle << " without a body");
-        }
-        else
-        {
-          RCLCPP_ERROR_STREAM(LOGGER,
-                              "Missing transform for shape " << it->body->getType() << " with handle " << it->handle);
-        }
+        RCLCPP_ERROR_STREAM(LOGGER, "Missing transform for shape with handle " << it->handle << " without a body");
       }
       else
       {
-        it->body->setPose(tmp);
-        it->body->computeBoundingSphere(bspheres_[j++]);
+        RCLCPP_ERROR_STREAM(LOGGER,
+                            "Missing transform for shape " << it->body->getType() << " with handle " << it->handle);
       }
     }
+    else
+      it->body->setPose(tmp);
 
-    // compute a sphere that bounds the entire robot
-    bodies::BoundingSphere bound;
-    bodies::mergeBoundingSpheres(bspheres_, bound);
-    const double radius_squared = bound.radius * bound.radius;
+    // bodies without a new transform are tested in their previous pose
+    it->body->computeBoundingSphere(bspheres_[j]);
+
+    PosedBody& posed = posed_bodies_[j];
+    const Eigen::Isometry3d& pose = it->body->getPose();
+    posed.shape = &*it;
+    posed.rotation = pose.linear().transpose().cast<float>();
+    posed.translation = -(pose.linear().transpose() * pose.translation()).cast<float>();
+    posed.center = bspheres_[j].center.cast<float>();
+    posed.radius_squared = static_cast<float>(bspheres_[j].radius * bspheres_[j].radius);
+  }
 
-    // we now decide which points we keep
-    sensor_msgs::PointCloud2ConstIterator<float> iter_x(data_in, "x");
-    sensor_msgs::PointCloud2ConstIterator<float> iter_y(data_in, "y");
-    sensor_msgs::PointCloud2ConstIterator<float> iter_z(data_in, "z");
+  // cover the bounding spheres of all bodies with a grid of at most GRID_CELLS^3 cells
+  Eigen::AlignedBox3f bounds;
+  for (const bodies::BoundingSphere& sphere : bspheres_)
+  {
+    const Eigen::Vector3f center = sphere.center.cast<float>();
+    const float radius = static_cast<float>(sphere.radius);
+    bounds.extend((center.array() - radius).matrix());
+    bounds.extend((center.array() + radius).matrix());
+  }
+  const float resolution = std::max(bounds.sizes().maxCoeff() / GRID_CELLS, std::numeric_limits<float>::min());
+  grid_.origin = bounds.min();
+  grid_.inv_resolution = 1.0f / resolution;
+  const Eigen::Array3i size =
+      (bounds.sizes().array() * grid_.inv_resolution).ceil().cast<int>().max(1).min(GRID_CELLS);
+  grid_.size = size.cast<float>();
+  grid_.cells.assign(size.prod(), 0);
 
-    // Cloud iterators are not incremented in the for loop, because of the pragma
-    // Comment out below parallelization as it can result in very high CPU consumption
-    //#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < static_cast<int>(np); ++i)
+  for (std::size_t i = 0; i < bspheres_.size(); ++i)
+  {
+    const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+    const float radius = static_cast<float>(bspheres_[i].radius);
+    const Eigen::Array3f center = bspheres_[i].center.cast<float>().array();
+    const Eigen::Array3i low = ((center - radius - grid_.origin.array()) * grid_.inv_resolution)
+                                   .floor()
+                                   .cast<int>()
+                                   .max(0)
+                                   .min(size - 1);
+    const Eigen::Array3i high = ((center + radius - grid_.origin.array()) * grid_.inv_resolution)
+                                    .floor()
+                                    .cast<int>()
+                                    .max(0)
+                                    .min(size - 1);
+    for (int z = low.z(); z <= high.z(); ++z)
+      for (int y = low.y(); y <= high.y(); ++y)
+        for (int x = low.x(); x <= high.x(); ++x)
+          grid_.cells[(z * size.y() + y) * size.x() + x] |= bit;
+  }
+}
+
+void point_containment_filter::ShapeMask::maskChunk(const sensor_msgs::msg::PointCloud2& data_in, int begin,
+                                                    int count, double min_sensor_dist, double max_sensor_dist,
+                                                    std::vector<int>& mask) const
+{
+  ChunkArray x(count), y(count), z(count);
+  typedef sensor_msgs::PointCloud2ConstIterator<float> CloudIterator;
+  CloudIterator iter_x = CloudIterator(data_in, "x") + begin;
+  CloudIterator iter_y = CloudIterator(data_in, "y") + begin;
+  CloudIterator iter_z = CloudIterator(data_in, "z") + begin;
+  for (int i = 0; i < count; ++i, ++iter_x, ++iter_y, ++iter_z)
+  {
+    x[i] = *iter_x;
+    y[i] = *iter_y;
+    z[i] = *iter_z;
+  }
+
+  // NaN points are neither clipped nor inside a cell, they remain OUTSIDE
+  const ChunkArray distance = (x.square() + y.square() + z.square()).sqrt();
+  const ChunkMask clip =
+      distance < static_cast<float>(min_sensor_dist) || distance > static_cast<float>(max_sensor_dist);
+  for (int i = 0; i < count; ++i)
+    mask[begin + i] = clip[i] ? CLIP : OUTSIDE;
+
+  // look up the bodies that may contain each point
+  const int size_x = static_cast<int>(grid_.size.x());
+  const int size_y = static_cast<int>(grid_.size.y());
+  const ChunkArray cell_x = (x - grid_.origin.x()) * grid_.inv_resolution;
+  const ChunkArray cell_y = (y - grid_.origin.y()) * grid_.inv_resolution;
+  const ChunkArray cell_z = (z - grid_.origin.z()) * grid_.inv_resolution;
+  const ChunkMask in_grid = !clip && cell_x >= 0.0f && cell_x < grid_.size.x() && cell_y >= 0.0f &&
+                            cell_y < grid_.size.y() && cell_z >= 0.0f && cell_z < grid_.size.z();
+
+  std::uint64_t candidates[CHUNK_SIZE];
+  int pending[CHUNK_SIZE];
+  int pending_count = 0;
+  std::uint64_t chunk_candidates = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    if (!in_grid[i])
+      continue;
+    const int cell =
+        (static_cast<int>(cell_z[i]) * size_y + static_cast<int>(cell_y[i])) * size_x + static_cast<int>(cell_x[i]);
+    if (grid_.cells[cell] == 0)
+      continue;
+    candidates[i] = grid_.cells[cell];
+    chunk_candidates |= candidates[i];
+    pending[pending_count++] = i;
+  }
+
+  // test the pending points against one body at a time, in order of decreasing volume
+  ChunkIndices index(count);
+  ChunkArray px(count), py(count), pz(count);
+  for (std::size_t b = 0; b < posed_bodies_.size() && pending_count > 0; ++b)
+  {
+    const std::uint64_t bit = std::uint64_t(1) << (b % 64);
+    if (!(chunk_candidates & bit))
+      continue;
+    const PosedBody& posed = posed_bodies_[b];
+
+    // gather the pending points within the bounding sphere
+    int n = 0;
+    for (int k = 0; k < pending_count; ++k)
     {
-      Eigen::Vector3d pt = Eigen::Vector3d(*(iter_x + i), *(iter_y + i), *(iter_z + i));
-      double d = pt.norm();
-      int out = OUTSIDE;
-      if (d < min_sensor_dist || d > max_sensor_dist)
-      {
-        out = CLIP;
-      }
-      else if ((bound.center - pt).squaredNorm() < radius_squared)
-      {
-        for (std::set<SeeShape>::const_iterator it = bodies_.begin(); it != bodies_.end() && out == OUTSIDE; ++it)
+      const int i = pending[k];
+      if (!(candidates[i] & bit) ||
+          (Eigen::Vector3f(x[i], y[i], z[i]) - posed.center).squaredNorm() > posed.radius_squared)
+        continue;
+      index[n] = i;
+      px[n] = x[i];
+      py[n] = y[i];
+      pz[n] = z[i];
+      ++n;
+    }
+    if (n == 0)
+      continue;
+
+    const Eigen::Matrix3f& r = posed.rotation;
+    const Eigen::Vector3f& t = posed.translation;
+    const Eigen::Vector3f& e = posed.shape->extents;
+    const auto lx = px.head(n) * r(0, 0) + py.head(n) * r(0, 1) + pz.head(n) * r(0, 2) + t.x();
+    const auto ly = px.head(n) * r(1, 0) + py.head(n) * r(1, 1) + pz.head(n) * r(1, 2) + t.y();
+    const auto lz = px.head(n) * r(2, 0) + py.head(n) * r(2, 1) + pz.head(n) * r(2, 2) + t.z();
+
+    ChunkMask inside(n);
+    switch (posed.shape->body->getType())
+    {
+      case shapes::SPHERE:
+        // the bounding sphere is the body
+        inside.setConstant(true);
+        break;
+      case shapes::BOX:
+        inside = lx.abs() <= e.x() && ly.abs() <= e.y() && lz.abs() <= e.z();
+        break;
+      case shapes::CYLINDER:
+        inside = lz.abs() <= e.z() && (lx.square() + ly.square()) < e.x() * e.x();
+        break;
+      default:
+        if (posed.shape->planes.cols() > 0)
+        {
+          const ChunkArray mx = lx, my = ly, mz = lz;
+          inside.setConstant(true);
+          for (Eigen::Index p = 0; p < posed.shape->planes.cols() && inside.any(); ++p)
+          {
+            const Eigen::Vector4f& plane = posed.shape->planes.col(p);
+            inside = inside && (mx * plane.x() + my * plane.y() + mz * plane.z() + plane.w()) <= 0.0f;
+          }
+          if (!inside.any())
+            break;
+
+          // points within the outer planes but not within the inner ones are close to the surface
+          ChunkMask certain = inside;
+          for (Eigen::Index p = 0; p < posed.shape->inner_planes.cols() && certain.any(); ++p)
+          {
+            const Eigen::Vector4f& plane = posed.shape->inner_planes.col(p);
+            certain = certain && (mx * plane.x() + my * plane.y() + mz * plane.z() + plane.w()) <= 0.0f;
+          }
+          for (int k = 0; k < n; ++k)
+          {
+            if (inside[k] && !certain[k])
+              inside[k] = posed.shape->body->containsPoint(Eigen::Vector3d(px[k], py[k], pz[k]));
+          }
+        }
+        else
         {
-          if (it->body->containsPoint(pt))
-            out = INSIDE;
+          for (int k = 0; k < n; ++k)
+            inside[k] = posed.shape->body->containsPoint(Eigen::Vector3d(px[k], py[k], pz[k]));
         }
+    }
+
+    // points inside a body need no further tests
+    if (!inside.any())
+      continue;
+    for (int k = 0; k < n; ++k)
+    {
+      if (inside[k])
+      {
+        mask[begin + index[k]] = INSIDE;
+        candidates[index[k]] = 0;
       }
-      mask[i] = out;
     }
+    pending_count =
+        std::remove_if(pending, pending + pending_count, [&candidates](int i) { return candidates[i] == 0; }) - pending;
   }
 }
 
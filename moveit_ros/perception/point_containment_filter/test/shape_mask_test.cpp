@@ -0,0 +1,200 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/point_containment_filter/shape_mask.h>
+#include <geometric_shapes/shapes.h>
+#include <geometric_shapes/shape_operations.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using point_containment_filter::ShapeHandle;
+using point_containment_filter::ShapeMask;
+
+namespace
+{
+// a cloud of uniformly distributed points in [-extent, extent]^3, every 100th point is NaN
+sensor_msgs::msg::PointCloud2 createCloud(std::size_t size, float extent)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(size);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-extent, extent);
+  sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+  for (std::size_t i = 0; i < size; ++i, ++iter_x, ++iter_y, ++iter_z)
+  {
+    *iter_x = distribution(generator);
+    *iter_y = distribution(generator);
+    *iter_z = i % 100 == 99 ? std::numeric_limits<float>::quiet_NaN() : distribution(generator);
+  }
+  return cloud;
+}
+
+Eigen::Isometry3d createPose(double x, double y, double z, double angle, const Eigen::Vector3d& axis)
+{
+  return Eigen::Translation3d(x, y, z) * Eigen::AngleAxisd(angle, axis.normalized());
+}
+}  // namespace
+
+class ShapeMaskTest : public testing::Test
+{
+protected:
+  ShapeMaskTest()
+    : mask_([this](ShapeHandle handle, Eigen::Isometry3d& pose) {
+      auto it = poses_.find(handle);
+      if (it == poses_.end())
+        return false;
+      pose = it->second;
+      return true;
+    })
+  {
+  }
+
+  void addShape(shapes::Shape* shape, const Eigen::Isometry3d& pose, double scale = 1.0, double padding = 0.0)
+  {
+    ShapeHandle handle = mask_.addShape(shapes::ShapeConstPtr(shape), scale, padding);
+    ASSERT_NE(handle, 0u);
+    poses_[handle] = pose;
+  }
+
+  // compare the batched mask with the classification of each point on its own
+  void expectMatchingPointQueries(const sensor_msgs::msg::PointCloud2& cloud, double min_sensor_dist,
+                                  double max_sensor_dist)
+  {
+    std::vector<int> mask;
+    mask_.maskContainment(cloud, Eigen::Vector3d::Zero(), min_sensor_dist, max_sensor_dist, mask);
+    ASSERT_EQ(mask.size(), cloud.width * cloud.height);
+
+    sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+    std::size_t inside = 0;
+    for (std::size_t i = 0; i < mask.size(); ++i, ++iter_x, ++iter_y, ++iter_z)
+    {
+      const Eigen::Vector3d point(*iter_x, *iter_y, *iter_z);
+      const double distance = point.norm();
+      int expected = ShapeMask::CLIP;
+      if (!(distance < min_sensor_dist || distance > max_sensor_dist))
+        expected = mask_.getMaskContainment(point);
+      EXPECT_EQ(mask[i], expected) << "point " << i << ": " << point.transpose();
+      inside += mask[i] == ShapeMask::INSIDE;
+    }
+    // make sure the bodies are actually hit
+    EXPECT_GT(inside, mask.size() / 100);
+  }
+
+  std::map<ShapeHandle, Eigen::Isometry3d> poses_;
+  ShapeMask mask_;
+};
+
+TEST_F(ShapeMaskTest, NoShapes)
+{
+  std::vector<int> mask;
+  mask_.maskContainment(createCloud(1000, 1.0f), Eigen::Vector3d::Zero(), 0.0, 10.0, mask);
+  ASSERT_EQ(mask.size(), 1000u);
+  for (int value : mask)
+    EXPECT_EQ(value, ShapeMask::OUTSIDE);
+}
+
+TEST_F(ShapeMaskTest, Primitives)
+{
+  addShape(new shapes::Sphere(0.3), createPose(0.5, 0.2, -0.1, 0.0, Eigen::Vector3d::UnitZ()), 1.0, 0.05);
+  addShape(new shapes::Box(0.4, 0.2, 0.6), createPose(-0.4, 0.3, 0.2, 0.7, Eigen::Vector3d(1, 2, 3)), 1.2, 0.02);
+  addShape(new shapes::Cylinder(0.15, 0.8), createPose(0.1, -0.5, 0.3, 1.1, Eigen::Vector3d(-1, 0, 1)), 0.9, 0.03);
+  expectMatchingPointQueries(createCloud(20000, 1.0f), 0.2, 1.4);
+}
+
+TEST_F(ShapeMaskTest, ConvexMesh)
+{
+  std::unique_ptr<shapes::Mesh> mesh(shapes::createMeshFromShape(shapes::Box(0.5, 0.3, 0.4)));
+  addShape(mesh.release(), createPose(0.2, 0.1, -0.2, 0.4, Eigen::Vector3d(0, 1, 1)), 1.1, 0.02);
+  expectMatchingPointQueries(createCloud(20000, 1.0f), 0.0, 10.0);
+}
+
+TEST_F(ShapeMaskTest, NonBoxConvexMesh)
+{
+  // a pyramid with an off-center apex, the padding moves the vertices of its faces by different amounts along the
+  // face normals, unlike those of a box
+  auto mesh = std::make_unique<shapes::Mesh>(5, 6);
+  const double vertices[] = { -0.3, -0.2, -0.2, 0.3, -0.2, -0.2, 0.3, 0.2, -0.2, -0.3, 0.2, -0.2, 0.1, 0.05, 0.35 };
+  const unsigned int triangles[] = { 0, 2, 1, 0, 3, 2, 0, 1, 4, 1, 2, 4, 2, 3, 4, 3, 0, 4 };
+  std::copy(std::begin(vertices), std::end(vertices), mesh->vertices);
+  std::copy(std::begin(triangles), std::end(triangles), mesh->triangles);
+  addShape(mesh.release(), createPose(-0.1, 0.2, 0.1, 0.6, Eigen::Vector3d(1, -1, 2)), 1.3, 0.08);
+  expectMatchingPointQueries(createCloud(50000, 1.0f), 0.0, 10.0);
+}
+
+TEST_F(ShapeMaskTest, ManyBodies)
+{
+  // more bodies than bits in a cell of the body grid
+  for (int i = 0; i < 150; ++i)
+  {
+    const double angle = 0.1 * i;
+    addShape(new shapes::Sphere(0.02 + 0.0005 * i),
+             createPose(0.8 * std::cos(angle), 0.8 * std::sin(angle), 0.005 * i - 0.4, 0.0, Eigen::Vector3d::UnitZ()));
+  }
+  expectMatchingPointQueries(createCloud(50000, 1.0f), 0.0, 10.0);
+}
+
+TEST_F(ShapeMaskTest, MissingTransform)
+{
+  addShape(new shapes::Box(0.5, 0.5, 0.5), createPose(0.3, 0.0, 0.0, 0.0, Eigen::Vector3d::UnitZ()));
+  addShape(new shapes::Sphere(0.3), createPose(-0.3, 0.0, 0.0, 0.0, Eigen::Vector3d::UnitZ()));
+  const sensor_msgs::msg::PointCloud2 cloud = createCloud(10000, 1.0f);
+  std::vector<int> mask;
+  mask_.maskContainment(cloud, Eigen::Vector3d::Zero(), 0.0, 10.0, mask);
+
+  // bodies without a transform stay in their previous pose
+  poses_.clear();
+  std::vector<int> previous_mask;
+  mask_.maskContainment(cloud, Eigen::Vector3d::Zero(), 0.0, 10.0, previous_mask);
+  EXPECT_EQ(mask, previous_mask);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
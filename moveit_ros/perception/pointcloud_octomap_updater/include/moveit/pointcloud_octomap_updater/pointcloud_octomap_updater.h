@@ -37,6 +37,7 @@
 #pragma once
 
 #include <rclcpp/rclcpp.hpp>
+#include <tf2/LinearMath/Transform.h>
 #include <tf2_ros/transform_listener.h>
 #include <tf2_ros/message_filter.h>
 #include <message_filters/subscriber.h>
@@ -44,7 +45,9 @@
 #include <moveit/occupancy_map_monitor/occupancy_map_updater.h>
 #include <moveit/point_containment_filter/shape_mask.h>
 
+#include <chrono>
 #include <memory>
+#include <vector>
 
 namespace occupancy_map_monitor
 {
@@ -65,11 +68,12 @@ public:
 protected:
   virtual void updateMask(const sensor_msgs::msg::PointCloud2& cloud, const Eigen::Vector3d& sensor_origin,
                           std::vector<int>& mask);
+  void cloudMsgCallback(const sensor_msgs::msg::PointCloud2::ConstSharedPtr& cloud_msg);
 
 private:
   bool getShapeTransform(ShapeHandle h, Eigen::Isometry3d& transform) const;
-  void cloudMsgCallback(const sensor_msgs::msg::PointCloud2::ConstSharedPtr& cloud_msg);
   void stopHelper();
+  void reportThroughput(std::size_t num_points, std::chrono::steady_clock::duration processing_time);
 
   // TODO: Enable private node for publishing filtered point cloud
   // ros::NodeHandle root_nh_;
@@ -89,6 +93,7 @@ private:
   double max_range_;
   unsigned int point_subsample_;
   double max_update_rate_;
+  double throughput_report_period_;
   std::string filtered_cloud_topic_;
   std::string ns_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr filtered_cloud_publisher_;
@@ -96,9 +101,20 @@ private:
   message_filters::Subscriber<sensor_msgs::msg::PointCloud2>* point_cloud_subscriber_;
   tf2_ros::MessageFilter<sensor_msgs::msg::PointCloud2>* point_cloud_filter_;
 
-  /* used to store all cells in the map which a given ray passes through during raycasting.
-     we cache this here because it dynamically pre-allocates a lot of memory in its constructor */
-  octomap::KeyRay key_ray_;
+  /* used to store all cells in the map which a given ray passes through during raycasting, one per thread.
+     we cache these here because they dynamically pre-allocate a lot of memory in their constructor */
+  std::vector<octomap::KeyRay> key_rays_;
+
+  /* the cells at the ends of the rays, and the free cells found by each ray casting thread as Morton codes */
+  std::vector<octomap::OcTreeKey> ray_end_cells_;
+  std::vector<std::vector<uint64_t>> thread_free_cells_;
+  std::vector<uint64_t> free_cells_;
+
+  /* processing statistics since the last throughput report */
+  std::size_t reported_clouds_;
+  std::size_t reported_points_;
+  std::chrono::steady_clock::duration reported_processing_time_;
+  std::chrono::steady_clock::time_point last_report_time_;
 
   std::unique_ptr<point_containment_filter::ShapeMask> shape_mask_;
   std::vector<int> mask_;
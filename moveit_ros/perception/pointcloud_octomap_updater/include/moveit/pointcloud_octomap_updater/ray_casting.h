@@ -0,0 +1,69 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <octomap/OcTree.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace occupancy_map_monitor
+{
+/** \brief Interleaves the bits of the key coordinates. Cells in the same octree node have codes with the same prefix,
+ * so updating the cells in the order of their codes descends into the same branches of the tree one after the other.
+ */
+uint64_t keyToMortonCode(const octomap::OcTreeKey& key);
+
+/** \brief The inverse of keyToMortonCode(). */
+octomap::OcTreeKey mortonCodeToKey(uint64_t code);
+
+/** \brief The Morton codes of the keys, sorted. */
+std::vector<uint64_t> sortedMortonCodes(const octomap::KeySet& keys);
+
+/** \brief Casts the rays from the origin to the ray end cells in parallel.
+ *
+ * Each thread collects the Morton codes of the cells its rays traverse on its own, so the codes of a cell may appear
+ * several times and in any order. An exception thrown while casting a ray is rethrown once all threads are done.
+ * @param tree The tree the keys belong to, it is only read.
+ * @param origin The origin of all rays.
+ * @param ray_end_cells The cells at the ends of the rays.
+ * @param num_threads The maximum number of threads to use.
+ * @param key_rays The buffers of the rays, one per thread, resized as needed.
+ * @param thread_cells The traversed cells, one vector per thread, resized as needed and cleared first.
+ */
+void castRays(const octomap::OcTree& tree, const octomap::point3d& origin,
+              const std::vector<octomap::OcTreeKey>& ray_end_cells, int num_threads,
+              std::vector<octomap::KeyRay>& key_rays, std::vector<std::vector<uint64_t>>& thread_cells);
+}  // namespace occupancy_map_monitor
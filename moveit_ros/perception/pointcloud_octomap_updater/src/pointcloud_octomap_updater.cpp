@@ -36,6 +36,7 @@
 
 #include <cmath>
 #include <moveit/pointcloud_octomap_updater/pointcloud_octomap_updater.h>
+#include <moveit/pointcloud_octomap_updater/ray_casting.h>
 #include <moveit/occupancy_map_monitor/occupancy_map_monitor.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <tf2/LinearMath/Vector3.h>
@@ -44,11 +45,15 @@
 #include <tf2_ros/create_timer_interface.h>
 #include <tf2_ros/create_timer_ros.h>
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <omp.h>
 
 namespace occupancy_map_monitor
 {
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit.ros.perception.pointcloud_octomap_updater");
+
 PointCloudOctomapUpdater::PointCloudOctomapUpdater()
   : OccupancyMapUpdater("PointCloudUpdater")
   , scale_(1.0)
@@ -56,8 +61,12 @@ PointCloudOctomapUpdater::PointCloudOctomapUpdater()
   , max_range_(std::numeric_limits<double>::infinity())
   , point_subsample_(1)
   , max_update_rate_(0)
+  , throughput_report_period_(0.0)
   , point_cloud_subscriber_(nullptr)
   , point_cloud_filter_(nullptr)
+  , reported_clouds_(0)
+  , reported_points_(0)
+  , reported_processing_time_(0)
 {
 }
 
@@ -70,6 +79,7 @@ bool PointCloudOctomapUpdater::setParams(const std::string& name_space)
 {
   // This parameter is optional
   node_->get_parameter_or(name_space + ".ns", ns_, std::string());
+  node_->get_parameter_or(name_space + ".throughput_report_period", throughput_report_period_, 0.0);
   return node_->get_parameter(name_space + ".point_cloud_topic", point_cloud_topic_) &&
          node_->get_parameter(name_space + ".max_range", max_range_) &&
          node_->get_parameter(name_space + ".padding_offset", padding_) &&
@@ -177,10 +187,37 @@ void PointCloudOctomapUpdater::updateMask(const sensor_msgs::msg::PointCloud2& /
 {
 }
 
+void PointCloudOctomapUpdater::reportThroughput(std::size_t num_points,
+                                                std::chrono::steady_clock::duration processing_time)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (last_report_time_ == std::chrono::steady_clock::time_point())
+    last_report_time_ = now;
+
+  ++reported_clouds_;
+  reported_points_ += num_points;
+  reported_processing_time_ += processing_time;
+
+  const double elapsed = std::chrono::duration<double>(now - last_report_time_).count();
+  if (elapsed < throughput_report_period_)
+    return;
+
+  const double processing_seconds = std::chrono::duration<double>(reported_processing_time_).count();
+  RCLCPP_INFO(LOGGER,
+              "Processed %zu point clouds in the last %.1f s: %.1f ms per cloud, %.1f clouds/s and %.2f Mpoints/s "
+              "of processing time",
+              reported_clouds_, elapsed, 1000.0 * processing_seconds / reported_clouds_,
+              reported_clouds_ / processing_seconds, 1e-6 * reported_points_ / processing_seconds);
+  reported_clouds_ = 0;
+  reported_points_ = 0;
+  reported_processing_time_ = std::chrono::steady_clock::duration(0);
+  last_report_time_ = now;
+}
+
 void PointCloudOctomapUpdater::cloudMsgCallback(const sensor_msgs::msg::PointCloud2::ConstSharedPtr& cloud_msg)
 {
   RCLCPP_DEBUG(LOGGER, "Received a new point cloud message");
-  rclcpp::Time start = rclcpp::Clock(RCL_ROS_TIME).now();
+  const auto start = std::chrono::steady_clock::now();
 
   if (max_update_rate_ > 0)
   {
@@ -231,7 +268,7 @@ void PointCloudOctomapUpdater::cloudMsgCallback(const sensor_msgs::msg::PointClo
   shape_mask_->maskContainment(*cloud_msg, sensor_origin_eigen, 0.0, max_range_, mask_);
   updateMask(*cloud_msg, sensor_origin_eigen, mask_);
 
-  octomap::KeySet free_cells, occupied_cells, model_cells, clip_cells;
+  octomap::KeySet occupied_cells, model_cells, clip_cells;
   std::unique_ptr<sensor_msgs::msg::PointCloud2> filtered_cloud;
 
   // We only use these iterators if we are creating a filtered_cloud for
@@ -312,26 +349,15 @@ void PointCloudOctomapUpdater::cloudMsgCallback(const sensor_msgs::msg::PointClo
       }
     }
 
-    /* compute the free cells along each ray that ends at an occupied cell */
-    for (const octomap::OcTreeKey& occupied_cell : occupied_cells)
-    {
-      if (tree_->computeRayKeys(sensor_origin, tree_->keyToCoord(occupied_cell), key_ray_))
-        free_cells.insert(key_ray_.begin(), key_ray_.end());
-    }
-
-    /* compute the free cells along each ray that ends at a model cell */
-    for (const octomap::OcTreeKey& model_cell : model_cells)
-    {
-      if (tree_->computeRayKeys(sensor_origin, tree_->keyToCoord(model_cell), key_ray_))
-        free_cells.insert(key_ray_.begin(), key_ray_.end());
-    }
+    /* the free cells are the cells along each ray that ends at an occupied, model or clipped cell */
+    ray_end_cells_.clear();
+    ray_end_cells_.reserve(occupied_cells.size() + model_cells.size() + clip_cells.size());
+    ray_end_cells_.insert(ray_end_cells_.end(), occupied_cells.begin(), occupied_cells.end());
+    ray_end_cells_.insert(ray_end_cells_.end(), model_cells.begin(), model_cells.end());
+    ray_end_cells_.insert(ray_end_cells_.end(), clip_cells.begin(), clip_cells.end());
 
-    /* compute the free cells along each ray that ends at a clipped cell */
-    for (const octomap::OcTreeKey& clip_cell : clip_cells)
-    {
-      if (tree_->computeRayKeys(sensor_origin, tree_->keyToCoord(clip_cell), key_ray_))
-        free_cells.insert(key_ray_.begin(), key_ray_.end());
-    }
+    /* cast the rays in parallel, each thread collects the cells it traverses on its own */
+    castRays(*tree_, sensor_origin, ray_end_cells_, omp_get_max_threads(), key_rays_, thread_free_cells_);
   }
   catch (...)
   {
@@ -341,37 +367,55 @@ void PointCloudOctomapUpdater::cloudMsgCallback(const sensor_msgs::msg::PointClo
 
   tree_->unlockRead();
 
+  /* merge the cells of all threads, sorted and without duplicates */
+  std::size_t num_free_cells = 0;
+  for (const std::vector<uint64_t>& cells : thread_free_cells_)
+    num_free_cells += cells.size();
+  free_cells_.clear();
+  free_cells_.reserve(num_free_cells);
+  for (const std::vector<uint64_t>& cells : thread_free_cells_)
+    free_cells_.insert(free_cells_.end(), cells.begin(), cells.end());
+  std::sort(free_cells_.begin(), free_cells_.end());
+  free_cells_.erase(std::unique(free_cells_.begin(), free_cells_.end()), free_cells_.end());
+
   /* cells that overlap with the model are not occupied */
   for (const octomap::OcTreeKey& model_cell : model_cells)
     occupied_cells.erase(model_cell);
+  const std::vector<uint64_t> sorted_occupied_cells = sortedMortonCodes(occupied_cells);
+  const std::vector<uint64_t> sorted_model_cells = sortedMortonCodes(model_cells);
 
   /* occupied cells are not free */
-  for (const octomap::OcTreeKey& occupied_cell : occupied_cells)
-    free_cells.erase(occupied_cell);
+  free_cells_.erase(std::set_difference(free_cells_.begin(), free_cells_.end(), sorted_occupied_cells.begin(),
+                                        sorted_occupied_cells.end(), free_cells_.begin()),
+                    free_cells_.end());
 
   tree_->lockWrite();
 
   try
   {
     /* mark free cells only if not seen occupied in this cloud */
-    for (const octomap::OcTreeKey& free_cell : free_cells)
-      tree_->updateNode(free_cell, false);
+    for (const uint64_t free_cell : free_cells_)
+      tree_->updateNode(mortonCodeToKey(free_cell), false);
 
     /* now mark all occupied cells */
-    for (const octomap::OcTreeKey& occupied_cell : occupied_cells)
-      tree_->updateNode(occupied_cell, true);
+    for (const uint64_t occupied_cell : sorted_occupied_cells)
+      tree_->updateNode(mortonCodeToKey(occupied_cell), true);
 
     // set the logodds to the minimum for the cells that are part of the model
     const float lg = tree_->getClampingThresMinLog() - tree_->getClampingThresMaxLog();
-    for (const octomap::OcTreeKey& model_cell : model_cells)
-      tree_->updateNode(model_cell, lg);
+    for (const uint64_t model_cell : sorted_model_cells)
+      tree_->updateNode(mortonCodeToKey(model_cell), lg);
   }
   catch (...)
   {
     RCLCPP_ERROR(LOGGER, "Internal error while updating octree");
   }
   tree_->unlockWrite();
-  RCLCPP_DEBUG(LOGGER, "Processed point cloud in %lf ms", (node_->now() - start).seconds() * 1000.0);
+  const auto processing_time = std::chrono::steady_clock::now() - start;
+  RCLCPP_DEBUG(LOGGER, "Processed point cloud in %lf ms",
+               std::chrono::duration<double, std::milli>(processing_time).count());
+  if (throughput_report_period_ > 0.0)
+    reportThroughput(cloud_msg->width * cloud_msg->height, processing_time);
   tree_->triggerUpdateCallback();
 
   if (filtered_cloud)
@@ -0,0 +1,136 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/pointcloud_octomap_updater/ray_casting.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <omp.h>
+
+namespace occupancy_map_monitor
+{
+namespace
+{
+// Spreads the 16 bits of a key coordinate so that two zero bits follow each of them.
+uint64_t spreadBits(uint64_t value)
+{
+  value = (value | (value << 16)) & 0x0000ff0000ffULL;
+  value = (value | (value << 8)) & 0x00f00f00f00fULL;
+  value = (value | (value << 4)) & 0x0c30c30c30c3ULL;
+  value = (value | (value << 2)) & 0x249249249249ULL;
+  return value;
+}
+
+uint64_t compactBits(uint64_t value)
+{
+  value &= 0x249249249249ULL;
+  value = (value | (value >> 2)) & 0x0c30c30c30c3ULL;
+  value = (value | (value >> 4)) & 0x00f00f00f00fULL;
+  value = (value | (value >> 8)) & 0x0000ff0000ffULL;
+  value = (value | (value >> 16)) & 0x00000000ffffULL;
+  return value;
+}
+}  // namespace
+
+uint64_t keyToMortonCode(const octomap::OcTreeKey& key)
+{
+  return spreadBits(key[0]) | (spreadBits(key[1]) << 1) | (spreadBits(key[2]) << 2);
+}
+
+octomap::OcTreeKey mortonCodeToKey(uint64_t code)
+{
+  return octomap::OcTreeKey(compactBits(code), compactBits(code >> 1), compactBits(code >> 2));
+}
+
+std::vector<uint64_t> sortedMortonCodes(const octomap::KeySet& keys)
+{
+  std::vector<uint64_t> codes;
+  codes.reserve(keys.size());
+  for (const octomap::OcTreeKey& key : keys)
+    codes.push_back(keyToMortonCode(key));
+  std::sort(codes.begin(), codes.end());
+  return codes;
+}
+
+void castRays(const octomap::OcTree& tree, const octomap::point3d& origin,
+              const std::vector<octomap::OcTreeKey>& ray_end_cells, int num_threads,
+              std::vector<octomap::KeyRay>& key_rays, std::vector<std::vector<uint64_t>>& thread_cells)
+{
+  const std::size_t max_threads = std::max(num_threads, 1);
+  if (key_rays.size() < max_threads)
+    key_rays.resize(max_threads);
+  if (thread_cells.size() < max_threads)
+    thread_cells.resize(max_threads);
+  for (std::vector<uint64_t>& cells : thread_cells)
+    cells.clear();
+
+  // An exception must not leave the parallel region, so the first one is kept and the remaining rays are skipped.
+  std::exception_ptr error;
+  std::atomic<bool> failed(false);
+
+  const long num_rays = static_cast<long>(ray_end_cells.size());
+#pragma omp parallel num_threads(max_threads)
+  {
+    octomap::KeyRay& key_ray = key_rays[omp_get_thread_num()];
+    std::vector<uint64_t>& cells = thread_cells[omp_get_thread_num()];
+#pragma omp for schedule(dynamic, 64)
+    for (long i = 0; i < num_rays; ++i)
+    {
+      if (failed.load(std::memory_order_relaxed))
+        continue;
+      try
+      {
+        if (tree.computeRayKeys(origin, tree.keyToCoord(ray_end_cells[i]), key_ray))
+        {
+          for (const octomap::OcTreeKey& key : key_ray)
+            cells.push_back(keyToMortonCode(key));
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical(cast_rays_error)
+        {
+          if (!error)
+            error = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+}  // namespace occupancy_map_monitor
@@ -0,0 +1,179 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/pointcloud_octomap_updater/pointcloud_octomap_updater.h>
+#include <moveit/occupancy_map_monitor/occupancy_map_monitor.h>
+#include <geometric_shapes/shapes.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <tf2_ros/buffer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using occupancy_map_monitor::OccupancyMapMonitor;
+
+namespace
+{
+// a map of 0.1 m leaves in the frame of the clouds, without sensor plugins or services
+class TestMiddlewareHandle : public OccupancyMapMonitor::MiddlewareHandle
+{
+public:
+  OccupancyMapMonitor::Parameters getParameters() const override
+  {
+    return { 0.1, "map", {} };
+  }
+  occupancy_map_monitor::OccupancyMapUpdaterPtr loadOccupancyMapUpdater(const std::string& /*sensor_plugin*/) override
+  {
+    return nullptr;
+  }
+  void initializeOccupancyMapUpdater(occupancy_map_monitor::OccupancyMapUpdaterPtr /*occupancy_map_updater*/) override
+  {
+  }
+  void createSaveMapService(SaveMapServiceCallback /*callback*/) override
+  {
+  }
+  void createLoadMapService(LoadMapServiceCallback /*callback*/) override
+  {
+  }
+};
+
+// processes clouds directly instead of subscribing to them
+class TestPointCloudOctomapUpdater : public occupancy_map_monitor::PointCloudOctomapUpdater
+{
+public:
+  using PointCloudOctomapUpdater::cloudMsgCallback;
+};
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr createCloud(const std::vector<Eigen::Vector3f>& points)
+{
+  auto cloud = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  cloud->header.frame_id = "map";
+  sensor_msgs::PointCloud2Modifier modifier(*cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(points.size());
+  sensor_msgs::PointCloud2Iterator<float> iter_x(*cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(*cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(*cloud, "z");
+  for (const Eigen::Vector3f& point : points)
+  {
+    *iter_x = point.x();
+    *iter_y = point.y();
+    *iter_z = point.z();
+    ++iter_x;
+    ++iter_y;
+    ++iter_z;
+  }
+  return cloud;
+}
+}  // namespace
+
+class PointCloudOctomapUpdaterTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("pointcloud_octomap_updater_test",
+                                           rclcpp::NodeOptions()
+                                               .automatically_declare_parameters_from_overrides(true)
+                                               .parameter_overrides({ { "sensor.point_cloud_topic", "points" },
+                                                                      { "sensor.max_range", 5.0 },
+                                                                      { "sensor.padding_offset", 0.0 },
+                                                                      { "sensor.padding_scale", 1.0 },
+                                                                      { "sensor.point_subsample", 1 },
+                                                                      { "sensor.max_update_rate", 0.0 },
+                                                                      { "sensor.filtered_cloud_topic", "" } }));
+    monitor_ = std::make_unique<OccupancyMapMonitor>(std::make_unique<TestMiddlewareHandle>(),
+                                                     std::make_shared<tf2_ros::Buffer>(node_->get_clock()));
+    updater_.setMonitor(monitor_.get());
+    ASSERT_TRUE(updater_.initialize(node_));
+    ASSERT_TRUE(updater_.setParams("sensor"));
+    updater_.setTransformCacheCallback(
+        [this](const std::string& /*target_frame*/, const rclcpp::Time& /*target_time*/,
+               occupancy_map_monitor::ShapeTransformCache& cache) {
+          cache = robot_poses_;
+          return true;
+        });
+  }
+
+  void addRobotBox(const Eigen::Vector3d& size, const Eigen::Vector3d& position)
+  {
+    const occupancy_map_monitor::ShapeHandle handle =
+        updater_.excludeShape(std::make_shared<shapes::Box>(size.x(), size.y(), size.z()));
+    ASSERT_NE(handle, 0u);
+    robot_poses_[handle] = Eigen::Isometry3d(Eigen::Translation3d(position));
+  }
+
+  const octomap::OcTreeNode* search(double x, double y, double z) const
+  {
+    return monitor_->getOcTreePtr()->search(x, y, z);
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  std::unique_ptr<OccupancyMapMonitor> monitor_;
+  TestPointCloudOctomapUpdater updater_;
+  occupancy_map_monitor::ShapeTransformCache robot_poses_;
+};
+
+TEST_F(PointCloudOctomapUpdaterTest, LeafStraddlingTheRobot)
+{
+  // GIVEN a robot box that ends in the middle of the leaves with x in [0.5, 0.6)
+  addRobotBox(Eigen::Vector3d(1.1, 1.0, 1.0), Eigen::Vector3d(0.0, 0.55, 0.55));
+
+  // WHEN a cloud has one point of such a leaf on the robot and two beyond it, and a point on an obstacle
+  updater_.cloudMsgCallback(createCloud({ Eigen::Vector3f(0.51f, 0.55f, 0.55f), Eigen::Vector3f(0.58f, 0.55f, 0.55f),
+                                          Eigen::Vector3f(0.59f, 0.55f, 0.55f),
+                                          Eigen::Vector3f(2.05f, 0.05f, 0.05f) }));
+
+  // THEN the leaf is part of the robot, as the point on the robot marks it as model
+  const collision_detection::OccMapTreePtr& tree = monitor_->getOcTreePtr();
+  const octomap::OcTreeNode* robot_leaf = search(0.55, 0.55, 0.55);
+  ASSERT_NE(robot_leaf, nullptr);
+  EXPECT_FALSE(tree->isNodeOccupied(robot_leaf));
+
+  // AND the obstacle is occupied
+  const octomap::OcTreeNode* obstacle_leaf = search(2.05, 0.05, 0.05);
+  ASSERT_NE(obstacle_leaf, nullptr);
+  EXPECT_TRUE(tree->isNodeOccupied(obstacle_leaf));
+}
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,144 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/pointcloud_octomap_updater/ray_casting.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+using occupancy_map_monitor::castRays;
+using occupancy_map_monitor::keyToMortonCode;
+using occupancy_map_monitor::mortonCodeToKey;
+
+namespace
+{
+std::set<uint64_t> mergeCells(const std::vector<std::vector<uint64_t>>& thread_cells)
+{
+  std::set<uint64_t> cells;
+  for (const std::vector<uint64_t>& cells_of_thread : thread_cells)
+    cells.insert(cells_of_thread.begin(), cells_of_thread.end());
+  return cells;
+}
+}  // namespace
+
+TEST(RayCastingTest, MortonCodeRoundTrip)
+{
+  for (const octomap::OcTreeKey& key : { octomap::OcTreeKey(0, 0, 0), octomap::OcTreeKey(1, 2, 3),
+                                         octomap::OcTreeKey(32768, 32767, 12345),
+                                         octomap::OcTreeKey(65535, 65535, 65535) })
+  {
+    EXPECT_EQ(mortonCodeToKey(keyToMortonCode(key)), key);
+  }
+  EXPECT_EQ(keyToMortonCode(octomap::OcTreeKey(65535, 65535, 65535)), (uint64_t(1) << 48) - 1);
+}
+
+TEST(RayCastingTest, MortonCodeOrdersCellsByOctreeNode)
+{
+  // The eight children of a node are ordered by x, then y, then z bit.
+  EXPECT_EQ(keyToMortonCode(octomap::OcTreeKey(1, 0, 0)), 1u);
+  EXPECT_EQ(keyToMortonCode(octomap::OcTreeKey(0, 1, 0)), 2u);
+  EXPECT_EQ(keyToMortonCode(octomap::OcTreeKey(0, 0, 1)), 4u);
+  EXPECT_EQ(keyToMortonCode(octomap::OcTreeKey(1, 1, 1)), 7u);
+
+  // All cells of a node of the lowest levels come before the cells of its next sibling.
+  for (unsigned int size : { 2u, 4u, 8u })
+  {
+    uint64_t max_code_of_first_node = 0;
+    for (unsigned int x = 0; x < size; ++x)
+      for (unsigned int y = 0; y < size; ++y)
+        for (unsigned int z = 0; z < size; ++z)
+          max_code_of_first_node = std::max(max_code_of_first_node, keyToMortonCode(octomap::OcTreeKey(x, y, z)));
+    EXPECT_LT(max_code_of_first_node, keyToMortonCode(octomap::OcTreeKey(size, 0, 0)));
+    EXPECT_EQ(max_code_of_first_node, uint64_t(size) * size * size - 1);
+  }
+
+  // Sorting the codes sorts the keys the same way.
+  octomap::KeySet keys;
+  for (unsigned int i = 0; i < 100; ++i)
+    keys.insert(octomap::OcTreeKey(32768 + (i * 7) % 13, 32768 + (i * 5) % 11, 32768 + (i * 3) % 17));
+  const std::vector<uint64_t> codes = occupancy_map_monitor::sortedMortonCodes(keys);
+  ASSERT_EQ(codes.size(), keys.size());
+  EXPECT_TRUE(std::is_sorted(codes.begin(), codes.end()));
+  for (const uint64_t code : codes)
+    EXPECT_EQ(keys.count(mortonCodeToKey(code)), 1u);
+}
+
+TEST(RayCastingTest, ParallelCellsEqualSerialCells)
+{
+  const octomap::OcTree tree(0.1);
+  const octomap::point3d origin(0.05, -0.25, 0.35);
+
+  // Rays to a half sphere of end points, many of them crossing the same cells close to the origin.
+  std::vector<octomap::OcTreeKey> ray_end_cells;
+  for (int azimuth = 0; azimuth < 60; ++azimuth)
+  {
+    for (int elevation = 0; elevation < 20; ++elevation)
+    {
+      const double a = azimuth * 2.0 * M_PI / 60, e = elevation * 0.5 * M_PI / 20, range = 1.0 + 0.05 * azimuth;
+      ray_end_cells.push_back(tree.coordToKey(origin + octomap::point3d(range * std::cos(a) * std::cos(e),
+                                                                        range * std::sin(a) * std::cos(e),
+                                                                        range * std::sin(e))));
+    }
+  }
+
+  // The cells found by casting each ray on its own.
+  std::set<uint64_t> expected_cells;
+  octomap::KeyRay key_ray;
+  for (const octomap::OcTreeKey& end_cell : ray_end_cells)
+  {
+    ASSERT_TRUE(tree.computeRayKeys(origin, tree.keyToCoord(end_cell), key_ray));
+    for (const octomap::OcTreeKey& key : key_ray)
+      expected_cells.insert(keyToMortonCode(key));
+  }
+  ASSERT_FALSE(expected_cells.empty());
+
+  std::vector<octomap::KeyRay> key_rays;
+  std::vector<std::vector<uint64_t>> thread_cells;
+  castRays(tree, origin, ray_end_cells, 1, key_rays, thread_cells);
+  EXPECT_EQ(mergeCells(thread_cells), expected_cells);
+
+  // The buffers of the serial run are reused, and cleared.
+  castRays(tree, origin, ray_end_cells, 4, key_rays, thread_cells);
+  EXPECT_GE(key_rays.size(), 4u);
+  EXPECT_EQ(mergeCells(thread_cells), expected_cells);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
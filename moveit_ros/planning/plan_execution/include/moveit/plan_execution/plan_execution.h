@@ -38,12 +38,15 @@
 
 #include <moveit/macros/class_forward.h>
 #include <moveit/plan_execution/plan_representation.h>
+#include <moveit/plan_execution/swept_volume_cache.h>
 #include <moveit/trajectory_execution_manager/trajectory_execution_manager.h>
 #include <moveit/planning_scene_monitor/planning_scene_monitor.h>
 #include <moveit/planning_scene_monitor/trajectory_monitor.h>
 #include <pluginlib/class_loader.hpp>
 
 #include <atomic>
+#include <mutex>
+#include <thread>
 
 /** \brief This namespace includes functionality specific to the execution and monitoring of motion plans */
 namespace plan_execution
@@ -84,11 +87,31 @@ public:
     std::function<bool(ExecutableMotionPlan& plan_to_update, const std::pair<int, int>& trajectory_index)>
         repair_plan_callback_;
 
+    /// Callback for computing the next segment of a multi-step task. This is optional; if specified, segments are
+    /// planned and executed in a pipeline: while a segment executes, the next one is planned in the background.
+    /// \e next_plan comes with a planning_scene that is a copy of the current scene, with its current state set to the
+    /// state the executing segment is expected to end in. A plan without components signals the end of the task.
+    /// After a segment is invalidated, plan_callback (or repair_plan_callback_) is called to replan that segment.
+    ExecutableMotionPlanComputationFn plan_next_segment_callback_;
+
     std::function<void()> before_plan_callback_;
     std::function<void()> before_execution_callback_;
     std::function<void()> done_callback_;
   };
 
+  /// Timing of the segments executed by the last pipelined planAndExecute() call
+  struct PipelineStatistics
+  {
+    /// Number of segments that were executed
+    std::size_t segments = 0;
+
+    /// Total time the robot was idle between the execution of consecutive segments (in seconds)
+    double total_idle_time = 0.0;
+
+    /// Longest time the robot was idle between two segments (in seconds)
+    double max_idle_time = 0.0;
+  };
+
   PlanExecution(const rclcpp::Node::SharedPtr& node,
                 const planning_scene_monitor::PlanningSceneMonitorPtr& planning_scene_monitor,
                 const trajectory_execution_manager::TrajectoryExecutionManagerPtr& trajectory_execution);
@@ -143,10 +166,36 @@ public:
 
   void stop();
 
+  PipelineStatistics getLastPipelineStatistics() const
+  {
+    std::scoped_lock lock(pipeline_statistics_lock_);
+    return pipeline_statistics_;
+  }
+
 private:
   void planAndExecuteHelper(ExecutableMotionPlan& plan, const Options& opt);
+
+  /** \brief Execute \e plan and all following segments computed by Options::plan_next_segment_callback_.
+      On failure, \e plan holds the segment that failed. */
+  moveit_msgs::msg::MoveItErrorCodes executePipelined(ExecutableMotionPlan& plan, const Options& opt);
   bool isRemainingPathValid(const ExecutableMotionPlan& plan, const std::pair<int, int>& path_segment);
 
+  /** \brief Check only the waypoints of the remaining path whose swept volume intersects \e changed_regions */
+  bool isRemainingPathValid(const ExecutableMotionPlan& plan, const std::pair<int, int>& path_segment,
+                            const std::vector<moveit::core::AABB>& changed_regions);
+  bool isWayPointValid(const ExecutableMotionPlan& plan, std::size_t component, std::size_t index) const;
+
+  /** \brief Start collecting the regions of the world that change while \e plan is executed. The first check
+      afterwards covers the whole remaining path, since changes before this call were not collected. */
+  void startChangeTracking(ExecutableMotionPlan& plan);
+  void stopChangeTracking();
+
+  /** \brief Get the regions of the world that changed since the last call.
+      \return false if the changes cannot be localized and the complete remaining path needs to be checked */
+  bool takeChangedRegions(const ExecutableMotionPlan& plan, std::vector<moveit::core::AABB>& changed_regions);
+  void worldObjectUpdatedCallback(const collision_detection::World::ObjectConstPtr& object,
+                                  collision_detection::World::Action action);
+
   void planningSceneUpdatedCallback(const planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType update_type);
   void doneWithTrajectoryExecution(const moveit_controller_manager::ExecutionStatus& status);
   void successfulTrajectorySegmentExecution(const ExecutableMotionPlan& plan, std::size_t index);
@@ -179,6 +228,28 @@ private:
 
   bool new_scene_update_;
 
+  /// Bounds swept by each component of the plan currently being executed
+  std::vector<SweptVolumeCache> swept_volumes_;
+
+  collision_detection::WorldPtr observed_world_;
+  collision_detection::World::ObserverHandle world_observer_handle_;
+  collision_detection::OccMapTreePtr observed_octree_;
+
+  /// With octomap snapshots, the octree the remaining path was last checked against
+  bool track_octree_snapshots_ = false;
+  std::shared_ptr<const octomap::OcTree> checked_octree_snapshot_;
+
+  std::mutex changed_regions_lock_;
+  std::vector<moveit::core::AABB> changed_regions_;
+  std::shared_ptr<const octomap::OcTree> scene_octree_snapshot_;
+  std::atomic<bool> full_revalidation_required_{ false };
+
+  mutable std::mutex pipeline_statistics_lock_;
+  PipelineStatistics pipeline_statistics_;
+
+  /// Plans the next segment of a pipelined execution, left running when the pipeline stops before it finishes
+  std::thread next_segment_planning_thread_;
+
   bool execution_complete_;
   bool path_became_invalid_;
 
@@ -0,0 +1,101 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/collision_detection/world.h>
+#include <moveit/robot_model/aabb.h>
+#include <moveit/robot_trajectory/robot_trajectory.h>
+#include <octomap/OcTree.h>
+#include <vector>
+
+namespace plan_execution
+{
+/** \brief Per-waypoint axis-aligned bounds of the space swept by the robot along a trajectory.
+
+    The bounds are computed once per trajectory and allow restricting the revalidation of a trajectory after a scene
+    update to the waypoints that are close to the geometry that actually changed. */
+class SweptVolumeCache
+{
+public:
+  /** \brief Compute the bounds for all waypoints of \e trajectory.
+
+      The bounds of waypoint i enclose the robot (including attached bodies) at waypoints i - 1 and i, inflated by
+      \e padding. The link transforms of the waypoints are updated if needed. */
+  void compute(robot_trajectory::RobotTrajectory& trajectory, double padding = 0.0);
+
+  void clear();
+
+  bool empty() const
+  {
+    return bounds_.empty();
+  }
+
+  std::size_t size() const
+  {
+    return bounds_.size();
+  }
+
+  const moveit::core::AABB& getWayPointBounds(std::size_t index) const
+  {
+    return bounds_[index];
+  }
+
+  /** \brief Get the bounds enclosing the complete trajectory */
+  const moveit::core::AABB& getTotalBounds() const
+  {
+    return total_bounds_;
+  }
+
+  /** \brief Get the indices of the waypoints in [\e begin, size()) whose bounds intersect any of \e regions.
+      The indices are returned in increasing order, i.e. the waypoints closest to \e begin come first. */
+  void getIntersectingWayPoints(const std::vector<moveit::core::AABB>& regions, std::size_t begin,
+                                std::vector<std::size_t>& indices) const;
+
+private:
+  std::vector<moveit::core::AABB> bounds_;
+  moveit::core::AABB total_bounds_;
+};
+
+/** \brief Compute the world-frame bounds of all shapes of a collision object.
+    \return false if the object contains shapes that cannot be bounded (e.g. planes) */
+bool computeObjectBounds(const collision_detection::World::Object& object, moveit::core::AABB& bounds);
+
+/** \brief Compute the bounds of the voxels that are occupied in \e octree but not in \e reference.
+    The voxels are grouped into cells that are 2^\e depth_reduction voxels wide, voxels of \e reference that are not
+    leafs are considered changed.
+    \return false if the octrees cannot be compared because their resolutions differ */
+bool computeNewlyOccupiedRegions(const octomap::OcTree& octree, const octomap::OcTree& reference,
+                                 unsigned int depth_reduction, std::vector<moveit::core::AABB>& regions);
+}  // namespace plan_execution
@@ -38,9 +38,11 @@
 #include <moveit/robot_state/conversions.h>
 #include <moveit/trajectory_processing/trajectory_tools.h>
 #include <moveit/collision_detection/collision_tools.h>
+#include <moveit/utils/latency_tracer.h>
 #include <moveit/utils/message_checks.h>
 #include <moveit/utils/moveit_error_code.h>
 #include <boost/algorithm/string/join.hpp>
+#include <geometric_shapes/shapes.h>
 #include <rclcpp/logger.hpp>
 #include <rclcpp/logging.hpp>
 #include <rclcpp/node.hpp>
@@ -48,6 +50,9 @@
 #include <rclcpp/rate.hpp>
 #include <rclcpp/utilities.hpp>
 
+#include <chrono>
+#include <future>
+
 // #include <dynamic_reconfigure/server.h>
 // #include <moveit_ros_planning/PlanExecutionDynamicReconfigureConfig.h>
 
@@ -55,6 +60,23 @@ namespace plan_execution
 {
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_ros.plan_execution");
 
+// Margin added to the swept volumes of the trajectories when matching them against changed world geometry
+static constexpr double SWEPT_VOLUME_PADDING = 0.01;  // meters
+
+// Number of states the trajectory monitor buffers between two iterations of the execution monitoring loop
+static constexpr int DEFAULT_STATE_BUFFER_CAPACITY = 1000;
+
+// Changed octomap voxels are grouped into cells that are 2^CHANGED_VOXEL_DEPTH_REDUCTION voxels wide
+static constexpr unsigned int CHANGED_VOXEL_DEPTH_REDUCTION = 3;
+
+// Get the octree of an octomap object of the world
+static std::shared_ptr<const octomap::OcTree> getObjectOctree(const collision_detection::World::Object& object)
+{
+  if (object.shapes_.size() != 1 || object.shapes_[0]->type != shapes::OCTREE)
+    return nullptr;
+  return static_cast<const shapes::OcTree*>(object.shapes_[0].get())->octree;
+}
+
 // class PlanExecution::DynamicReconfigureImpl
 // {
 // public:
@@ -105,6 +127,8 @@ plan_execution::PlanExecution::PlanExecution(
 plan_execution::PlanExecution::~PlanExecution()
 {
   // delete reconfigure_impl_;
+  if (next_segment_planning_thread_.joinable())
+    next_segment_planning_thread_.join();
 }
 
 void plan_execution::PlanExecution::stop()
@@ -169,10 +193,12 @@ void plan_execution::PlanExecution::planAndExecuteHelper(ExecutableMotionPlan& p
 
     // if we never had a solved plan, or there is no specified way of fixing plans, just call the planner; otherwise,
     // try to repair the plan we previously had;
+    moveit::core::ScopedLatencyTrace plan_trace("plan_execution/plan");
     bool solved =
         (!previously_solved || !opt.repair_plan_callback_) ?
             opt.plan_callback(plan) :
             opt.repair_plan_callback_(plan, trajectory_execution_manager_->getCurrentExpectedTrajectoryIndex());
+    plan_trace.stop();
 
     preempt_requested = preempt_.checkAndClear();
     if (preempt_requested)
@@ -213,7 +239,8 @@ void plan_execution::PlanExecution::planAndExecuteHelper(ExecutableMotionPlan& p
         break;
 
       // execute the trajectory, and monitor its execution
-      plan.error_code = executeAndMonitor(plan, false);
+      plan.error_code =
+          opt.plan_next_segment_callback_ ? executePipelined(plan, opt) : executeAndMonitor(plan, false);
     }
 
     if (plan.error_code.val == moveit_msgs::msg::MoveItErrorCodes::PREEMPTED)
@@ -262,6 +289,138 @@ void plan_execution::PlanExecution::planAndExecuteHelper(ExecutableMotionPlan& p
   }
 }
 
+moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executePipelined(ExecutableMotionPlan& plan,
+                                                                                   const Options& opt)
+{
+  {
+    std::scoped_lock lock(pipeline_statistics_lock_);
+    pipeline_statistics_ = PipelineStatistics();
+  }
+
+  // a planner abandoned by the previous call due to preemption or failure still owns its own state
+  if (next_segment_planning_thread_.joinable())
+    next_segment_planning_thread_.join();
+
+  robot_trajectory::RobotTrajectoryPtr executed_trajectory;
+  std::chrono::steady_clock::time_point previous_motion_end;
+  moveit_msgs::msg::MoveItErrorCodes result;
+  while (true)
+  {
+    if (!plan.planning_scene_monitor)
+      plan.planning_scene_monitor = planning_scene_monitor_;
+    if (!plan.planning_scene)
+      plan.planning_scene = planning_scene_monitor_->getPlanningScene();
+
+    // plan the next segment in the background, in a copy of the scene, from the state this segment ends in;
+    // the end state is taken before execution starts, as trajectories are unwound when they are pushed
+    auto next = std::make_shared<ExecutableMotionPlan>();
+    next->planning_scene_monitor = plan.planning_scene_monitor;
+    {
+      planning_scene_monitor::LockedPlanningSceneRO lscene(plan.planning_scene_monitor);
+      planning_scene::PlanningScenePtr forked_scene = planning_scene::PlanningScene::clone(plan.planning_scene);
+      for (auto it = plan.plan_components.rbegin(); it != plan.plan_components.rend(); ++it)
+      {
+        if (it->trajectory && !it->trajectory->empty())
+        {
+          forked_scene->setCurrentState(it->trajectory->getLastWayPoint());
+          break;
+        }
+      }
+      next->planning_scene = forked_scene;
+    }
+    // the planner shares ownership of its state, so it can be abandoned when the pipeline stops
+    std::packaged_task<bool()> plan_next_segment(
+        [callback = opt.plan_next_segment_callback_, next] { return callback(*next); });
+    std::future<bool> next_planned = plan_next_segment.get_future();
+    next_segment_planning_thread_ = std::thread(std::move(plan_next_segment));
+
+    result = executeAndMonitor(plan, false);
+
+    if (plan.executed_trajectory)
+    {
+      if (executed_trajectory)
+        executed_trajectory->append(*plan.executed_trajectory, 0.0);
+      else
+        executed_trajectory = plan.executed_trajectory;
+    }
+    if (result.val != moveit_msgs::msg::MoveItErrorCodes::SUCCESS)
+      break;
+
+    // the robot is idle from the end of the motion of a segment until the motion of the next one starts, which
+    // includes validating and dispatching the trajectory and waiting for the robot to stop
+    const auto [motion_start, motion_end] = trajectory_execution_manager_->getLastMotionTimes();
+    {
+      std::scoped_lock lock(pipeline_statistics_lock_);
+      if (pipeline_statistics_.segments > 0 && previous_motion_end != std::chrono::steady_clock::time_point() &&
+          motion_start != std::chrono::steady_clock::time_point())
+      {
+        const double idle_time =
+            std::max(0.0, std::chrono::duration<double>(motion_start - previous_motion_end).count());
+        RCLCPP_INFO(LOGGER, "Robot was idle for %lf seconds before segment %zu", idle_time,
+                    pipeline_statistics_.segments + 1);
+        pipeline_statistics_.total_idle_time += idle_time;
+        pipeline_statistics_.max_idle_time = std::max(pipeline_statistics_.max_idle_time, idle_time);
+      }
+      ++pipeline_statistics_.segments;
+    }
+    previous_motion_end = motion_end;
+
+    // wait for the next segment, but stop the pipeline right away when preempted
+    bool next_solved = false;
+    while (true)
+    {
+      if (preempt_.checkAndClear())
+      {
+        result.val = moveit_msgs::msg::MoveItErrorCodes::PREEMPTED;
+        break;
+      }
+      if (next_planned.wait_for(std::chrono::milliseconds(10)) == std::future_status::ready)
+      {
+        next_solved = next_planned.get();
+        next_segment_planning_thread_.join();
+        break;
+      }
+    }
+    if (result.val != moveit_msgs::msg::MoveItErrorCodes::SUCCESS)
+      break;
+    if (!next_solved)
+    {
+      RCLCPP_ERROR(LOGGER, "Planning the next segment failed");
+      plan = std::move(*next);
+      result = plan.error_code;
+      if (result.val == moveit_msgs::msg::MoveItErrorCodes::SUCCESS)
+        result.val = moveit_msgs::msg::MoveItErrorCodes::PLANNING_FAILED;
+      break;
+    }
+    if (next->plan_components.empty())
+      break;
+
+    // the next segment was planned against a predicted scene; check it against the scene as it is now
+    next->planning_scene = plan.planning_scene;
+    plan = std::move(*next);
+    for (std::size_t i = 0; i < plan.plan_components.size(); ++i)
+    {
+      if (plan.plan_components[i].trajectory && !isRemainingPathValid(plan, std::make_pair(static_cast<int>(i), 0)))
+      {
+        RCLCPP_INFO(LOGGER, "Next segment component '%s' is invalid", plan.plan_components[i].description.c_str());
+        result.val = moveit_msgs::msg::MoveItErrorCodes::MOTION_PLAN_INVALIDATED_BY_ENVIRONMENT_CHANGE;
+        break;
+      }
+    }
+    if (result.val != moveit_msgs::msg::MoveItErrorCodes::SUCCESS)
+      break;
+  }
+
+  plan.executed_trajectory = executed_trajectory;
+  {
+    std::scoped_lock lock(pipeline_statistics_lock_);
+    RCLCPP_INFO(LOGGER, "Executed %zu segments, robot was idle for %lf seconds in total (at most %lf seconds at once)",
+                pipeline_statistics_.segments, pipeline_statistics_.total_idle_time,
+                pipeline_statistics_.max_idle_time);
+  }
+  return result;
+}
+
 bool plan_execution::PlanExecution::isRemainingPathValid(const ExecutableMotionPlan& plan,
                                                          const std::pair<int, int>& path_segment)
 {
@@ -273,49 +432,257 @@ bool plan_execution::PlanExecution::isRemainingPathValid(const ExecutableMotionP
                                                                                         // does not modify the world
                                                                                         // representation while
                                                                                         // isStateValid() is called
-    const robot_trajectory::RobotTrajectory& t = *plan.plan_components[path_segment.first].trajectory;
-    const collision_detection::AllowedCollisionMatrix* acm =
-        plan.plan_components[path_segment.first].allowed_collision_matrix.get();
-    std::size_t wpc = t.getWayPointCount();
-    collision_detection::CollisionRequest req;
-    req.group_name = t.getGroupName();
+    std::size_t wpc = plan.plan_components[path_segment.first].trajectory->getWayPointCount();
     for (std::size_t i = std::max(path_segment.second - 1, 0); i < wpc; ++i)
     {
-      collision_detection::CollisionResult res;
-      if (acm)
-      {
-        plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(i), *acm);
-      }
-      else
-      {
-        plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(i));
-      }
-
-      if (res.collision || !plan.planning_scene->isStateFeasible(t.getWayPoint(i), false))
-      {
-        // Dave's debacle
-        RCLCPP_INFO(LOGGER, "Trajectory component '%s' is invalid",
-                    plan.plan_components[path_segment.first].description.c_str());
-
-        // call the same functions again, in verbose mode, to show what issues have been detected
-        plan.planning_scene->isStateFeasible(t.getWayPoint(i), true);
-        req.verbose = true;
-        res.clear();
-        if (acm)
-        {
-          plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(i), *acm);
-        }
-        else
-        {
-          plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(i));
-        }
+      if (!isWayPointValid(plan, path_segment.first, i))
         return false;
-      }
     }
   }
   return true;
 }
 
+bool plan_execution::PlanExecution::isRemainingPathValid(const ExecutableMotionPlan& plan,
+                                                         const std::pair<int, int>& path_segment,
+                                                         const std::vector<moveit::core::AABB>& changed_regions)
+{
+  if (path_segment.first < 0 || !plan.plan_components[path_segment.first].trajectory_monitoring)
+    return true;
+
+  const std::size_t component = path_segment.first;
+  if (component >= swept_volumes_.size() ||
+      swept_volumes_[component].size() != plan.plan_components[component].trajectory->getWayPointCount())
+    return isRemainingPathValid(plan, path_segment);
+
+  // only the waypoints close to the changed geometry can have become invalid; they are returned in order of
+  // increasing distance to the current execution index, so collisions that are imminent are detected first
+  std::vector<std::size_t> indices;
+  swept_volumes_[component].getIntersectingWayPoints(changed_regions, std::max(path_segment.second - 1, 0), indices);
+  if (indices.empty())
+    return true;
+
+  RCLCPP_DEBUG(LOGGER, "Revalidating %zu of %zu waypoints of trajectory component '%s'", indices.size(),
+               swept_volumes_[component].size(), plan.plan_components[component].description.c_str());
+  planning_scene_monitor::LockedPlanningSceneRO lscene(plan.planning_scene_monitor);
+  for (std::size_t i : indices)
+  {
+    if (!isWayPointValid(plan, component, i))
+      return false;
+  }
+  return true;
+}
+
+bool plan_execution::PlanExecution::isWayPointValid(const ExecutableMotionPlan& plan, std::size_t component,
+                                                    std::size_t index) const
+{
+  const robot_trajectory::RobotTrajectory& t = *plan.plan_components[component].trajectory;
+  const collision_detection::AllowedCollisionMatrix* acm =
+      plan.plan_components[component].allowed_collision_matrix.get();
+  collision_detection::CollisionRequest req;
+  req.group_name = t.getGroupName();
+  collision_detection::CollisionResult res;
+  if (acm)
+  {
+    plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(index), *acm);
+  }
+  else
+  {
+    plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(index));
+  }
+
+  if (res.collision || !plan.planning_scene->isStateFeasible(t.getWayPoint(index), false))
+  {
+    // Dave's debacle
+    RCLCPP_INFO(LOGGER, "Trajectory component '%s' is invalid", plan.plan_components[component].description.c_str());
+
+    // call the same functions again, in verbose mode, to show what issues have been detected
+    plan.planning_scene->isStateFeasible(t.getWayPoint(index), true);
+    req.verbose = true;
+    res.clear();
+    if (acm)
+    {
+      plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(index), *acm);
+    }
+    else
+    {
+      plan.planning_scene->checkCollisionUnpadded(req, res, t.getWayPoint(index));
+    }
+    return false;
+  }
+  return true;
+}
+
+void plan_execution::PlanExecution::startChangeTracking(ExecutableMotionPlan& plan)
+{
+  // the swept volumes are computed once per trajectory, after the trajectories have been unwound
+  swept_volumes_.clear();
+  swept_volumes_.resize(plan.plan_components.size());
+  for (std::size_t i = 0; i < plan.plan_components.size(); ++i)
+  {
+    if (plan.plan_components[i].trajectory && plan.plan_components[i].trajectory_monitoring)
+      swept_volumes_[i].compute(*plan.plan_components[i].trajectory, SWEPT_VOLUME_PADDING);
+  }
+
+  {
+    std::scoped_lock lock(changed_regions_lock_);
+    changed_regions_.clear();
+  }
+
+  occupancy_map_monitor::OccupancyMapMonitor* octomap_monitor = planning_scene_monitor_->getOccupancyMapMonitor();
+  {
+    planning_scene_monitor::LockedPlanningSceneRW lscene(planning_scene_monitor_);
+    observed_world_ = lscene->getWorldNonConst();
+
+    // octomap snapshots replace the octree object of the world, their contents are compared instead
+    track_octree_snapshots_ = octomap_monitor && octomap_monitor->hasSnapshots();
+    checked_octree_snapshot_.reset();
+    if (track_octree_snapshots_)
+    {
+      if (collision_detection::World::ObjectConstPtr object =
+              observed_world_->getObject(planning_scene::PlanningScene::OCTOMAP_NS))
+        checked_octree_snapshot_ = getObjectOctree(*object);
+    }
+    {
+      std::scoped_lock lock(changed_regions_lock_);
+      scene_octree_snapshot_ = checked_octree_snapshot_;
+    }
+
+    world_observer_handle_ = observed_world_->addObserver(
+        [this](const collision_detection::World::ObjectConstPtr& object, collision_detection::World::Action action) {
+          worldObjectUpdatedCallback(object, action);
+        });
+  }
+
+  // octomap updates modify the octree in place and do not notify world observers,
+  // so the changed voxels are obtained from the change detection of the octree
+  if (octomap_monitor && !track_octree_snapshots_)
+  {
+    observed_octree_ = octomap_monitor->getOcTreePtr();
+    observed_octree_->lockWrite();
+    observed_octree_->enableChangeDetection(true);
+    observed_octree_->resetChangeDetection();
+    observed_octree_->unlockWrite();
+  }
+
+  // scene updates between the last validation of the plan and this point were not observed,
+  // so the first check after tracking started revalidates the whole remaining path
+  full_revalidation_required_ = true;
+  new_scene_update_ = true;
+}
+
+void plan_execution::PlanExecution::stopChangeTracking()
+{
+  if (observed_world_)
+  {
+    planning_scene_monitor::LockedPlanningSceneRW lscene(planning_scene_monitor_);
+    observed_world_->removeObserver(world_observer_handle_);
+    observed_world_.reset();
+  }
+  track_octree_snapshots_ = false;
+  checked_octree_snapshot_.reset();
+  {
+    std::scoped_lock lock(changed_regions_lock_);
+    scene_octree_snapshot_.reset();
+  }
+
+  if (observed_octree_)
+  {
+    observed_octree_->lockWrite();
+    observed_octree_->enableChangeDetection(false);
+    observed_octree_->resetChangeDetection();
+    observed_octree_->unlockWrite();
+    observed_octree_.reset();
+  }
+  swept_volumes_.clear();
+}
+
+bool plan_execution::PlanExecution::takeChangedRegions(const ExecutableMotionPlan& plan,
+                                                       std::vector<moveit::core::AABB>& changed_regions)
+{
+  changed_regions.clear();
+  std::shared_ptr<const octomap::OcTree> scene_octree;
+  {
+    std::scoped_lock lock(changed_regions_lock_);
+    changed_regions.swap(changed_regions_);
+    scene_octree = scene_octree_snapshot_;
+  }
+
+  // snapshots are immutable, so they are compared without locking; a removed octree cannot invalidate the path
+  if (scene_octree && scene_octree != checked_octree_snapshot_)
+  {
+    std::vector<moveit::core::AABB> octree_regions;
+    if (!checked_octree_snapshot_ || !computeNewlyOccupiedRegions(*scene_octree, *checked_octree_snapshot_,
+                                                                  CHANGED_VOXEL_DEPTH_REDUCTION, octree_regions))
+      full_revalidation_required_ = true;
+    changed_regions.insert(changed_regions.end(), octree_regions.begin(), octree_regions.end());
+    checked_octree_snapshot_ = scene_octree;
+  }
+
+  if (observed_octree_)
+  {
+    // collapse the changed voxels into coarser cells to keep the number of regions small
+    observed_octree_->lockWrite();
+    const unsigned int depth = observed_octree_->getTreeDepth() - CHANGED_VOXEL_DEPTH_REDUCTION;
+    octomap::KeySet cells;
+    for (octomap::KeyBoolMap::const_iterator it = observed_octree_->changedKeysBegin();
+         it != observed_octree_->changedKeysEnd(); ++it)
+    {
+      // voxels that became free cannot invalidate the path
+      const octomap::OcTreeNode* node = observed_octree_->search(it->first);
+      if (node && observed_octree_->isNodeOccupied(node))
+        cells.insert(observed_octree_->adjustKeyAtDepth(it->first, depth));
+    }
+    observed_octree_->resetChangeDetection();
+    const double half_size = 0.5 * observed_octree_->getNodeSize(depth);
+    for (const octomap::OcTreeKey& cell : cells)
+    {
+      const octomap::point3d center = observed_octree_->keyToCoord(cell, depth);
+      const Eigen::Vector3d c(center.x(), center.y(), center.z());
+      changed_regions.emplace_back();
+      changed_regions.back().extend(c - Eigen::Vector3d::Constant(half_size));
+      changed_regions.back().extend(c + Eigen::Vector3d::Constant(half_size));
+    }
+    observed_octree_->unlockWrite();
+  }
+
+  // the changes can only be localized if we observe the world the plan is checked against
+  if (full_revalidation_required_.exchange(false) || plan.planning_scene_monitor != planning_scene_monitor_)
+    return false;
+  planning_scene_monitor::LockedPlanningSceneRO lscene(planning_scene_monitor_);
+  return lscene->getWorld() == observed_world_;
+}
+
+void plan_execution::PlanExecution::worldObjectUpdatedCallback(const collision_detection::World::ObjectConstPtr& object,
+                                                               collision_detection::World::Action action)
+{
+  if (track_octree_snapshots_ && object->id_ == planning_scene::PlanningScene::OCTOMAP_NS)
+  {
+    // the octree is compared to the one the path was last checked against in takeChangedRegions()
+    if (!(action & collision_detection::World::DESTROY))
+    {
+      std::scoped_lock lock(changed_regions_lock_);
+      scene_octree_snapshot_ = getObjectOctree(*object);
+    }
+    return;
+  }
+
+  // removed geometry cannot invalidate the path
+  if (action & collision_detection::World::DESTROY)
+    return;
+
+  moveit::core::AABB bounds;
+  if (!computeObjectBounds(*object, bounds))
+  {
+    full_revalidation_required_ = true;
+    return;
+  }
+  if (!bounds.isEmpty())
+  {
+    std::scoped_lock lock(changed_regions_lock_);
+    changed_regions_.push_back(bounds);
+  }
+}
+
 moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMonitor(ExecutableMotionPlan& plan,
                                                                                     bool reset_preempted)
 {
@@ -348,6 +715,7 @@ moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMoni
   execution_complete_ = false;
 
   // push the trajectories we have slated for execution to the trajectory execution manager
+  moveit::core::ScopedLatencyTrace prepare_trace("plan_execution/prepare");
   int prev = -1;
   for (size_t component_idx = 0; component_idx < plan.plan_components.size(); ++component_idx)
   {
@@ -406,6 +774,9 @@ moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMoni
     }
   }
 
+  // collect the changes to the world from now on, so the remaining path can be revalidated incrementally
+  startChangeTracking(plan);
+
   if (!trajectory_monitor_ && planning_scene_monitor_->getStateMonitor())
   {
     // Pass current value of reconfigurable parameter plan_execution/record_trajectory_state_frequency
@@ -413,11 +784,20 @@ moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMoni
     node_->get_parameter_or("plan_execution.record_trajectory_state_frequency", sampling_frequency, 0.0);
     trajectory_monitor_ = std::make_shared<planning_scene_monitor::TrajectoryMonitor>(
         planning_scene_monitor_->getStateMonitor(), sampling_frequency);
+
+    // record the states on updates of the current state monitor, at most at the sampling frequency, instead of
+    // polling it from a separate thread; states are not recorded at all without a sampling frequency
+    int state_buffer_capacity = 0;
+    node_->get_parameter_or("plan_execution.record_trajectory_state_buffer_capacity", state_buffer_capacity,
+                            DEFAULT_STATE_BUFFER_CAPACITY);
+    if (sampling_frequency > 0.0 && state_buffer_capacity > 0)
+      trajectory_monitor_->setStateBufferCapacity(state_buffer_capacity);
   }
 
   // start recording trajectory states
   if (trajectory_monitor_)
     trajectory_monitor_->startTrajectoryMonitor();
+  prepare_trace.stop();
 
   // start a trajectory execution thread
   trajectory_execution_manager_->execute(
@@ -431,12 +811,21 @@ moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMoni
   while (rclcpp::ok() && !execution_complete_ && !path_became_invalid_)
   {
     r.sleep();
+    // move the recorded states out of the buffer, so it does not overflow during long executions
+    if (trajectory_monitor_ && trajectory_monitor_->getStateBufferCapacity() > 0)
+      trajectory_monitor_->getTrajectory();
     // check the path if there was an environment update in the meantime
     if (new_scene_update_)
     {
       new_scene_update_ = false;
       std::pair<int, int> current_index = trajectory_execution_manager_->getCurrentExpectedTrajectoryIndex();
-      if (!isRemainingPathValid(plan, current_index))
+      std::vector<moveit::core::AABB> changed_regions;
+      moveit::core::ScopedLatencyTrace revalidate_trace("plan_execution/revalidate");
+      const bool valid = takeChangedRegions(plan, changed_regions) ?
+                             isRemainingPathValid(plan, current_index, changed_regions) :
+                             isRemainingPathValid(plan, current_index);
+      revalidate_trace.stop();
+      if (!valid)
       {
         RCLCPP_INFO(LOGGER, "Trajectory component '%s' is invalid after scene update",
                     plan.plan_components[current_index.first].description.c_str());
@@ -469,6 +858,8 @@ moveit_msgs::msg::MoveItErrorCodes plan_execution::PlanExecution::executeAndMoni
     trajectory_execution_manager_->stopExecution();
   }
 
+  stopChangeTracking();
+
   // stop recording trajectory states
   if (trajectory_monitor_)
   {
@@ -515,7 +906,12 @@ void plan_execution::PlanExecution::planningSceneUpdatedCallback(
 {
   if (update_type & (planning_scene_monitor::PlanningSceneMonitor::UPDATE_GEOMETRY |
                      planning_scene_monitor::PlanningSceneMonitor::UPDATE_TRANSFORMS))
+  {
+    // only pure geometry updates can be localized by the observed world changes
+    if (update_type != planning_scene_monitor::PlanningSceneMonitor::UPDATE_GEOMETRY)
+      full_revalidation_required_ = true;
     new_scene_update_ = true;
+  }
 }
 
 void plan_execution::PlanExecution::doneWithTrajectoryExecution(
@@ -0,0 +1,192 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/plan_execution/swept_volume_cache.h>
+#include <geometric_shapes/shape_operations.h>
+#include <octomap/octomap.h>
+
+namespace plan_execution
+{
+namespace
+{
+moveit::core::AABB computeWayPointBounds(moveit::core::RobotState& state, double padding)
+{
+  state.updateCollisionBodyTransforms();
+  std::vector<double> aabb;
+  state.computeAABB(aabb);
+
+  moveit::core::AABB bounds;
+  bounds.extend(Eigen::Vector3d(aabb[0], aabb[2], aabb[4]));
+  bounds.extend(Eigen::Vector3d(aabb[1], aabb[3], aabb[5]));
+  bounds.min().array() -= padding;
+  bounds.max().array() += padding;
+  return bounds;
+}
+}  // namespace
+
+void SweptVolumeCache::compute(robot_trajectory::RobotTrajectory& trajectory, double padding)
+{
+  clear();
+  const std::size_t count = trajectory.getWayPointCount();
+  bounds_.reserve(count);
+
+  moveit::core::AABB previous;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const moveit::core::AABB current = computeWayPointBounds(*trajectory.getWayPointPtr(i), padding);
+    bounds_.push_back(current);
+    if (i > 0)
+      bounds_.back().extend(previous);
+    total_bounds_.extend(current);
+    previous = current;
+  }
+}
+
+void SweptVolumeCache::clear()
+{
+  bounds_.clear();
+  total_bounds_.setEmpty();
+}
+
+void SweptVolumeCache::getIntersectingWayPoints(const std::vector<moveit::core::AABB>& regions, std::size_t begin,
+                                                std::vector<std::size_t>& indices) const
+{
+  indices.clear();
+
+  // discard regions that do not touch the trajectory at all
+  std::vector<const moveit::core::AABB*> relevant;
+  for (const moveit::core::AABB& region : regions)
+  {
+    if (total_bounds_.intersects(region))
+      relevant.push_back(&region);
+  }
+  if (relevant.empty())
+    return;
+
+  for (std::size_t i = begin; i < bounds_.size(); ++i)
+  {
+    for (const moveit::core::AABB* region : relevant)
+    {
+      if (bounds_[i].intersects(*region))
+      {
+        indices.push_back(i);
+        break;
+      }
+    }
+  }
+}
+
+bool computeObjectBounds(const collision_detection::World::Object& object, moveit::core::AABB& bounds)
+{
+  bounds.setEmpty();
+  for (std::size_t i = 0; i < object.shapes_.size(); ++i)
+  {
+    const shapes::Shape* shape = object.shapes_[i].get();
+    const Eigen::Isometry3d& pose = object.global_shape_poses_[i];
+    switch (shape->type)
+    {
+      case shapes::SPHERE:
+      case shapes::BOX:
+      case shapes::CYLINDER:
+      case shapes::CONE:
+      case shapes::MESH:
+      {
+        Eigen::Vector3d center;
+        double radius;
+        shapes::computeShapeBoundingSphere(shape, center, radius);
+        bounds.extendWithTransformedBox(pose * Eigen::Translation3d(center), Eigen::Vector3d::Constant(2.0 * radius));
+        break;
+      }
+      case shapes::OCTREE:
+      {
+        const std::shared_ptr<const octomap::OcTree>& octree = static_cast<const shapes::OcTree*>(shape)->octree;
+        if (!octree || octree->size() == 0)
+          break;
+        Eigen::Vector3d min, max;
+        octree->getMetricMin(min.x(), min.y(), min.z());
+        octree->getMetricMax(max.x(), max.y(), max.z());
+        bounds.extendWithTransformedBox(pose * Eigen::Translation3d(0.5 * (min + max)), max - min);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool computeNewlyOccupiedRegions(const octomap::OcTree& octree, const octomap::OcTree& reference,
+                                 unsigned int depth_reduction, std::vector<moveit::core::AABB>& regions)
+{
+  regions.clear();
+  if (octree.getResolution() != reference.getResolution())
+    return false;
+
+  const unsigned int depth = octree.getTreeDepth() - depth_reduction;
+  octomap::KeySet cells;
+  for (octomap::OcTree::leaf_iterator it = octree.begin_leafs(), end = octree.end_leafs(); it != end; ++it)
+  {
+    if (!octree.isNodeOccupied(*it))
+      continue;
+
+    // an occupied leaf of the reference at the same or a coarser depth covers the voxel
+    const octomap::OcTreeNode* node = reference.search(it.getKey(), it.getDepth());
+    if (node && !reference.nodeHasChildren(node) && reference.isNodeOccupied(node))
+      continue;
+
+    if (it.getDepth() >= depth)
+      cells.insert(octree.adjustKeyAtDepth(it.getKey(), depth));
+    else
+    {
+      // leafs that are coarser than a cell are added on their own
+      const octomap::point3d center = it.getCoordinate();
+      const Eigen::Vector3d c(center.x(), center.y(), center.z());
+      regions.emplace_back();
+      regions.back().extend(c - Eigen::Vector3d::Constant(0.5 * it.getSize()));
+      regions.back().extend(c + Eigen::Vector3d::Constant(0.5 * it.getSize()));
+    }
+  }
+
+  const double half_size = 0.5 * octree.getNodeSize(depth);
+  for (const octomap::OcTreeKey& cell : cells)
+  {
+    const octomap::point3d center = octree.keyToCoord(cell, depth);
+    const Eigen::Vector3d c(center.x(), center.y(), center.z());
+    regions.emplace_back();
+    regions.back().extend(c - Eigen::Vector3d::Constant(half_size));
+    regions.back().extend(c + Eigen::Vector3d::Constant(half_size));
+  }
+  return true;
+}
+}  // namespace plan_execution
@@ -0,0 +1,161 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/plan_execution/swept_volume_cache.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <geometric_shapes/shapes.h>
+
+namespace
+{
+moveit::core::AABB makeBox(const Eigen::Vector3d& center, double size)
+{
+  moveit::core::AABB box;
+  box.extend(center - Eigen::Vector3d::Constant(0.5 * size));
+  box.extend(center + Eigen::Vector3d::Constant(0.5 * size));
+  return box;
+}
+}  // namespace
+
+class SweptVolumeCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    trajectory_ = std::make_shared<robot_trajectory::RobotTrajectory>(robot_model_, "panda_arm");
+
+    moveit::core::RobotState state(robot_model_);
+    state.setToDefaultValues();
+    const moveit::core::JointModelGroup* group = robot_model_->getJointModelGroup("panda_arm");
+    std::vector<double> positions;
+    state.copyJointGroupPositions(group, positions);
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      positions[0] = -1.0 + 0.5 * static_cast<double>(i);
+      state.setJointGroupPositions(group, positions);
+      trajectory_->addSuffixWayPoint(state, 0.1);
+    }
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  robot_trajectory::RobotTrajectoryPtr trajectory_;
+};
+
+TEST_F(SweptVolumeCacheTest, BoundsCoverTrajectory)
+{
+  plan_execution::SweptVolumeCache cache;
+  cache.compute(*trajectory_);
+  ASSERT_EQ(cache.size(), trajectory_->getWayPointCount());
+
+  for (std::size_t i = 0; i < cache.size(); ++i)
+  {
+    EXPECT_FALSE(cache.getWayPointBounds(i).isEmpty());
+    EXPECT_TRUE(cache.getTotalBounds().contains(cache.getWayPointBounds(i)));
+    // the bounds of a waypoint include the motion from the previous waypoint
+    if (i > 0)
+      EXPECT_TRUE(cache.getWayPointBounds(i).intersects(cache.getWayPointBounds(i - 1)));
+  }
+
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_TRUE(cache.getTotalBounds().isEmpty());
+}
+
+TEST_F(SweptVolumeCacheTest, IntersectingWayPoints)
+{
+  plan_execution::SweptVolumeCache cache;
+  cache.compute(*trajectory_, 0.01);
+
+  std::vector<std::size_t> indices;
+
+  // a change far away from the robot does not require any waypoint to be checked
+  cache.getIntersectingWayPoints({ makeBox(Eigen::Vector3d(10.0, 10.0, 10.0), 0.1) }, 0, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // a change at the base of the robot affects every waypoint, in order, starting at the requested index
+  cache.getIntersectingWayPoints({ makeBox(Eigen::Vector3d(0.0, 0.0, 0.1), 0.1) }, 2, indices);
+  ASSERT_EQ(indices.size(), cache.size() - 2);
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    EXPECT_EQ(indices[i], i + 2);
+}
+
+TEST(SweptVolumeCache, ObjectBounds)
+{
+  collision_detection::World world;
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(1.0, 2.0, 3.0);
+  world.addToObject("box", std::make_shared<const shapes::Box>(0.2, 0.2, 0.2), pose);
+
+  moveit::core::AABB bounds;
+  ASSERT_TRUE(plan_execution::computeObjectBounds(*world.getObject("box"), bounds));
+  EXPECT_TRUE(bounds.contains(Eigen::Vector3d(1.1, 2.1, 3.1)));
+  EXPECT_TRUE(bounds.contains(Eigen::Vector3d(0.9, 1.9, 2.9)));
+  EXPECT_FALSE(bounds.contains(Eigen::Vector3d(0.0, 0.0, 0.0)));
+
+  // planes are unbounded
+  world.addToObject("plane", std::make_shared<const shapes::Plane>(0.0, 0.0, 1.0, 0.0), Eigen::Isometry3d::Identity());
+  EXPECT_FALSE(plan_execution::computeObjectBounds(*world.getObject("plane"), bounds));
+}
+
+TEST(SweptVolumeCache, NewlyOccupiedRegions)
+{
+  octomap::OcTree reference(0.05);
+  reference.updateNode(octomap::point3d(1.0, 1.0, 1.0), true);
+  reference.updateNode(octomap::point3d(-1.0, -1.0, -1.0), true);
+
+  // an identical copy has no changes
+  octomap::OcTree octree(reference);
+  std::vector<moveit::core::AABB> regions;
+  ASSERT_TRUE(plan_execution::computeNewlyOccupiedRegions(octree, reference, 3, regions));
+  EXPECT_TRUE(regions.empty());
+
+  // freed voxels cannot invalidate a path, new ones are reported in a single cell
+  octree.setNodeValue(octomap::point3d(-1.0, -1.0, -1.0), octree.getClampingThresMinLog());
+  octree.updateNode(octomap::point3d(0.5, 0.5, 0.5), true);
+  ASSERT_TRUE(plan_execution::computeNewlyOccupiedRegions(octree, reference, 3, regions));
+  ASSERT_EQ(regions.size(), 1u);
+  EXPECT_TRUE(regions[0].contains(Eigen::Vector3d(0.5, 0.5, 0.5)));
+  EXPECT_FALSE(regions[0].contains(Eigen::Vector3d(1.0, 1.0, 1.0)));
+  EXPECT_LE(regions[0].sizes().maxCoeff(), 8 * 0.05 + 1e-9);
+
+  // octrees of different resolutions cannot be compared
+  EXPECT_FALSE(plan_execution::computeNewlyOccupiedRegions(octomap::OcTree(0.1), reference, 3, regions));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -40,6 +40,7 @@
 #include <functional>
 #include <string>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 
 #include <boost/signals2.hpp>
@@ -286,8 +287,16 @@ public:
     return monitor_start_time_;
   }
 
-  /** @brief Add a function that will be called whenever the joint state is updated*/
-  void addUpdateCallback(const JointStateUpdateCallback& fn);
+  /** @brief Add a function that will be called whenever the joint state is updated. Functions may add and remove
+   *  update callbacks themselves.
+   *  @param every_message Also call the function for joint states that do not change the current state, e.g. while
+   *  the robot stands still
+   *  @return An id that can be passed to removeUpdateCallback() */
+  std::size_t addUpdateCallback(const JointStateUpdateCallback& fn, bool every_message = false) const;
+
+  /** @brief Remove a function added with addUpdateCallback(). Once this returns, the function is not called anymore,
+   *  except for a call in progress on the calling thread if this is called from an update callback. */
+  void removeUpdateCallback(std::size_t id) const;
 
   /** @brief Clear the functions to be called when an update to the joint state is received */
   void clearUpdateCallbacks();
@@ -339,7 +348,27 @@ private:
 
   mutable std::mutex state_update_lock_;
   mutable std::condition_variable state_update_condition_;
-  std::vector<JointStateUpdateCallback> update_callbacks_;
+  struct UpdateCallback
+  {
+    JointStateUpdateCallback fn_;
+    bool every_message_;
+  };
+  using UpdateCallbacks = std::map<std::size_t, UpdateCallback>;
+
+  // Call the update callbacks, without holding update_callbacks_lock_. If \e changed is false, only the callbacks
+  // added for every message are called
+  void callUpdateCallbacks(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state, bool changed = true);
+
+  // Replace the update callbacks and wait for calls of the previous ones to finish
+  void setUpdateCallbacks(std::unique_lock<std::mutex>& lock,
+                          const std::shared_ptr<const UpdateCallbacks>& callbacks) const;
+
+  // callbacks can be added and removed while updates are received: the map is replaced as a whole, so the callbacks
+  // are called from a copy of the pointer to it, and calls in progress are detected through its use count
+  mutable std::mutex update_callbacks_lock_;
+  mutable std::condition_variable update_callbacks_condition_;
+  mutable std::shared_ptr<const UpdateCallbacks> update_callbacks_;
+  mutable std::size_t next_update_callback_id_ = 0;
 
   bool use_sim_time_;
 };
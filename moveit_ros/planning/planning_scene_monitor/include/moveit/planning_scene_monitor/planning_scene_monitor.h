@@ -278,6 +278,13 @@ public:
     return current_state_monitor_;
   }
 
+  /** @brief Get the occupancy map monitor, if one was started by startWorldGeometryMonitor()
+   *  @return A pointer to the occupancy map monitor, or nullptr */
+  occupancy_map_monitor::OccupancyMapMonitor* getOccupancyMapMonitor() const
+  {
+    return octomap_monitor_.get();
+  }
+
   /** @brief Update the transforms for the frames that are not part of the kinematic model using tf.
    *  Examples of these frames are the "map" and "odom_combined" transforms. This function is automatically called when
    * data that uses transforms is received.
@@ -0,0 +1,94 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace planning_scene_monitor
+{
+/** @class StateRingBuffer
+    @brief Fixed-capacity buffer of time-stamped vectors of joint positions.
+
+    All memory is allocated on construction. A single writer thread adds samples without locking or allocating;
+    when the buffer is full, the oldest samples are overwritten. Readers can copy out samples concurrently with the
+    writer; samples that are overwritten while they are being copied are detected and dropped. */
+class StateRingBuffer
+{
+public:
+  /** @brief Constructor
+   *  @param[in]  capacity        number of samples the buffer holds
+   *  @param[in]  variable_count  number of values per sample
+   */
+  StateRingBuffer(std::size_t capacity, std::size_t variable_count);
+
+  std::size_t getCapacity() const
+  {
+    return capacity_;
+  }
+
+  std::size_t getVariableCount() const
+  {
+    return variable_count_;
+  }
+
+  /** @brief Add a sample of getVariableCount() \e positions, stamped with \e stamp (in nanoseconds).
+      Only one thread may add samples at a time. */
+  void push(const double* positions, std::int64_t stamp);
+
+  /** @brief Get the number of samples added since construction, including the ones that were overwritten */
+  std::size_t getWriteCount() const
+  {
+    return write_count_.load(std::memory_order_acquire);
+  }
+
+  /** @brief Append the samples with a sequence number of at least \e from to \e positions and \e stamps, oldest first.
+   *  @param[in,out]  from  sequence number (see getWriteCount()) of the first sample to copy; on return, the sequence
+   *                        number of the first sample that was not copied yet
+   *  @return the number of requested samples that were already overwritten */
+  std::size_t copy(std::size_t& from, std::vector<double>& positions, std::vector<std::int64_t>& stamps) const;
+
+private:
+  std::size_t capacity_;
+  std::size_t variable_count_;
+
+  // samples are stored as relaxed atomics, so concurrent reads of a slot that is being overwritten are well-defined
+  std::unique_ptr<std::atomic<double>[]> positions_;
+  std::unique_ptr<std::atomic<std::int64_t>[]> stamps_;
+  std::atomic<std::size_t> write_count_;
+};
+}  // namespace planning_scene_monitor
@@ -39,10 +39,12 @@
 #include <moveit/macros/class_forward.h>
 #include <moveit/robot_state/robot_state.h>
 #include <moveit/planning_scene_monitor/current_state_monitor.h>
+#include <moveit/planning_scene_monitor/state_ring_buffer.h>
 #include <moveit/robot_trajectory/robot_trajectory.h>
 #include <rclcpp/time.hpp>
 #include <memory>
 #include <functional>
+#include <optional>
 #include <thread>
 
 namespace planning_scene_monitor
@@ -52,7 +54,11 @@ using TrajectoryStateAddedCallback = std::function<void(const moveit::core::Robo
 MOVEIT_CLASS_FORWARD(TrajectoryMonitor);  // Defines TrajectoryMonitorPtr, ConstPtr, WeakPtr... etc
 
 /** @class TrajectoryMonitor
-    @brief Monitors the joint_states topic and tf to record the trajectory of the robot. */
+    @brief Monitors the joint_states topic and tf to record the trajectory of the robot.
+
+    By default, the current state is sampled at a fixed frequency from a separate thread. Alternatively, every update
+    of the current state monitor can be recorded into a preallocated buffer (see setStateBufferCapacity()), which is
+    cheap enough for recording at the rate of the joint states. */
 class TrajectoryMonitor
 {
 public:
@@ -108,15 +114,31 @@ public:
 
   void setSamplingFrequency(double sampling_frequency);
 
+  /** @brief Record the state on every update of the current state monitor into a preallocated buffer of \e capacity
+   *  states, instead of sampling it from a separate thread. A capacity of 0 switches back to sampling.
+   *
+   *  In this mode, a positive sampling frequency limits the rate states are recorded at. The buffered states are only
+   *  converted into the trajectory when getTrajectory() or swapTrajectory() is called, which is also when the
+   *  callback set with setOnStateAddCallback() is called. If more than \e capacity - 1 states are recorded in between,
+   *  the oldest ones are lost. The capacity cannot be changed while the monitor is active. */
+  void setStateBufferCapacity(std::size_t capacity);
+
+  std::size_t getStateBufferCapacity() const
+  {
+    return state_buffer_ ? state_buffer_->getCapacity() : 0;
+  }
+
   /// Return the current maintained trajectory. This function is not thread safe (hence NOT const), because the
   /// trajectory could be modified.
   const robot_trajectory::RobotTrajectory& getTrajectory()
   {
+    materializeBufferedStates();
     return trajectory_;
   }
 
   void swapTrajectory(robot_trajectory::RobotTrajectory& other)
   {
+    materializeBufferedStates();
     trajectory_.swap(other);
   }
 
@@ -127,6 +149,13 @@ public:
 
 private:
   void recordStates();
+  void addState(const moveit::core::RobotStatePtr& state, const rclcpp::Time& stamp);
+
+  // Called on updates of the current state monitor, when states are recorded into state_buffer_
+  void bufferState(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state);
+
+  // Append the states in state_buffer_ that were not read yet to trajectory_
+  void materializeBufferedStates();
 
   // Samples robot states.
   CurrentStateMonitorConstPtr current_state_monitor_;
@@ -140,5 +169,12 @@ private:
 
   std::unique_ptr<std::thread> record_states_thread_;
   TrajectoryStateAddedCallback state_add_callback_;
+
+  std::unique_ptr<StateRingBuffer> state_buffer_;
+  std::optional<std::size_t> update_callback_id_;
+  std::size_t state_buffer_read_count_;      // sequence number of the first buffered state not in trajectory_ yet
+  moveit::core::RobotState buffered_state_;  // only used by bufferState(), so recording does not allocate memory
+  std::int64_t buffer_sample_period_;        // nanoseconds
+  std::int64_t last_buffered_stamp_;         // nanoseconds
 };
 }  // namespace planning_scene_monitor
@@ -51,7 +51,10 @@ using namespace std::chrono_literals;
 namespace
 {
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_ros.current_state_monitor");
-}
+
+// the monitor whose update callbacks are being called on this thread, if any
+thread_local const CurrentStateMonitor* calling_update_callbacks = nullptr;
+}  // namespace
 
 CurrentStateMonitor::CurrentStateMonitor(std::unique_ptr<CurrentStateMonitor::MiddlewareHandle> middleware_handle,
                                          const moveit::core::RobotModelConstPtr& robot_model,
@@ -137,15 +140,86 @@ void CurrentStateMonitor::setToCurrentState(moveit::core::RobotState& upd) const
   }
 }
 
-void CurrentStateMonitor::addUpdateCallback(const JointStateUpdateCallback& fn)
+std::size_t CurrentStateMonitor::addUpdateCallback(const JointStateUpdateCallback& fn, bool every_message) const
 {
+  std::unique_lock<std::mutex> lock(update_callbacks_lock_);
+  const std::size_t id = next_update_callback_id_++;
   if (fn)
-    update_callbacks_.push_back(fn);
+  {
+    auto callbacks = update_callbacks_ ? std::make_shared<UpdateCallbacks>(*update_callbacks_) :
+                                         std::make_shared<UpdateCallbacks>();
+    callbacks->emplace(id, UpdateCallback{ fn, every_message });
+    update_callbacks_ = callbacks;
+  }
+  return id;
+}
+
+void CurrentStateMonitor::removeUpdateCallback(std::size_t id) const
+{
+  std::unique_lock<std::mutex> lock(update_callbacks_lock_);
+  if (!update_callbacks_ || update_callbacks_->find(id) == update_callbacks_->end())
+    return;
+  auto callbacks = std::make_shared<UpdateCallbacks>(*update_callbacks_);
+  callbacks->erase(id);
+  setUpdateCallbacks(lock, callbacks);
 }
 
 void CurrentStateMonitor::clearUpdateCallbacks()
 {
-  update_callbacks_.clear();
+  std::unique_lock<std::mutex> lock(update_callbacks_lock_);
+  setUpdateCallbacks(lock, nullptr);
+}
+
+void CurrentStateMonitor::setUpdateCallbacks(std::unique_lock<std::mutex>& lock,
+                                             const std::shared_ptr<const UpdateCallbacks>& callbacks) const
+{
+  std::shared_ptr<const UpdateCallbacks> previous = callbacks;
+  previous.swap(update_callbacks_);
+  // a call in progress on this thread cannot finish while we wait for it
+  if (!previous || calling_update_callbacks == this)
+    return;
+  update_callbacks_condition_.wait(lock, [&previous] { return previous.use_count() == 1; });
+}
+
+void CurrentStateMonitor::callUpdateCallbacks(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state,
+                                              bool changed)
+{
+  std::shared_ptr<const UpdateCallbacks> callbacks;
+  {
+    std::scoped_lock lock(update_callbacks_lock_);
+    callbacks = update_callbacks_;
+  }
+  if (!callbacks)
+    return;
+
+  const CurrentStateMonitor* const outer = calling_update_callbacks;
+  calling_update_callbacks = this;
+  try
+  {
+    for (const std::pair<const std::size_t, UpdateCallback>& update_callback : *callbacks)
+    {
+      if (changed || update_callback.second.every_message_)
+        update_callback.second.fn_(joint_state);
+    }
+  }
+  catch (...)
+  {
+    calling_update_callbacks = outer;
+    {
+      std::scoped_lock lock(update_callbacks_lock_);
+      callbacks.reset();
+    }
+    update_callbacks_condition_.notify_all();
+    throw;
+  }
+  calling_update_callbacks = outer;
+
+  // release the callbacks under the lock, so removeUpdateCallback() does not miss the notification
+  {
+    std::scoped_lock lock(update_callbacks_lock_);
+    callbacks.reset();
+  }
+  update_callbacks_condition_.notify_all();
 }
 
 void CurrentStateMonitor::startStateMonitor(const std::string& joint_states_topic)
@@ -406,12 +480,8 @@ void CurrentStateMonitor::jointStateCallback(const sensor_msgs::msg::JointState:
     }
   }
 
-  // callbacks, if needed
-  if (update)
-  {
-    for (JointStateUpdateCallback& update_callback : update_callbacks_)
-      update_callback(joint_state);
-  }
+  // callbacks, if needed. Callbacks for every message also see joint states that repeat the current state
+  callUpdateCallbacks(joint_state, update);
 
   // notify waitForCurrentState() *after* potential update callbacks
   state_update_condition_.notify_all();
@@ -485,8 +555,7 @@ void CurrentStateMonitor::updateMultiDofJoints()
     // stub joint state: multi-dof joints are not modelled in the message,
     // but we should still trigger the update callbacks
     auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
-    for (JointStateUpdateCallback& update_callback : update_callbacks_)
-      update_callback(joint_state);
+    callUpdateCallbacks(joint_state);
   }
 
   if (update)
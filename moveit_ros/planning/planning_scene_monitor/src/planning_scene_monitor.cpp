@@ -434,7 +434,7 @@ void PlanningSceneMonitor::scenePublishingThread()
     moveit_msgs::msg::PlanningScene msg;
     {
       collision_detection::OccMapTree::ReadLock lock;
-      if (octomap_monitor_)
+      if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
         lock = octomap_monitor_->getOcTreePtr()->reading();
       scene_->getPlanningSceneMsg(msg);
     }
@@ -463,7 +463,7 @@ void PlanningSceneMonitor::scenePublishingThread()
           else
           {
             collision_detection::OccMapTree::ReadLock lock;
-            if (octomap_monitor_)
+            if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
               lock = octomap_monitor_->getOcTreePtr()->reading();
             scene_->getPlanningSceneDiffMsg(msg);
             if (new_scene_update_ == UPDATE_STATE)
@@ -495,7 +495,7 @@ void PlanningSceneMonitor::scenePublishingThread()
           if (is_full)
           {
             collision_detection::OccMapTree::ReadLock lock;
-            if (octomap_monitor_)
+            if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
               lock = octomap_monitor_->getOcTreePtr()->reading();
             scene_->getPlanningSceneMsg(msg);
           }
@@ -687,6 +687,7 @@ void PlanningSceneMonitor::clearOctomap()
       octomap_monitor_->getOcTreePtr()->lockWrite();
       octomap_monitor_->getOcTreePtr()->clear();
       octomap_monitor_->getOcTreePtr()->unlockWrite();
+      octomap_monitor_->requestSnapshot();
     }
     else
     {
@@ -725,6 +726,7 @@ bool PlanningSceneMonitor::newPlanningSceneMessage(const moveit_msgs::msg::Plann
         octomap_monitor_->getOcTreePtr()->lockWrite();
         octomap_monitor_->getOcTreePtr()->clear();
         octomap_monitor_->getOcTreePtr()->unlockWrite();
+        octomap_monitor_->requestSnapshot();
       }
     }
     robot_model_ = scene_->getRobotModel();
@@ -798,6 +800,7 @@ void PlanningSceneMonitor::newPlanningSceneWorldCallback(
           octomap_monitor_->getOcTreePtr()->lockWrite();
           octomap_monitor_->getOcTreePtr()->clear();
           octomap_monitor_->getOcTreePtr()->unlockWrite();
+          octomap_monitor_->requestSnapshot();
         }
       }
     }
@@ -1121,13 +1124,13 @@ bool PlanningSceneMonitor::waitForCurrentRobotState(const rclcpp::Time& t, doubl
 void PlanningSceneMonitor::lockSceneRead()
 {
   scene_update_mutex_.lock_shared();
-  if (octomap_monitor_)
+  if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
     octomap_monitor_->getOcTreePtr()->lockRead();
 }
 
 void PlanningSceneMonitor::unlockSceneRead()
 {
-  if (octomap_monitor_)
+  if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
     octomap_monitor_->getOcTreePtr()->unlockRead();
   scene_update_mutex_.unlock_shared();
 }
@@ -1135,13 +1138,13 @@ void PlanningSceneMonitor::unlockSceneRead()
 void PlanningSceneMonitor::lockSceneWrite()
 {
   scene_update_mutex_.lock();
-  if (octomap_monitor_)
+  if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
     octomap_monitor_->getOcTreePtr()->lockWrite();
 }
 
 void PlanningSceneMonitor::unlockSceneWrite()
 {
-  if (octomap_monitor_)
+  if (octomap_monitor_ && !octomap_monitor_->hasSnapshots())
     octomap_monitor_->getOcTreePtr()->unlockWrite();
   scene_update_mutex_.unlock();
 }
@@ -1427,16 +1430,24 @@ void PlanningSceneMonitor::octomapUpdateCallback()
   {
     std::unique_lock<std::shared_mutex> ulock(scene_update_mutex_);
     last_update_time_ = rclcpp::Clock().now();
-    octomap_monitor_->getOcTreePtr()->lockRead();
-    try
+    if (octomap_monitor_->hasSnapshots())
     {
-      scene_->processOctomapPtr(octomap_monitor_->getOcTreePtr(), Eigen::Isometry3d::Identity());
-      octomap_monitor_->getOcTreePtr()->unlockRead();
+      // snapshots are immutable, the updaters keep writing to the live tree meanwhile
+      scene_->processOctomapPtr(octomap_monitor_->getOcTreeSnapshot(), Eigen::Isometry3d::Identity());
     }
-    catch (...)
+    else
     {
-      octomap_monitor_->getOcTreePtr()->unlockRead();  // unlock and rethrow
-      throw;
+      octomap_monitor_->getOcTreePtr()->lockRead();
+      try
+      {
+        scene_->processOctomapPtr(octomap_monitor_->getOcTreePtr(), Eigen::Isometry3d::Identity());
+        octomap_monitor_->getOcTreePtr()->unlockRead();
+      }
+      catch (...)
+      {
+        octomap_monitor_->getOcTreePtr()->unlockRead();  // unlock and rethrow
+        throw;
+      }
     }
   }
   triggerSceneUpdateEvent(UPDATE_GEOMETRY);
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/planning_scene_monitor/state_ring_buffer.h>
+#include <algorithm>
+
+namespace planning_scene_monitor
+{
+StateRingBuffer::StateRingBuffer(std::size_t capacity, std::size_t variable_count)
+  : capacity_(std::max<std::size_t>(capacity, 1))
+  , variable_count_(variable_count)
+  , positions_(new std::atomic<double>[capacity_ * variable_count_])
+  , stamps_(new std::atomic<std::int64_t>[capacity_])
+  , write_count_(0)
+{
+}
+
+void StateRingBuffer::push(const double* positions, std::int64_t stamp)
+{
+  const std::size_t sequence = write_count_.load(std::memory_order_relaxed);
+  const std::size_t slot = sequence % capacity_;
+
+  // a reader that sees any of the values stored below also sees that sample sequence - capacity_ is being overwritten
+  std::atomic_thread_fence(std::memory_order_release);
+  std::atomic<double>* target = &positions_[slot * variable_count_];
+  for (std::size_t i = 0; i < variable_count_; ++i)
+    target[i].store(positions[i], std::memory_order_relaxed);
+  stamps_[slot].store(stamp, std::memory_order_relaxed);
+
+  // publish the sample
+  write_count_.store(sequence + 1, std::memory_order_release);
+}
+
+std::size_t StateRingBuffer::copy(std::size_t& from, std::vector<double>& positions,
+                                  std::vector<std::int64_t>& stamps) const
+{
+  const std::size_t end = write_count_.load(std::memory_order_acquire);
+  const std::size_t oldest = end > capacity_ ? end - capacity_ : 0;
+  const std::size_t begin = std::max(from, oldest);
+  std::size_t lost = begin - std::min(from, begin);
+  if (begin >= end)
+  {
+    from = std::max(from, end);
+    return lost;
+  }
+
+  const std::size_t positions_offset = positions.size();
+  const std::size_t stamps_offset = stamps.size();
+  positions.resize(positions_offset + (end - begin) * variable_count_);
+  stamps.resize(stamps_offset + (end - begin));
+  for (std::size_t sequence = begin; sequence < end; ++sequence)
+  {
+    const std::size_t slot = sequence % capacity_;
+    const std::atomic<double>* source = &positions_[slot * variable_count_];
+    double* target = &positions[positions_offset + (sequence - begin) * variable_count_];
+    for (std::size_t i = 0; i < variable_count_; ++i)
+      target[i] = source[i].load(std::memory_order_relaxed);
+    stamps[stamps_offset + sequence - begin] = stamps_[slot].load(std::memory_order_relaxed);
+  }
+
+  // the writer may have overwritten samples while they were copied; while write_count_ is at written, the sample
+  // being written replaces the one with sequence number written - capacity_
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::size_t written = write_count_.load(std::memory_order_relaxed);
+  const std::size_t valid_begin = std::max(begin, written + 1 > capacity_ ? written + 1 - capacity_ : 0);
+  if (valid_begin > begin)
+  {
+    const std::size_t invalid = std::min(valid_begin, end) - begin;
+    positions.erase(positions.begin() + positions_offset,
+                    positions.begin() + positions_offset + invalid * variable_count_);
+    stamps.erase(stamps.begin() + stamps_offset, stamps.begin() + stamps_offset + invalid);
+    lost += valid_begin - begin;
+  }
+
+  from = std::max(end, valid_begin);
+  return lost;
+}
+}  // namespace planning_scene_monitor
@@ -56,6 +56,10 @@ planning_scene_monitor::TrajectoryMonitor::TrajectoryMonitor(
   , middleware_handle_(std::move(middleware_handle))
   , sampling_frequency_(sampling_frequency)
   , trajectory_(current_state_monitor_->getRobotModel(), "")
+  , state_buffer_read_count_(0)
+  , buffered_state_(current_state_monitor_->getRobotModel())
+  , buffer_sample_period_(0)
+  , last_buffered_stamp_(0)
 {
   setSamplingFrequency(sampling_frequency);
 }
@@ -81,13 +85,46 @@ void planning_scene_monitor::TrajectoryMonitor::setSamplingFrequency(double samp
   sampling_frequency_ = sampling_frequency;
 }
 
+void planning_scene_monitor::TrajectoryMonitor::setStateBufferCapacity(std::size_t capacity)
+{
+  if (isActive())
+  {
+    RCLCPP_ERROR(LOGGER, "The state buffer capacity cannot be changed while the trajectory monitor is active");
+    return;
+  }
+
+  // keep the states recorded so far
+  materializeBufferedStates();
+  if (capacity == 0)
+    state_buffer_.reset();
+  else
+    state_buffer_ =
+        std::make_unique<StateRingBuffer>(capacity, current_state_monitor_->getRobotModel()->getVariableCount());
+  state_buffer_read_count_ = 0;
+}
+
 bool planning_scene_monitor::TrajectoryMonitor::isActive() const
 {
-  return static_cast<bool>(record_states_thread_);
+  return record_states_thread_ || update_callback_id_;
 }
 
 void planning_scene_monitor::TrajectoryMonitor::startTrajectoryMonitor()
 {
+  if (state_buffer_)
+  {
+    if (current_state_monitor_ && !update_callback_id_)
+    {
+      buffer_sample_period_ = sampling_frequency_ > std::numeric_limits<double>::epsilon() ?
+                                  static_cast<std::int64_t>(1e9 / sampling_frequency_) :
+                                  0;
+      last_buffered_stamp_ = std::numeric_limits<std::int64_t>::min();
+      update_callback_id_ = current_state_monitor_->addUpdateCallback(
+          [this](const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state) { bufferState(joint_state); });
+      RCLCPP_DEBUG(LOGGER, "Started trajectory monitor");
+    }
+    return;
+  }
+
   if (sampling_frequency_ > std::numeric_limits<double>::epsilon() && !record_states_thread_)
   {
     record_states_thread_ = std::make_unique<std::thread>([this] { recordStates(); });
@@ -97,6 +134,12 @@ void planning_scene_monitor::TrajectoryMonitor::startTrajectoryMonitor()
 
 void planning_scene_monitor::TrajectoryMonitor::stopTrajectoryMonitor()
 {
+  if (update_callback_id_)
+  {
+    current_state_monitor_->removeUpdateCallback(*update_callback_id_);
+    update_callback_id_.reset();
+    RCLCPP_DEBUG(LOGGER, "Stopped trajectory monitor");
+  }
   if (record_states_thread_)
   {
     std::unique_ptr<std::thread> copy;
@@ -112,6 +155,8 @@ void planning_scene_monitor::TrajectoryMonitor::clearTrajectory()
   if (restart)
     stopTrajectoryMonitor();
   trajectory_.clear();
+  if (state_buffer_)
+    state_buffer_read_count_ = state_buffer_->getWriteCount();
   if (restart)
     startTrajectoryMonitor();
 }
@@ -127,18 +172,62 @@ void planning_scene_monitor::TrajectoryMonitor::recordStates()
   {
     middleware_handle_->sleep();
     std::pair<moveit::core::RobotStatePtr, rclcpp::Time> state = current_state_monitor_->getCurrentStateAndTime();
-    if (trajectory_.empty())
-    {
-      trajectory_.addSuffixWayPoint(state.first, 0.0);
-      trajectory_start_time_ = state.second;
-      last_recorded_state_time_ = state.second;
-    }
-    else
-    {
-      trajectory_.addSuffixWayPoint(state.first, (state.second - last_recorded_state_time_).seconds());
-      last_recorded_state_time_ = state.second;
-    }
-    if (state_add_callback_)
-      state_add_callback_(state.first, state.second);
+    addState(state.first, state.second);
+  }
+}
+
+void planning_scene_monitor::TrajectoryMonitor::addState(const moveit::core::RobotStatePtr& state,
+                                                         const rclcpp::Time& stamp)
+{
+  if (trajectory_.empty())
+  {
+    trajectory_.addSuffixWayPoint(state, 0.0);
+    trajectory_start_time_ = stamp;
+  }
+  else
+  {
+    trajectory_.addSuffixWayPoint(state, (stamp - last_recorded_state_time_).seconds());
+  }
+  last_recorded_state_time_ = stamp;
+  if (state_add_callback_)
+    state_add_callback_(state, stamp);
+}
+
+void planning_scene_monitor::TrajectoryMonitor::bufferState(
+    const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state)
+{
+  // multi-dof updates come with an empty message
+  std::int64_t stamp = rclcpp::Time(joint_state->header.stamp).nanoseconds();
+  if (stamp == 0)
+    stamp = current_state_monitor_->getCurrentStateTime().nanoseconds();
+  if (buffer_sample_period_ > 0 && last_buffered_stamp_ != std::numeric_limits<std::int64_t>::min() &&
+      stamp - last_buffered_stamp_ < buffer_sample_period_)
+    return;
+  last_buffered_stamp_ = stamp;
+
+  current_state_monitor_->setToCurrentState(buffered_state_);
+  state_buffer_->push(buffered_state_.getVariablePositions(), stamp);
+}
+
+void planning_scene_monitor::TrajectoryMonitor::materializeBufferedStates()
+{
+  if (!state_buffer_)
+    return;
+
+  std::vector<double> positions;
+  std::vector<std::int64_t> stamps;
+  const std::size_t lost = state_buffer_->copy(state_buffer_read_count_, positions, stamps);
+  if (lost > 0)
+  {
+    RCLCPP_WARN(LOGGER, "%zu recorded states were overwritten before they were read. Consider a larger state buffer.",
+                lost);
+  }
+
+  const std::size_t variable_count = state_buffer_->getVariableCount();
+  for (std::size_t i = 0; i < stamps.size(); ++i)
+  {
+    auto state = std::make_shared<moveit::core::RobotState>(current_state_monitor_->getRobotModel());
+    state->setVariablePositions(&positions[i * variable_count]);
+    addState(state, rclcpp::Time(stamps[i], RCL_ROS_TIME));
   }
 }
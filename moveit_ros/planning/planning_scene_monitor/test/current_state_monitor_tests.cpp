@@ -199,6 +199,84 @@ TEST(CurrentStateMonitorTests, WaitForCompleteStateWaits)
   EXPECT_NEAR(nanoseconds_slept.count(), 1e+9, 1e3);
 }
 
+TEST(CurrentStateMonitorTests, UpdateCallbacksChangeCallbacksTest)
+{
+  auto mock_middleware_handle = std::make_unique<MockMiddlewareHandle>();
+  planning_scene_monitor::JointStateUpdateCallback joint_state_callback;
+  EXPECT_CALL(*mock_middleware_handle, createJointStateSubscription)
+      .WillOnce(testing::SaveArg<1>(&joint_state_callback));
+
+  // GIVEN a started CurrentStateMonitor with an update callback that replaces itself by another one
+  planning_scene_monitor::CurrentStateMonitor current_state_monitor{
+    std::move(mock_middleware_handle), moveit::core::loadTestingRobotModel("panda"),
+    std::make_shared<tf2_ros::Buffer>(std::make_shared<rclcpp::Clock>()), false
+  };
+  current_state_monitor.startStateMonitor();
+  ASSERT_TRUE(joint_state_callback);
+
+  int first_calls = 0;
+  int second_calls = 0;
+  std::size_t first_id = 0;
+  first_id = current_state_monitor.addUpdateCallback([&](const sensor_msgs::msg::JointState::ConstSharedPtr&) {
+    ++first_calls;
+    current_state_monitor.removeUpdateCallback(first_id);
+    current_state_monitor.addUpdateCallback([&](const sensor_msgs::msg::JointState::ConstSharedPtr&) {
+      ++second_calls;
+    });
+  });
+
+  // WHEN two joint state updates are received
+  for (double position : { 0.1, 0.2 })
+  {
+    auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
+    joint_state->name = { "panda_joint1" };
+    joint_state->position = { position };
+    joint_state_callback(joint_state);
+  }
+
+  // THEN each callback is called once, without deadlocking
+  EXPECT_EQ(first_calls, 1);
+  EXPECT_EQ(second_calls, 1);
+}
+
+TEST(CurrentStateMonitorTests, UpdateCallbacksStalledRobotTest)
+{
+  auto mock_middleware_handle = std::make_unique<MockMiddlewareHandle>();
+  planning_scene_monitor::JointStateUpdateCallback joint_state_callback;
+  EXPECT_CALL(*mock_middleware_handle, createJointStateSubscription)
+      .WillOnce(testing::SaveArg<1>(&joint_state_callback));
+
+  // GIVEN a started CurrentStateMonitor with an update callback and a callback for every message
+  planning_scene_monitor::CurrentStateMonitor current_state_monitor{
+    std::move(mock_middleware_handle), moveit::core::loadTestingRobotModel("panda"),
+    std::make_shared<tf2_ros::Buffer>(std::make_shared<rclcpp::Clock>()), false
+  };
+  current_state_monitor.startStateMonitor();
+  ASSERT_TRUE(joint_state_callback);
+
+  int update_calls = 0;
+  int every_message_calls = 0;
+  current_state_monitor.addUpdateCallback([&](const sensor_msgs::msg::JointState::ConstSharedPtr&) {
+    ++update_calls;
+  });
+  current_state_monitor.addUpdateCallback(
+      [&](const sensor_msgs::msg::JointState::ConstSharedPtr&) { ++every_message_calls; }, true);
+
+  // WHEN a stalled robot keeps publishing the same joint state
+  for (int i = 0; i < 3; ++i)
+  {
+    auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
+    joint_state->header.stamp = rclcpp::Time(i + 1, 0);
+    joint_state->name = { "panda_joint1" };
+    joint_state->position = { 0.1 };
+    joint_state_callback(joint_state);
+  }
+
+  // THEN only the first message is an update, but every message is passed to the callback for every message
+  EXPECT_EQ(update_calls, 1);
+  EXPECT_EQ(every_message_calls, 3);
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,141 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/planning_scene_monitor/state_ring_buffer.h>
+#include <atomic>
+#include <thread>
+
+using planning_scene_monitor::StateRingBuffer;
+
+TEST(StateRingBufferTests, CopyInOrder)
+{
+  StateRingBuffer buffer(8, 2);
+  for (int i = 0; i < 5; ++i)
+  {
+    const double positions[2] = { static_cast<double>(i), -static_cast<double>(i) };
+    buffer.push(positions, i);
+  }
+  EXPECT_EQ(buffer.getWriteCount(), 5u);
+
+  std::size_t from = 0;
+  std::vector<double> positions;
+  std::vector<std::int64_t> stamps;
+  EXPECT_EQ(buffer.copy(from, positions, stamps), 0u);
+  EXPECT_EQ(from, 5u);
+  ASSERT_EQ(stamps.size(), 5u);
+  ASSERT_EQ(positions.size(), 10u);
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(stamps[i], i);
+    EXPECT_EQ(positions[2 * i], i);
+    EXPECT_EQ(positions[2 * i + 1], -i);
+  }
+
+  // nothing new to copy
+  EXPECT_EQ(buffer.copy(from, positions, stamps), 0u);
+  EXPECT_EQ(stamps.size(), 5u);
+}
+
+TEST(StateRingBufferTests, OverwriteOldest)
+{
+  StateRingBuffer buffer(4, 1);
+  for (int i = 0; i < 10; ++i)
+  {
+    const double position = i;
+    buffer.push(&position, i);
+  }
+
+  std::size_t from = 0;
+  std::vector<double> positions;
+  std::vector<std::int64_t> stamps;
+  const std::size_t lost = buffer.copy(from, positions, stamps);
+
+  // the most recent samples are kept, and all others are reported as lost
+  ASSERT_FALSE(stamps.empty());
+  EXPECT_EQ(lost + stamps.size(), 10u);
+  EXPECT_GE(stamps.size(), 3u);
+  EXPECT_EQ(stamps.back(), 9);
+  EXPECT_EQ(from, 10u);
+}
+
+TEST(StateRingBufferTests, ConcurrentReadsAreConsistent)
+{
+  constexpr std::size_t VARIABLE_COUNT = 8;
+  constexpr std::int64_t SAMPLES = 200000;
+  StateRingBuffer buffer(64, VARIABLE_COUNT);
+
+  std::atomic<bool> done{ false };
+  std::thread writer([&] {
+    double positions[VARIABLE_COUNT];
+    for (std::int64_t i = 0; i < SAMPLES; ++i)
+    {
+      std::fill(positions, positions + VARIABLE_COUNT, static_cast<double>(i));
+      buffer.push(positions, i);
+    }
+    done = true;
+  });
+
+  std::size_t from = 0;
+  std::size_t read = 0;
+  std::size_t lost = 0;
+  std::int64_t last_stamp = -1;
+  bool finished = false;
+  while (!finished)
+  {
+    finished = done;
+    std::vector<double> positions;
+    std::vector<std::int64_t> stamps;
+    lost += buffer.copy(from, positions, stamps);
+    for (std::size_t i = 0; i < stamps.size(); ++i)
+    {
+      // samples are never torn and always in order
+      for (std::size_t j = 0; j < VARIABLE_COUNT; ++j)
+        ASSERT_EQ(positions[i * VARIABLE_COUNT + j], static_cast<double>(stamps[i]));
+      ASSERT_GT(stamps[i], last_stamp);
+      last_stamp = stamps[i];
+    }
+    read += stamps.size();
+  }
+  writer.join();
+
+  EXPECT_EQ(read + lost, static_cast<std::size_t>(SAMPLES));
+  EXPECT_EQ(last_stamp, SAMPLES - 1);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -110,6 +110,59 @@ TEST(TrajectoryMonitorTests, SleepAtLeastOnce)
   waitFor(10s, [&]() { return static_cast<bool>(callback_called); });
 }
 
+TEST(TrajectoryMonitorTests, BufferRecordsEveryUpdate)
+{
+  auto mock_trajectory_monitor_middleware_handle = std::make_unique<MockTrajectoryMonitorMiddlewareHandle>();
+  auto mock_current_state_monitor_middleware_handle = std::make_unique<MockCurrentStateMonitorMiddlewareHandle>();
+
+  // THEN we expect the trajectory monitor not to sample the state from its own thread
+  EXPECT_CALL(*mock_trajectory_monitor_middleware_handle, sleep).Times(0);
+
+  // GIVEN a started CurrentStateMonitor, whose joint state subscription we can feed
+  planning_scene_monitor::JointStateUpdateCallback joint_state_callback;
+  EXPECT_CALL(*mock_current_state_monitor_middleware_handle, createJointStateSubscription)
+      .WillOnce(::testing::SaveArg<1>(&joint_state_callback));
+  auto current_state_monitor = std::make_shared<planning_scene_monitor::CurrentStateMonitor>(
+      std::move(mock_current_state_monitor_middleware_handle), moveit::core::loadTestingRobotModel("panda"),
+      std::make_shared<tf2_ros::Buffer>(std::make_shared<rclcpp::Clock>()), false);
+  current_state_monitor->startStateMonitor();
+  ASSERT_TRUE(joint_state_callback);
+
+  // AND a TrajectoryMonitor recording into a state buffer
+  planning_scene_monitor::TrajectoryMonitor trajectory_monitor{ current_state_monitor,
+                                                                std::move(mock_trajectory_monitor_middleware_handle),
+                                                                0.0 };
+  trajectory_monitor.setStateBufferCapacity(100);
+  trajectory_monitor.startTrajectoryMonitor();
+  EXPECT_TRUE(trajectory_monitor.isActive());
+
+  // WHEN joint states are received
+  for (int i = 0; i < 10; ++i)
+  {
+    auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
+    joint_state->header.stamp = rclcpp::Time(1, i * 1000000, RCL_ROS_TIME);
+    joint_state->name = { "panda_joint1" };
+    joint_state->position = { 0.01 * (i + 1) };
+    joint_state_callback(joint_state);
+  }
+  trajectory_monitor.stopTrajectoryMonitor();
+  EXPECT_FALSE(trajectory_monitor.isActive());
+
+  // THEN every update is part of the recorded trajectory, with its time stamp
+  const robot_trajectory::RobotTrajectory& trajectory = trajectory_monitor.getTrajectory();
+  ASSERT_EQ(trajectory.getWayPointCount(), 10u);
+  EXPECT_DOUBLE_EQ(trajectory.getWayPoint(9).getVariablePosition("panda_joint1"), 0.1);
+  EXPECT_NEAR(trajectory.getDuration(), 0.009, 1e-9);
+
+  // AND updates after stopping are not recorded
+  auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
+  joint_state->header.stamp = rclcpp::Time(2, 0, RCL_ROS_TIME);
+  joint_state->name = { "panda_joint1" };
+  joint_state->position = { 1.0 };
+  joint_state_callback(joint_state);
+  EXPECT_EQ(trajectory_monitor.getTrajectory().getWayPointCount(), 10u);
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
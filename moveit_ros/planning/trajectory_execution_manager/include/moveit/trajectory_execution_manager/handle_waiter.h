@@ -0,0 +1,94 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/controller_manager/controller_manager.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trajectory_execution_manager
+{
+/** \brief Waits for several controller handles at once, so the end of an execution is noticed as soon as the last
+    controller reports it.
+
+    Each handle is waited for in its own thread. The threads call MoveItControllerHandle::waitForExecution() with the
+    timeout returned by \e wait_timeout and retry as long as they are not abandoned. A controller that never reports
+    back therefore keeps its thread for at most one timeout after abandon() is called. The threads are owned by the
+    waiter and joined when it is destroyed, so they never outlive the execution they were started for. */
+class HandleWaiter
+{
+public:
+  HandleWaiter(const std::vector<moveit_controller_manager::MoveItControllerHandlePtr>& handles,
+               std::function<rclcpp::Duration()> wait_timeout);
+
+  /** \brief Abandon the handles that did not finish yet and join all threads */
+  ~HandleWaiter();
+
+  HandleWaiter(const HandleWaiter&) = delete;
+  HandleWaiter& operator=(const HandleWaiter&) = delete;
+
+  /** \brief Return true if all handles reported that their execution finished */
+  bool finished() const;
+
+  /** \brief Block until all handles finished or interrupt() is called */
+  void wait();
+
+  /** \brief Block until all handles finished, interrupt() is called or \e timeout passed.
+      \return finished() */
+  bool waitFor(std::chrono::nanoseconds timeout);
+
+  /** \brief Wake up the current or next call to wait() or waitFor(), so the caller can react to other events */
+  void interrupt();
+
+  /** \brief Stop waiting for the handles that did not finish yet, and join the threads. This blocks for at most
+      one wait timeout if a controller does not report back. */
+  void abandon();
+
+private:
+  void waitForHandle(const moveit_controller_manager::MoveItControllerHandlePtr& handle);
+
+  std::function<rclcpp::Duration()> wait_timeout_;
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::size_t pending_;
+  bool abandoned_ = false;
+  bool interrupted_ = false;
+  std::vector<std::thread> threads_;
+};
+}  // namespace trajectory_execution_manager
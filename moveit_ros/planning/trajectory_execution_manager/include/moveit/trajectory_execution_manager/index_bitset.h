@@ -0,0 +1,156 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace trajectory_execution_manager
+{
+/** \brief A set of indices, stored as a bitset.
+
+    Used to represent sets of joints or controllers by their position in an index, so that coverage and overlap
+    tests between sets are a few word-wise operations instead of comparisons of sets of names. Bitsets of different
+    sizes can be combined; missing bits are treated as unset. */
+class IndexBitset
+{
+public:
+  IndexBitset() = default;
+
+  /** \brief Construct an empty set for indices in [0, \e size) */
+  explicit IndexBitset(std::size_t size) : words_((size + BITS_PER_WORD - 1) / BITS_PER_WORD, 0)
+  {
+  }
+
+  void set(std::size_t index)
+  {
+    if (index / BITS_PER_WORD >= words_.size())
+      words_.resize(index / BITS_PER_WORD + 1, 0);
+    words_[index / BITS_PER_WORD] |= std::uint64_t(1) << (index % BITS_PER_WORD);
+  }
+
+  bool test(std::size_t index) const
+  {
+    return index / BITS_PER_WORD < words_.size() &&
+           (words_[index / BITS_PER_WORD] & (std::uint64_t(1) << (index % BITS_PER_WORD))) != 0;
+  }
+
+  /** \brief Check if all indices in \e other are also in this set */
+  bool includes(const IndexBitset& other) const
+  {
+    for (std::size_t i = 0; i < other.words_.size(); ++i)
+    {
+      if ((other.words_[i] & ~word(i)) != 0)
+        return false;
+    }
+    return true;
+  }
+
+  /** \brief Check if this set and \e other have any index in common */
+  bool intersects(const IndexBitset& other) const
+  {
+    const std::size_t count = std::min(words_.size(), other.words_.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if ((words_[i] & other.words_[i]) != 0)
+        return true;
+    }
+    return false;
+  }
+
+  IndexBitset& operator|=(const IndexBitset& other)
+  {
+    if (other.words_.size() > words_.size())
+      words_.resize(other.words_.size(), 0);
+    for (std::size_t i = 0; i < other.words_.size(); ++i)
+      words_[i] |= other.words_[i];
+    return *this;
+  }
+
+  /** \brief Get the number of indices in the set */
+  std::size_t count() const
+  {
+    std::size_t result = 0;
+    for (std::uint64_t w : words_)
+      result += std::bitset<BITS_PER_WORD>(w).count();
+    return result;
+  }
+
+  bool none() const
+  {
+    return std::all_of(words_.begin(), words_.end(), [](std::uint64_t w) { return w == 0; });
+  }
+
+  bool operator==(const IndexBitset& other) const
+  {
+    const std::size_t count = std::max(words_.size(), other.words_.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (word(i) != other.word(i))
+        return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const IndexBitset& other) const
+  {
+    return !(*this == other);
+  }
+
+  /** \brief Strict weak ordering, consistent with operator==, so bitsets can be used as keys of ordered containers */
+  bool operator<(const IndexBitset& other) const
+  {
+    const std::size_t count = std::max(words_.size(), other.words_.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (word(i) != other.word(i))
+        return word(i) < other.word(i);
+    }
+    return false;
+  }
+
+private:
+  static constexpr std::size_t BITS_PER_WORD = 64;
+
+  std::uint64_t word(std::size_t i) const
+  {
+    return i < words_.size() ? words_[i] : 0;
+  }
+
+  std::vector<std::uint64_t> words_;
+};
+}  // namespace trajectory_execution_manager
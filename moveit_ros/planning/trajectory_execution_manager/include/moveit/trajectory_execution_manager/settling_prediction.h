@@ -0,0 +1,62 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <vector>
+
+namespace trajectory_execution_manager
+{
+/** \brief Where and when a moving joint is expected to come to rest */
+struct SettlingPrediction
+{
+  double rest_position = 0.0;
+  double settle_time = 0.0;  // time after the last sample until the joint is within tolerance of rest_position
+};
+
+/** \brief Predict where a joint that is still settling after a motion comes to rest, from its recent positions.
+
+    The joint is assumed to converge exponentially, as it does when a position controller brings it to a halt. The
+    decay rate is estimated from the velocities at the beginning and the end of the samples. \e times are in seconds
+    and must be increasing.
+    \return false if there are fewer than three samples, or if they do not show a converging motion */
+bool predictSettling(const std::vector<double>& times, const std::vector<double>& positions, double tolerance,
+                     SettlingPrediction& prediction);
+
+/** \brief Check that samples taken at \e times are still current at \e now, i.e. that the newest one is at most
+    \e max_periods average sample periods old. A prediction from samples that stopped arriving while the joint was
+    moving would extrapolate a motion nobody observes anymore.
+    \return false if there are fewer than two samples */
+bool samplesAreRecent(const std::vector<double>& times, double now, double max_periods = 3.0);
+}  // namespace trajectory_execution_manager
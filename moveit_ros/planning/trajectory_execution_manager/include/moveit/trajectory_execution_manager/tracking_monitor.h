@@ -0,0 +1,84 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <trajectory_msgs/msg/joint_trajectory.hpp>
+#include <string>
+#include <vector>
+
+namespace trajectory_execution_manager
+{
+/** \brief Compares measured joint positions against the expected positions of a trajectory while it is executed.
+
+    The expected positions are interpolated linearly between the trajectory points. They are looked up through a
+    cursor that only moves forward, so checking the states of an execution in chronological order takes constant
+    amortized time per check. */
+class TrackingMonitor
+{
+public:
+  /** \brief Monitor \e trajectory with a tracking tolerance per joint. Joints with a non-positive tolerance are not
+      checked. For joints flagged in \e continuous, position differences are wrapped to [-pi, pi]. */
+  TrackingMonitor(const trajectory_msgs::msg::JointTrajectory& trajectory, std::vector<double> tolerances,
+                  std::vector<bool> continuous = {});
+
+  const std::vector<std::string>& getJointNames() const
+  {
+    return joint_names_;
+  }
+
+  /** \brief Replace the tracking tolerances, ordered as getJointNames(). Missing tolerances disable the check */
+  void setTolerances(std::vector<double> tolerances);
+
+  /** \brief Check \e positions (ordered as getJointNames()) measured at \e time seconds after the trajectory start.
+      Before the start nothing is checked, after the end the positions are compared against the last point.
+      \return false if a joint deviates more than its tolerance, in which case \e joint and \e deviation describe the
+      first such joint */
+  bool check(double time, const std::vector<double>& positions, std::size_t& joint, double& deviation);
+
+  /** \brief Get the position of \e joint expected at \e time seconds after the trajectory start */
+  double getExpectedPosition(double time, std::size_t joint);
+
+private:
+  /** \brief Move the cursor to the segment containing \e time and return the interpolation parameter */
+  double seek(double time);
+
+  std::vector<std::string> joint_names_;
+  std::vector<double> times_;
+  std::vector<double> positions_;  // row-major, one row of joint positions per trajectory point
+  std::vector<double> tolerances_;
+  std::vector<bool> continuous_;
+  std::size_t cursor_ = 0;  // index of the trajectory point starting the current segment
+};
+}  // namespace trajectory_execution_manager
@@ -40,14 +40,22 @@
 #include <moveit/robot_model/robot_model.h>
 #include <moveit/planning_scene_monitor/current_state_monitor.h>
 #include <moveit_msgs/msg/robot_trajectory.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <sensor_msgs/msg/joint_state.hpp>
 #include <std_msgs/msg/string.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <moveit/controller_manager/controller_manager.h>
+#include <moveit/trajectory_execution_manager/handle_waiter.h>
+#include <moveit/trajectory_execution_manager/index_bitset.h>
+#include <moveit/trajectory_execution_manager/settling_prediction.h>
+#include <moveit/trajectory_execution_manager/tracking_monitor.h>
 #include <pluginlib/class_loader.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <deque>
+#include <optional>
 #include <thread>
 
 #include <moveit_trajectory_execution_manager_export.h>
@@ -63,6 +71,7 @@ class MOVEIT_TRAJECTORY_EXECUTION_MANAGER_EXPORT TrajectoryExecutionManager
 {
 public:
   static const std::string EXECUTION_EVENT_TOPIC;
+  static const std::string LATENCY_STATISTICS_TOPIC;
 
   /// Definition of the function signature that is called when the execution of all the pushed trajectories completes.
   /// The status of the overall execution is passed as argument
@@ -81,6 +90,9 @@ public:
     // The trajectory to execute, split in different parts (by joints), each set of joints corresponding to one
     // controller
     std::vector<moveit_msgs::msg::RobotTrajectory> trajectory_parts_;
+
+    // The trajectory is not started before this time, e.g. to let the robot settle first. Zero means immediately
+    rclcpp::Time earliest_start_{ 0, 0, RCL_ROS_TIME };
   };
 
   /// Load the controller manager plugin, start listening for events on a topic.
@@ -153,6 +165,13 @@ public:
   /// If no controller is specified, a default is used.
   bool push(const moveit_msgs::msg::RobotTrajectory& trajectory, const std::vector<std::string>& controllers);
 
+  /// Append a trajectory to the trajectory currently being executed, without stopping the robot in between.
+  /// This requires trajectory streaming to be enabled, the last pushed trajectory to be executing and all of its
+  /// controllers to support trajectory replacement. The trajectory needs to start where the executing one ends; it is
+  /// executed by the same controllers and becomes part of the executing trajectory (also for
+  /// getCurrentExpectedTrajectoryIndex()).
+  bool appendToExecution(const moveit_msgs::msg::RobotTrajectory& trajectory);
+
   /// Get the trajectories to be executed
   const std::vector<TrajectoryExecutionContext*>& getTrajectories() const;
 
@@ -183,6 +202,14 @@ public:
   /// Return the controller status for the last attempted execution
   moveit_controller_manager::ExecutionStatus getLastExecutionStatus() const;
 
+  /// Return the time (in seconds) it took each controller of the last executed trajectory to accept its goal,
+  /// measured from the moment the goals were dispatched
+  std::map<std::string, double> getLastDispatchLatencies() const;
+
+  /// Return the time the robot was commanded to start moving along the last executed trajectory and the time its
+  /// controllers reported the end of the motion. The times are default constructed if execution did not get that far.
+  std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point> getLastMotionTimes() const;
+
   /// Stop whatever executions are active, if any
   void stopExecution(bool auto_clear = true);
 
@@ -211,6 +238,35 @@ public:
   /// Enable or disable waiting for trajectory completion
   void setWaitForTrajectoryCompletion(bool flag);
 
+  /// Enable or disable trajectory streaming. When enabled, trajectories are sent to the controllers with an explicit
+  /// start time, so that appendToExecution() can extend them seamlessly
+  void setTrajectoryStreaming(bool flag);
+
+  /// When a trajectory is executed by multiple controllers, all of them are sent the same start time, so they start
+  /// moving simultaneously. This sets how far in the future (in seconds) that start time is, to leave time for
+  /// dispatching the goals. By default, this is 0.0: the delay is then derived from the dispatch latencies measured for
+  /// the controllers, and no start time is sent until the latencies of all of them are known
+  void setSynchronizedStartDelay(double delay);
+
+  /// Enable or disable the collection of timing statistics of the execution pipeline (see
+  /// moveit::core::LatencyTracer::getGlobal()). If \e period is positive, the statistics are also published
+  /// with that period (in seconds) on LATENCY_STATISTICS_TOPIC. By default, tracing is disabled
+  void setLatencyStatisticsPeriod(double period);
+
+  /// Enable or disable the predictive start state check. When enabled, a trajectory whose start deviates from the
+  /// current state is still accepted if the recent joint states show the robot settling to the start of the
+  /// trajectory. Execution is then delayed by the predicted settle time, instead of waiting for the robot to stop at
+  /// the end of every execution. The prediction is only used while joint states keep arriving. By default, this is
+  /// disabled
+  void setPredictiveStartCheck(bool flag);
+
+  /// Enable monitoring how closely the robot follows the executed trajectories. Every received joint state is compared
+  /// against the expected position at its time stamp, and execution is aborted as soon as a joint deviates by more
+  /// than its tolerance. \e joint_tolerances overrides \e tolerance for individual joints. Joints with a non-positive
+  /// tolerance are not monitored. New tolerances also apply to the trajectory being executed. By default, no joints are
+  /// monitored
+  void setTrackingTolerance(double tolerance, const std::map<std::string, double>& joint_tolerances = {});
+
   rclcpp::Node::SharedPtr getControllerManagerNode()
   {
     return controller_mgr_node_;
@@ -222,6 +278,8 @@ private:
     std::string name_;
     std::set<std::string> joints_;
     std::set<std::string> overlapping_controllers_;
+    std::size_t index_ = 0;   // position of the controller in known_controllers_
+    IndexBitset joint_bits_;  // joints_, as indices into joint_indices_
     moveit_controller_manager::MoveItControllerManager::ControllerState state_;
     rclcpp::Time last_update_{ 0, 0, RCL_ROS_TIME };
 
@@ -237,8 +295,44 @@ private:
 
   void reloadControllerInformation();
 
-  /// Validate first point of trajectory matches current robot state
-  bool validate(const TrajectoryExecutionContext& context) const;
+  /// Reload the controller information only if the controller manager reports a change, or cannot report changes
+  void refreshControllerInformation();
+
+  /// Validate first point of trajectory matches current robot state. If the robot is predicted to settle at the first
+  /// point, \e settle_time is set to the time (in seconds) this takes
+  bool validate(const TrajectoryExecutionContext& context, double& settle_time) const;
+
+  /// Record the joint states used for predicting the rest state in validate()
+  void recordJointState(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state);
+
+  /// Predict where \e joint comes to rest from the recorded joint states. The settle time is relative to now
+  bool predictJointSettling(const std::string& joint, double tolerance, SettlingPrediction& prediction) const;
+
+  /// A trajectory part whose execution is compared against the joint states
+  struct TrackedPart
+  {
+    TrackingMonitor monitor_;
+    rclcpp::Time start_;                      // time the controller starts executing the part
+    std::vector<std::size_t> state_indices_;  // index of each joint of the part in tracked_state_names_
+  };
+
+  /// Start comparing the joint states against the parts of \e context, which are started at \e start_time unless
+  /// they have a time stamp
+  void startTrackingMonitor(const TrajectoryExecutionContext& context, const rclcpp::Time& start_time);
+  void stopTrackingMonitor();
+
+  /// Compare \e joint_state against the executed trajectory. On a deviation, tracking_violated_ is set and
+  /// executePart() is woken up to stop the execution; canceling the controllers blocks, so it is not done here
+  void checkTracking(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state);
+
+  /// Get the tracking tolerances of \e joint_names. tracking_mutex_ needs to be locked by the caller
+  std::vector<double> getTrackingTolerances(const std::vector<std::string>& joint_names) const;
+
+  /// Get how far in the future the common start time of the trajectory parts for \e controllers is, 0.0 if unknown
+  double getSynchronizedStartDelay(const std::vector<std::string>& controllers) const;
+
+  /// Change the tracking tolerance of \e joint, or the default one if \e joint is empty, keeping all others
+  void updateTrackingTolerance(const std::string& joint, double tolerance);
   bool configure(TrajectoryExecutionContext& context, const moveit_msgs::msg::RobotTrajectory& trajectory,
                  const std::vector<std::string>& controllers);
 
@@ -250,15 +344,23 @@ private:
                             const std::vector<std::string>& controllers,
                             std::vector<moveit_msgs::msg::RobotTrajectory>& parts);
 
-  bool findControllers(const std::set<std::string>& actuated_joints, std::size_t controller_count,
-                       const std::vector<std::string>& available_controllers,
+  struct ControllerSelection
+  {
+    bool found_;
+    std::vector<std::string> controllers_;
+  };
+
+  bool findControllers(const IndexBitset& actuated_joints, std::size_t controller_count,
+                       const std::vector<const ControllerInformation*>& available_controllers,
                        std::vector<std::string>& selected_controllers);
-  bool checkControllerCombination(std::vector<std::string>& controllers, const std::set<std::string>& actuated_joints);
+  bool checkControllerCombination(const std::vector<const ControllerInformation*>& controllers,
+                                  const IndexBitset& combined_joints, const IndexBitset& actuated_joints);
   void generateControllerCombination(std::size_t start_index, std::size_t controller_count,
-                                     const std::vector<std::string>& available_controllers,
-                                     std::vector<std::string>& selected_controllers,
+                                     const std::vector<const ControllerInformation*>& available_controllers,
+                                     std::vector<const ControllerInformation*>& selected_controllers,
+                                     const IndexBitset& combined_joints,
                                      std::vector<std::vector<std::string> >& selected_options,
-                                     const std::set<std::string>& actuated_joints);
+                                     const IndexBitset& actuated_joints);
   bool selectControllers(const std::set<std::string>& actuated_joints,
                          const std::vector<std::string>& available_controllers,
                          std::vector<std::string>& selected_controllers);
@@ -268,9 +370,13 @@ private:
   bool executePart(std::size_t part_index);
   bool waitForRobotToStop(const TrajectoryExecutionContext& context, double wait_time = 1.0);
 
+  /// Rebuild time_index_ from the points of the part of the current context it was built from
+  void updateTimeIndex(const TrajectoryExecutionContext& context);
+
   void stopExecutionInternal();
 
   void receiveEvent(const std_msgs::msg::String::ConstSharedPtr& event);
+  void publishLatencyStatistics();
 
   void loadControllerParams();
 
@@ -284,7 +390,16 @@ private:
   moveit::core::RobotModelConstPtr robot_model_;
   planning_scene_monitor::CurrentStateMonitorPtr csm_;
   rclcpp::Subscription<std_msgs::msg::String>::SharedPtr event_topic_subscriber_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr latency_statistics_publisher_;
+  rclcpp::TimerBase::SharedPtr latency_statistics_timer_;
   std::map<std::string, ControllerInformation> known_controllers_;
+  std::map<std::string, std::size_t> joint_indices_;  // index of all joints of the known controllers
+  // revision of the controller manager's information that known_controllers_ reflects, 0 if it cannot report changes
+  std::uint64_t known_controllers_revision_ = 0;
+
+  // results of selectControllers(), keyed by the actuated joints and the available controllers;
+  // cleared whenever the known controllers or their state change
+  std::map<std::pair<IndexBitset, IndexBitset>, ControllerSelection> controller_selection_cache_;
   bool manage_controllers_;
 
   // thread used to execute trajectories using the execute() command
@@ -300,8 +415,17 @@ private:
   std::vector<moveit_controller_manager::MoveItControllerHandlePtr> active_handles_;
   int current_context_;
   std::vector<rclcpp::Time> time_index_;  // used to find current expected trajectory location
+  rclcpp::Time time_index_start_;         // time the trajectory part used for the time index starts at
+  int time_index_part_;                   // index of the trajectory part used for the time index
+  rclcpp::Duration appended_duration_{ 0, 0 };  // duration added to the current context by appendToExecution()
   mutable std::mutex time_index_mutex_;
+  std::map<std::string, double> dispatch_latencies_;
+  std::map<std::string, double> controller_dispatch_latencies_;  // latest dispatch latency of every controller
+  std::chrono::steady_clock::time_point motion_start_time_;  // commanded start of the first part
+  std::chrono::steady_clock::time_point motion_end_time_;    // end of the last part reported by the controllers
+  mutable std::mutex dispatch_latencies_mutex_;              // also protects the motion times
   bool execution_complete_;
+  std::chrono::steady_clock::time_point execution_request_time_;  // time execute() was called, for latency tracing
 
   std::vector<TrajectoryExecutionContext*> trajectories_;
 
@@ -322,6 +446,23 @@ private:
   double allowed_start_tolerance_;  // joint tolerance for validate(): radians for revolute joints
   double execution_velocity_scaling_;
   bool wait_for_trajectory_completion_;
+  bool trajectory_streaming_;
+  double synchronized_start_delay_;
+
+  bool predictive_start_check_;
+  std::optional<std::size_t> joint_state_callback_id_;  // registered with csm_ while predictive_start_check_ is set
+  std::deque<sensor_msgs::msg::JointState::ConstSharedPtr> joint_state_history_;
+  mutable std::mutex joint_state_history_mutex_;
+
+  double tracking_tolerance_;
+  std::map<std::string, double> joint_tracking_tolerances_;
+  std::optional<std::size_t> tracking_callback_id_;  // called for every joint state while any joint is monitored
+  std::vector<TrackedPart> tracked_parts_;
+  std::vector<std::string> tracked_state_names_;  // joint names of the last checked joint state
+  std::vector<double> tracked_positions_;         // buffer for the positions of a tracked part
+  HandleWaiter* tracking_waiter_ = nullptr;       // woken up on tracking violations while executePart() waits
+  std::mutex tracking_mutex_;
+  std::atomic<bool> tracking_violated_{ false };
 
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr callback_handler_;
 };
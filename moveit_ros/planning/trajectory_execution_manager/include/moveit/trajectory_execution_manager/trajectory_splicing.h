@@ -0,0 +1,53 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit_msgs/msg/robot_trajectory.hpp>
+
+namespace trajectory_execution_manager
+{
+/** \brief Append \e next to the end of \e trajectory, keeping the time parameterization continuous.
+
+    The points of \e next are shifted in time by the duration of \e trajectory. If the first point of \e next has a
+    zero time_from_start, it is expected to duplicate the last point of \e trajectory and is dropped. Both trajectories
+    must be single-dof trajectories for the same joints, and the first point of \e next must match the last point of
+    \e trajectory within \e start_tolerance. \e trajectory is left unmodified if this is not the case.
+    \return true if the points of \e next were appended */
+bool appendTrajectory(moveit_msgs::msg::RobotTrajectory& trajectory, const moveit_msgs::msg::RobotTrajectory& next,
+                      double start_tolerance);
+
+/** \brief Get the time_from_start of the last point of \e trajectory, in seconds */
+double getTrajectoryDuration(const moveit_msgs::msg::RobotTrajectory& trajectory);
+}  // namespace trajectory_execution_manager
@@ -0,0 +1,125 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/trajectory_execution_manager/handle_waiter.h>
+#include <rclcpp/logging.hpp>
+
+namespace trajectory_execution_manager
+{
+static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_ros.trajectory_execution_manager.handle_waiter");
+
+HandleWaiter::HandleWaiter(const std::vector<moveit_controller_manager::MoveItControllerHandlePtr>& handles,
+                           std::function<rclcpp::Duration()> wait_timeout)
+  : wait_timeout_(std::move(wait_timeout)), pending_(handles.size())
+{
+  threads_.reserve(handles.size());
+  for (const moveit_controller_manager::MoveItControllerHandlePtr& handle : handles)
+    threads_.emplace_back(&HandleWaiter::waitForHandle, this, handle);
+}
+
+HandleWaiter::~HandleWaiter()
+{
+  abandon();
+}
+
+bool HandleWaiter::finished() const
+{
+  std::scoped_lock lock(mutex_);
+  return pending_ == 0;
+}
+
+void HandleWaiter::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this] { return pending_ == 0 || interrupted_; });
+  interrupted_ = false;
+}
+
+bool HandleWaiter::waitFor(std::chrono::nanoseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait_for(lock, timeout, [this] { return pending_ == 0 || interrupted_; });
+  interrupted_ = false;
+  return pending_ == 0;
+}
+
+void HandleWaiter::interrupt()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    interrupted_ = true;
+  }
+  condition_.notify_all();
+}
+
+void HandleWaiter::abandon()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    abandoned_ = true;
+  }
+  for (std::thread& thread : threads_)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+}
+
+void HandleWaiter::waitForHandle(const moveit_controller_manager::MoveItControllerHandlePtr& handle)
+{
+  while (true)
+  {
+    bool done = false;
+    try
+    {
+      done = handle->waitForExecution(wait_timeout_());
+    }
+    catch (std::exception& ex)
+    {
+      RCLCPP_ERROR(LOGGER, "Caught %s when waiting for controller %s", ex.what(), handle->getName().c_str());
+      done = true;
+    }
+
+    std::scoped_lock lock(mutex_);
+    if (done)
+    {
+      --pending_;
+      break;
+    }
+    if (abandoned_)
+      return;
+  }
+  condition_.notify_all();
+}
+}  // namespace trajectory_execution_manager
@@ -0,0 +1,83 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/trajectory_execution_manager/settling_prediction.h>
+#include <cmath>
+
+namespace trajectory_execution_manager
+{
+bool predictSettling(const std::vector<double>& times, const std::vector<double>& positions, double tolerance,
+                     SettlingPrediction& prediction)
+{
+  const std::size_t n = times.size();
+  if (n < 3 || positions.size() != n)
+    return false;
+
+  const double first_dt = times[1] - times[0];
+  const double last_dt = times[n - 1] - times[n - 2];
+  if (first_dt <= 0.0 || last_dt <= 0.0)
+    return false;
+
+  prediction.rest_position = positions[n - 1];
+  prediction.settle_time = 0.0;
+
+  const double last_velocity = (positions[n - 1] - positions[n - 2]) / last_dt;
+  if (last_velocity == 0.0)
+    return true;  // already at rest
+
+  // a velocity decaying from first_velocity to last_velocity over the time between the two samples gives the time
+  // constant of the convergence; any other progression (accelerating, reversing) is not a settling motion
+  const double first_velocity = (positions[1] - positions[0]) / first_dt;
+  const double ratio = last_velocity / first_velocity;
+  if (!(ratio > 0.0 && ratio < 1.0))
+    return false;
+  const double interval = 0.5 * (times[n - 1] + times[n - 2]) - 0.5 * (times[1] + times[0]);
+  const double time_constant = -interval / std::log(ratio);
+
+  // the last step covered the fraction (1 - exp(-last_dt / time_constant)) of the offset left before it
+  const double remaining = (positions[n - 1] - positions[n - 2]) / std::expm1(last_dt / time_constant);
+  prediction.rest_position = positions[n - 1] + remaining;
+  if (std::fabs(remaining) > tolerance && tolerance > 0.0)
+    prediction.settle_time = time_constant * std::log(std::fabs(remaining) / tolerance);
+  return true;
+}
+
+bool samplesAreRecent(const std::vector<double>& times, double now, double max_periods)
+{
+  if (times.size() < 2)
+    return false;
+  const double period = (times.back() - times.front()) / static_cast<double>(times.size() - 1);
+  return period > 0.0 && now - times.back() <= max_periods * period;
+}
+}  // namespace trajectory_execution_manager
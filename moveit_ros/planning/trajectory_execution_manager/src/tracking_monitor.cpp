@@ -0,0 +1,117 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/trajectory_execution_manager/tracking_monitor.h>
+#include <rclcpp/duration.hpp>
+#include <cmath>
+
+namespace trajectory_execution_manager
+{
+TrackingMonitor::TrackingMonitor(const trajectory_msgs::msg::JointTrajectory& trajectory,
+                                 std::vector<double> tolerances, std::vector<bool> continuous)
+  : joint_names_(trajectory.joint_names), tolerances_(std::move(tolerances)), continuous_(std::move(continuous))
+{
+  const std::size_t joint_count = joint_names_.size();
+  tolerances_.resize(joint_count, 0.0);
+  continuous_.resize(joint_count, false);
+
+  times_.reserve(trajectory.points.size());
+  positions_.reserve(trajectory.points.size() * joint_count);
+  for (const trajectory_msgs::msg::JointTrajectoryPoint& point : trajectory.points)
+  {
+    if (point.positions.size() != joint_count)
+      continue;
+    times_.push_back(rclcpp::Duration(point.time_from_start).seconds());
+    positions_.insert(positions_.end(), point.positions.begin(), point.positions.end());
+  }
+}
+
+void TrackingMonitor::setTolerances(std::vector<double> tolerances)
+{
+  tolerances_ = std::move(tolerances);
+  tolerances_.resize(joint_names_.size(), 0.0);
+}
+
+double TrackingMonitor::seek(double time)
+{
+  // executions are checked in chronological order, so the cursor usually stays or moves by one segment
+  if (cursor_ > 0 && time < times_[cursor_])
+    cursor_ = 0;
+  while (cursor_ + 1 < times_.size() && times_[cursor_ + 1] <= time)
+    ++cursor_;
+
+  if (cursor_ + 1 >= times_.size() || time <= times_[cursor_])
+    return 0.0;
+  return (time - times_[cursor_]) / (times_[cursor_ + 1] - times_[cursor_]);
+}
+
+double TrackingMonitor::getExpectedPosition(double time, std::size_t joint)
+{
+  if (times_.empty())
+    return 0.0;
+  const double t = seek(time);
+  const std::size_t joint_count = joint_names_.size();
+  const double start = positions_[cursor_ * joint_count + joint];
+  if (t == 0.0)
+    return start;
+  return start + t * (positions_[(cursor_ + 1) * joint_count + joint] - start);
+}
+
+bool TrackingMonitor::check(double time, const std::vector<double>& positions, std::size_t& joint, double& deviation)
+{
+  if (times_.empty() || time < times_.front())
+    return true;
+
+  const double t = seek(time);
+  const std::size_t joint_count = joint_names_.size();
+  const double* start = &positions_[cursor_ * joint_count];
+  const double* end = cursor_ + 1 < times_.size() ? start + joint_count : start;
+  for (std::size_t i = 0; i < joint_count && i < positions.size(); ++i)
+  {
+    if (tolerances_[i] <= 0.0)
+      continue;
+
+    double difference = positions[i] - (start[i] + t * (end[i] - start[i]));
+    if (continuous_[i])
+      difference = std::remainder(difference, 2.0 * M_PI);
+    if (std::fabs(difference) > tolerances_[i])
+    {
+      joint = i;
+      deviation = difference;
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace trajectory_execution_manager
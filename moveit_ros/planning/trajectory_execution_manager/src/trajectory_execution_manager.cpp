@@ -35,15 +35,22 @@
 /* Author: Ioan Sucan */
 
 #include <moveit/trajectory_execution_manager/trajectory_execution_manager.h>
+#include <moveit/trajectory_execution_manager/handle_waiter.h>
+#include <moveit/trajectory_execution_manager/trajectory_splicing.h>
 #include <moveit/robot_state/robot_state.h>
+#include <moveit/utils/latency_tracer.h>
 #include <geometric_shapes/check_isometry.h>
 #include <tf2_eigen/tf2_eigen.hpp>
+#include <chrono>
+#include <future>
+#include <limits>
 
 namespace trajectory_execution_manager
 {
 static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_ros.trajectory_execution_manager");
 
 const std::string TrajectoryExecutionManager::EXECUTION_EVENT_TOPIC = "trajectory_execution_event";
+const std::string TrajectoryExecutionManager::LATENCY_STATISTICS_TOPIC = "trajectory_execution_latency";
 
 static const auto DEFAULT_CONTROLLER_INFORMATION_VALIDITY_AGE = rclcpp::Duration::from_seconds(1);
 static const double DEFAULT_CONTROLLER_GOAL_DURATION_MARGIN = 0.5;  // allow 0.5s more than the expected execution time
@@ -51,6 +58,11 @@ static const double DEFAULT_CONTROLLER_GOAL_DURATION_MARGIN = 0.5;  // allow 0.5
                                                                     // after scaling)
 static const double DEFAULT_CONTROLLER_GOAL_DURATION_SCALING =
     1.1;  // allow the execution of a trajectory to take more time than expected (scaled by a value > 1)
+static const double MIN_HANDLE_WAIT_TIMEOUT = 1.0;  // seconds a controller handle is waited for at least per call
+static const std::string JOINT_TRACKING_TOLERANCE_PARAMETER = "trajectory_execution.joint_tracking_tolerance";
+static const std::size_t JOINT_STATE_HISTORY_SIZE = 8;  // joint states kept for predicting the robot's rest state
+// the synchronized start is delayed by this multiple of the measured dispatch latency, if no delay is configured
+static const double SYNCHRONIZED_START_LATENCY_SCALING = 2.0;
 
 TrajectoryExecutionManager::TrajectoryExecutionManager(const rclcpp::Node::SharedPtr& node,
                                                        const moveit::core::RobotModelConstPtr& robot_model,
@@ -74,6 +86,8 @@ TrajectoryExecutionManager::TrajectoryExecutionManager(const rclcpp::Node::Share
 TrajectoryExecutionManager::~TrajectoryExecutionManager()
 {
   stopExecution(true);
+  setPredictiveStartCheck(false);
+  setTrackingTolerance(0.0);
   if (private_executor_)
     private_executor_->cancel();
   if (private_executor_thread_.joinable())
@@ -85,11 +99,16 @@ void TrajectoryExecutionManager::initialize()
   verbose_ = false;
   execution_complete_ = true;
   current_context_ = -1;
+  time_index_part_ = -1;
   last_execution_status_ = moveit_controller_manager::ExecutionStatus::SUCCEEDED;
   execution_duration_monitoring_ = true;
   execution_velocity_scaling_ = 1.0;
   allowed_start_tolerance_ = 0.01;
   wait_for_trajectory_completion_ = true;
+  trajectory_streaming_ = false;
+  synchronized_start_delay_ = 0.0;
+  predictive_start_check_ = false;
+  tracking_tolerance_ = 0.0;
 
   allowed_execution_duration_scaling_ = DEFAULT_CONTROLLER_GOAL_DURATION_SCALING;
   allowed_goal_duration_margin_ = DEFAULT_CONTROLLER_GOAL_DURATION_MARGIN;
@@ -196,6 +215,19 @@ void TrajectoryExecutionManager::initialize()
   controller_mgr_node_->get_parameter("trajectory_execution.allowed_goal_duration_margin",
                                       allowed_goal_duration_margin_);
   controller_mgr_node_->get_parameter("trajectory_execution.allowed_start_tolerance", allowed_start_tolerance_);
+  controller_mgr_node_->get_parameter("trajectory_execution.enable_trajectory_streaming", trajectory_streaming_);
+  controller_mgr_node_->get_parameter("trajectory_execution.synchronized_start_delay", synchronized_start_delay_);
+  bool predictive_start_check = false;
+  if (controller_mgr_node_->get_parameter("trajectory_execution.predictive_start_check", predictive_start_check))
+    setPredictiveStartCheck(predictive_start_check);
+  double tracking_tolerance = 0.0;
+  controller_mgr_node_->get_parameter("trajectory_execution.tracking_tolerance", tracking_tolerance);
+  std::map<std::string, double> joint_tracking_tolerances;
+  controller_mgr_node_->get_parameters(JOINT_TRACKING_TOLERANCE_PARAMETER, joint_tracking_tolerances);
+  setTrackingTolerance(tracking_tolerance, joint_tracking_tolerances);
+  double latency_statistics_period = 0.0;
+  if (controller_mgr_node_->get_parameter("trajectory_execution.latency_statistics_period", latency_statistics_period))
+    setLatencyStatisticsPeriod(latency_statistics_period);
 
   if (manage_controllers_)
   {
@@ -236,6 +268,30 @@ void TrajectoryExecutionManager::initialize()
       {
         setWaitForTrajectoryCompletion(parameter.as_bool());
       }
+      else if (name == "trajectory_execution.enable_trajectory_streaming")
+      {
+        setTrajectoryStreaming(parameter.as_bool());
+      }
+      else if (name == "trajectory_execution.synchronized_start_delay")
+      {
+        setSynchronizedStartDelay(parameter.as_double());
+      }
+      else if (name == "trajectory_execution.latency_statistics_period")
+      {
+        setLatencyStatisticsPeriod(parameter.as_double());
+      }
+      else if (name == "trajectory_execution.predictive_start_check")
+      {
+        setPredictiveStartCheck(parameter.as_bool());
+      }
+      else if (name == "trajectory_execution.tracking_tolerance")
+      {
+        updateTrackingTolerance("", parameter.as_double());
+      }
+      else if (name.rfind(JOINT_TRACKING_TOLERANCE_PARAMETER + ".", 0) == 0)
+      {
+        updateTrackingTolerance(name.substr(JOINT_TRACKING_TOLERANCE_PARAMETER.size() + 1), parameter.as_double());
+      }
       else
       {
         result.successful = false;
@@ -276,6 +332,266 @@ void TrajectoryExecutionManager::setWaitForTrajectoryCompletion(bool flag)
   wait_for_trajectory_completion_ = flag;
 }
 
+void TrajectoryExecutionManager::setTrajectoryStreaming(bool flag)
+{
+  trajectory_streaming_ = flag;
+}
+
+void TrajectoryExecutionManager::setSynchronizedStartDelay(double delay)
+{
+  synchronized_start_delay_ = delay;
+}
+
+void TrajectoryExecutionManager::setLatencyStatisticsPeriod(double period)
+{
+  moveit::core::LatencyTracer::getGlobal().setEnabled(period > 0.0);
+  latency_statistics_timer_.reset();
+  if (period <= 0.0)
+    return;
+
+  if (!latency_statistics_publisher_)
+    latency_statistics_publisher_ = node_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+        LATENCY_STATISTICS_TOPIC, rclcpp::SystemDefaultsQoS());
+  latency_statistics_timer_ =
+      node_->create_wall_timer(std::chrono::duration<double>(period), [this] { publishLatencyStatistics(); });
+}
+
+void TrajectoryExecutionManager::setPredictiveStartCheck(bool flag)
+{
+  predictive_start_check_ = flag;
+  if (flag && !joint_state_callback_id_)
+  {
+    joint_state_callback_id_ = csm_->addUpdateCallback(
+        [this](const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state) { recordJointState(joint_state); });
+  }
+  else if (!flag && joint_state_callback_id_)
+  {
+    csm_->removeUpdateCallback(*joint_state_callback_id_);
+    joint_state_callback_id_.reset();
+    std::scoped_lock slock(joint_state_history_mutex_);
+    joint_state_history_.clear();
+  }
+}
+
+void TrajectoryExecutionManager::recordJointState(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state)
+{
+  std::scoped_lock slock(joint_state_history_mutex_);
+  if (joint_state_history_.size() >= JOINT_STATE_HISTORY_SIZE)
+    joint_state_history_.pop_front();
+  joint_state_history_.push_back(joint_state);
+}
+
+bool TrajectoryExecutionManager::predictJointSettling(const std::string& joint, double tolerance,
+                                                      SettlingPrediction& prediction) const
+{
+  std::vector<double> times, positions;
+  {
+    std::scoped_lock slock(joint_state_history_mutex_);
+    for (const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state : joint_state_history_)
+    {
+      const auto it = std::find(joint_state->name.begin(), joint_state->name.end(), joint);
+      const std::size_t index = it - joint_state->name.begin();
+      if (it == joint_state->name.end() || index >= joint_state->position.size())
+        continue;
+      times.push_back(rclcpp::Time(joint_state->header.stamp).seconds());
+      positions.push_back(joint_state->position[index]);
+    }
+  }
+  // the history only records joint states that changed a position, so a newer current state means the joint stopped
+  // moving after the last recorded sample, and an old last sample means joint states stopped arriving. In both cases
+  // the samples do not describe the joint anymore
+  const double now = node_->now().seconds();
+  if (times.empty() || csm_->getCurrentStateTime().seconds() > times.back() || !samplesAreRecent(times, now))
+    return false;
+  if (!predictSettling(times, positions, tolerance, prediction))
+    return false;
+
+  // part of the settle time has already passed since the last joint state was received
+  prediction.settle_time = std::max(0.0, prediction.settle_time - (now - times.back()));
+  return true;
+}
+
+void TrajectoryExecutionManager::setTrackingTolerance(double tolerance,
+                                                      const std::map<std::string, double>& joint_tolerances)
+{
+  std::unique_lock<std::mutex> ulock(tracking_mutex_);
+  tracking_tolerance_ = tolerance;
+  joint_tracking_tolerances_ = joint_tolerances;
+
+  bool enabled = tolerance > 0.0;
+  for (const auto& [joint, joint_tolerance] : joint_tolerances)
+    enabled = enabled || joint_tolerance > 0.0;
+
+  // the trajectory being executed is checked against the new tolerances from now on
+  for (TrackedPart& part : tracked_parts_)
+    part.monitor_.setTolerances(getTrackingTolerances(part.monitor_.getJointNames()));
+
+  if (enabled && !tracking_callback_id_)
+  {
+    // a robot that stalls keeps publishing the same joint states, which do not count as updates of the current state
+    tracking_callback_id_ = csm_->addUpdateCallback(
+        [this](const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state) { checkTracking(joint_state); },
+        true);
+  }
+  else if (!enabled && tracking_callback_id_)
+  {
+    // the callback locks tracking_mutex_ too, so it is removed without holding it
+    const std::size_t id = *tracking_callback_id_;
+    tracking_callback_id_.reset();
+    tracked_parts_.clear();
+    ulock.unlock();
+    csm_->removeUpdateCallback(id);
+  }
+}
+
+void TrajectoryExecutionManager::updateTrackingTolerance(const std::string& joint, double tolerance)
+{
+  double default_tolerance;
+  std::map<std::string, double> joint_tolerances;
+  {
+    std::scoped_lock slock(tracking_mutex_);
+    default_tolerance = tracking_tolerance_;
+    joint_tolerances = joint_tracking_tolerances_;
+  }
+  if (joint.empty())
+    default_tolerance = tolerance;
+  else
+    joint_tolerances[joint] = tolerance;
+  setTrackingTolerance(default_tolerance, joint_tolerances);
+}
+
+std::vector<double> TrajectoryExecutionManager::getTrackingTolerances(const std::vector<std::string>& joint_names) const
+{
+  std::vector<double> tolerances;
+  tolerances.reserve(joint_names.size());
+  for (const std::string& joint : joint_names)
+  {
+    const auto it = joint_tracking_tolerances_.find(joint);
+    tolerances.push_back(it != joint_tracking_tolerances_.end() ? it->second : tracking_tolerance_);
+  }
+  return tolerances;
+}
+
+void TrajectoryExecutionManager::startTrackingMonitor(const TrajectoryExecutionContext& context,
+                                                      const rclcpp::Time& start_time)
+{
+  std::scoped_lock slock(tracking_mutex_);
+  tracked_parts_.clear();
+  tracked_state_names_.clear();
+  if (!tracking_callback_id_)
+    return;
+
+  for (const moveit_msgs::msg::RobotTrajectory& part : context.trajectory_parts_)
+  {
+    const trajectory_msgs::msg::JointTrajectory& trajectory = part.joint_trajectory;
+    if (trajectory.points.empty())
+      continue;
+
+    std::vector<double> tolerances = getTrackingTolerances(trajectory.joint_names);
+    std::vector<bool> continuous;
+    for (const std::string& joint : trajectory.joint_names)
+    {
+      const moveit::core::JointModel* jm = robot_model_->getJointModel(joint);
+      continuous.push_back(jm && jm->getType() == moveit::core::JointModel::REVOLUTE &&
+                           static_cast<const moveit::core::RevoluteJointModel*>(jm)->isContinuous());
+    }
+
+    const rclcpp::Time stamp(trajectory.header.stamp);
+    tracked_parts_.push_back(TrackedPart{ TrackingMonitor(trajectory, std::move(tolerances), std::move(continuous)),
+                                          stamp.nanoseconds() != 0 ? stamp : start_time, {} });
+  }
+}
+
+void TrajectoryExecutionManager::stopTrackingMonitor()
+{
+  std::scoped_lock slock(tracking_mutex_);
+  tracked_parts_.clear();
+}
+
+void TrajectoryExecutionManager::checkTracking(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state)
+{
+  {
+    std::scoped_lock slock(tracking_mutex_);
+    if (tracked_parts_.empty())
+      return;
+
+    // joint states usually arrive with the same joint order, so the joints only need to be looked up once
+    if (joint_state->name != tracked_state_names_)
+    {
+      tracked_state_names_ = joint_state->name;
+      for (TrackedPart& part : tracked_parts_)
+      {
+        part.state_indices_.clear();
+        for (const std::string& joint : part.monitor_.getJointNames())
+        {
+          part.state_indices_.push_back(std::find(tracked_state_names_.begin(), tracked_state_names_.end(), joint) -
+                                        tracked_state_names_.begin());
+        }
+      }
+    }
+
+    const rclcpp::Time stamp = rclcpp::Time(joint_state->header.stamp).nanoseconds() != 0 ?
+                                   rclcpp::Time(joint_state->header.stamp) :
+                                   node_->now();
+    bool violated = false;
+    for (TrackedPart& part : tracked_parts_)
+    {
+      // joints missing from this joint state are not checked
+      tracked_positions_.resize(part.state_indices_.size());
+      for (std::size_t i = 0; i < part.state_indices_.size(); ++i)
+      {
+        const std::size_t index = part.state_indices_[i];
+        tracked_positions_[i] = index < joint_state->position.size() ? joint_state->position[index] :
+                                                                       std::numeric_limits<double>::quiet_NaN();
+      }
+
+      std::size_t joint = 0;
+      double deviation = 0.0;
+      if (!part.monitor_.check((stamp - part.start_).seconds(), tracked_positions_, joint, deviation))
+      {
+        RCLCPP_ERROR(LOGGER, "Joint '%s' deviates %g from the executed trajectory. Stopping trajectory.",
+                     part.monitor_.getJointNames()[joint].c_str(), deviation);
+        violated = true;
+        break;
+      }
+    }
+    if (!violated)
+      return;
+    tracked_parts_.clear();  // report the violation only once
+    tracking_violated_ = true;
+    if (tracking_waiter_)
+      tracking_waiter_->interrupt();
+  }
+}
+
+void TrajectoryExecutionManager::publishLatencyStatistics()
+{
+  const auto to_key_value = [](const std::string& key, double value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = std::to_string(value);
+    return key_value;
+  };
+
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = node_->now();
+  for (const auto& [stage, statistics] : moveit::core::LatencyTracer::getGlobal().getStatistics())
+  {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = stage;
+    status.hardware_id = node_->get_name();
+    status.message = "durations in seconds";
+    status.values.push_back(to_key_value("count", static_cast<double>(statistics.count)));
+    status.values.push_back(to_key_value("mean", statistics.mean()));
+    status.values.push_back(to_key_value("min", statistics.min));
+    status.values.push_back(to_key_value("max", statistics.max));
+    status.values.push_back(to_key_value("last", statistics.last));
+    msg.status.push_back(std::move(status));
+  }
+  latency_statistics_publisher_->publish(msg);
+}
+
 bool TrajectoryExecutionManager::isManagingControllers() const
 {
   return manage_controllers_;
@@ -347,7 +663,10 @@ bool TrajectoryExecutionManager::push(const moveit_msgs::msg::RobotTrajectory& t
   }
 
   TrajectoryExecutionContext* context = new TrajectoryExecutionContext();
-  if (configure(*context, trajectory, controllers))
+  moveit::core::ScopedLatencyTrace configure_trace("trajectory_execution/configure");
+  const bool configured = configure(*context, trajectory, controllers);
+  configure_trace.stop();
+  if (configured)
   {
     if (verbose_)
     {
@@ -375,59 +694,95 @@ bool TrajectoryExecutionManager::push(const moveit_msgs::msg::RobotTrajectory& t
 
 void TrajectoryExecutionManager::reloadControllerInformation()
 {
-  known_controllers_.clear();
-  if (controller_manager_)
+  if (!controller_manager_)
+  {
+    known_controllers_.clear();
+    joint_indices_.clear();
+    controller_selection_cache_.clear();
+    RCLCPP_ERROR(LOGGER, "Failed to reload controllers: `controller_manager_` does not exist.");
+    return;
+  }
+
+  // read the revision first, so that changes made while reloading are picked up by the next refresh
+  known_controllers_revision_ = controller_manager_->getControllersRevision();
+  std::vector<std::string> names;
+  controller_manager_->getControllersList(names);
+  std::map<std::string, std::set<std::string>> controller_joints;
+  for (const std::string& name : names)
+  {
+    std::vector<std::string> joints;
+    controller_manager_->getControllerJoints(name, joints);
+    controller_joints[name].insert(joints.begin(), joints.end());
+  }
+
+  // the joint index and the cached controller selections stay valid as long as the controllers do not change
+  bool changed = controller_joints.size() != known_controllers_.size();
+  for (auto it = controller_joints.begin(); !changed && it != controller_joints.end(); ++it)
   {
-    std::vector<std::string> names;
-    controller_manager_->getControllersList(names);
-    for (const std::string& name : names)
+    auto known = known_controllers_.find(it->first);
+    changed = known == known_controllers_.end() || known->second.joints_ != it->second;
+  }
+
+  if (changed)
+  {
+    known_controllers_.clear();
+    joint_indices_.clear();
+    controller_selection_cache_.clear();
+    for (std::pair<const std::string, std::set<std::string>>& controller : controller_joints)
     {
-      std::vector<std::string> joints;
-      controller_manager_->getControllerJoints(name, joints);
-      ControllerInformation ci;
-      ci.name_ = name;
-      ci.joints_.insert(joints.begin(), joints.end());
-      known_controllers_[ci.name_] = ci;
+      ControllerInformation& ci = known_controllers_[controller.first];
+      ci.name_ = controller.first;
+      ci.index_ = known_controllers_.size() - 1;
+      ci.joints_.swap(controller.second);
+      for (const std::string& joint : ci.joints_)
+        joint_indices_.emplace(joint, joint_indices_.size());
     }
 
-    names.clear();
-    controller_manager_->getActiveControllers(names);
-    for (const auto& active_name : names)
+    for (std::pair<const std::string, ControllerInformation>& known_controller : known_controllers_)
     {
-      auto found_it = std::find_if(known_controllers_.begin(), known_controllers_.end(),
-                                   [&](const auto& known_controller) { return known_controller.first == active_name; });
-      if (found_it != known_controllers_.end())
-      {
-        found_it->second.state_.active_ = true;
-      }
+      ControllerInformation& ci = known_controller.second;
+      ci.joint_bits_ = IndexBitset(joint_indices_.size());
+      for (const std::string& joint : ci.joints_)
+        ci.joint_bits_.set(joint_indices_[joint]);
     }
 
     for (std::map<std::string, ControllerInformation>::iterator it = known_controllers_.begin();
          it != known_controllers_.end(); ++it)
     {
-      for (std::map<std::string, ControllerInformation>::iterator jt = known_controllers_.begin();
-           jt != known_controllers_.end(); ++jt)
+      for (std::map<std::string, ControllerInformation>::iterator jt = std::next(it); jt != known_controllers_.end();
+           ++jt)
       {
-        if (it != jt)
+        if (it->second.joint_bits_.intersects(jt->second.joint_bits_))
         {
-          std::vector<std::string> intersect;
-          std::set_intersection(it->second.joints_.begin(), it->second.joints_.end(), jt->second.joints_.begin(),
-                                jt->second.joints_.end(), std::back_inserter(intersect));
-          if (!intersect.empty())
-          {
-            it->second.overlapping_controllers_.insert(jt->first);
-            jt->second.overlapping_controllers_.insert(it->first);
-          }
+          it->second.overlapping_controllers_.insert(jt->first);
+          jt->second.overlapping_controllers_.insert(it->first);
         }
       }
     }
   }
-  else
+
+  names.clear();
+  controller_manager_->getActiveControllers(names);
+  const std::set<std::string> active_names(names.begin(), names.end());
+  for (std::pair<const std::string, ControllerInformation>& known_controller : known_controllers_)
   {
-    RCLCPP_ERROR(LOGGER, "Failed to reload controllers: `controller_manager_` does not exist.");
+    const bool active = active_names.find(known_controller.first) != active_names.end();
+    if (known_controller.second.state_.active_ != active)
+    {
+      known_controller.second.state_.active_ = active;
+      controller_selection_cache_.clear();
+    }
   }
 }
 
+void TrajectoryExecutionManager::refreshControllerInformation()
+{
+  if (controller_manager_ && known_controllers_revision_ != 0 &&
+      controller_manager_->getControllersRevision() == known_controllers_revision_)
+    return;
+  reloadControllerInformation();
+}
+
 void TrajectoryExecutionManager::updateControllerState(const std::string& controller, const rclcpp::Duration& age)
 {
   std::map<std::string, ControllerInformation>::iterator it = known_controllers_.find(controller);
@@ -449,8 +804,11 @@ void TrajectoryExecutionManager::updateControllerState(ControllerInformation& ci
     {
       if (verbose_)
         RCLCPP_INFO(LOGGER, "Updating information for controller '%s'.", ci.name_.c_str());
+      const moveit_controller_manager::MoveItControllerManager::ControllerState previous_state = ci.state_;
       ci.state_ = controller_manager_->getControllerState(ci.name_);
       ci.last_update_ = node_->now();
+      if (ci.state_.active_ != previous_state.active_ || ci.state_.default_ != previous_state.default_)
+        controller_selection_cache_.clear();
     }
   }
   else if (verbose_)
@@ -463,58 +821,53 @@ void TrajectoryExecutionManager::updateControllersState(const rclcpp::Duration&
     updateControllerState(known_controller.second, age);
 }
 
-bool TrajectoryExecutionManager::checkControllerCombination(std::vector<std::string>& selected,
-                                                            const std::set<std::string>& actuated_joints)
+bool TrajectoryExecutionManager::checkControllerCombination(
+    const std::vector<const ControllerInformation*>& controllers, const IndexBitset& combined_joints,
+    const IndexBitset& actuated_joints)
 {
-  std::set<std::string> combined_joints;
-  for (const std::string& controller : selected)
-  {
-    const ControllerInformation& ci = known_controllers_[controller];
-    combined_joints.insert(ci.joints_.begin(), ci.joints_.end());
-  }
-
   if (verbose_)
   {
-    std::stringstream ss, saj, sac;
-    for (const std::string& controller : selected)
-      ss << controller << ' ';
-    for (const std::string& actuated_joint : actuated_joints)
-      saj << actuated_joint << ' ';
-    for (const std::string& combined_joint : combined_joints)
-      sac << combined_joint << ' ';
-    RCLCPP_INFO(LOGGER, "Checking if controllers [ %s] operating on joints [ %s] cover joints [ %s]", ss.str().c_str(),
-                sac.str().c_str(), saj.str().c_str());
+    std::stringstream ss, sac;
+    for (const ControllerInformation* ci : controllers)
+    {
+      ss << ci->name_ << ' ';
+      for (const std::string& joint : ci->joints_)
+        sac << joint << ' ';
+    }
+    RCLCPP_INFO(LOGGER, "Checking if controllers [ %s] operating on joints [ %s] cover %zu actuated joints",
+                ss.str().c_str(), sac.str().c_str(), actuated_joints.count());
   }
 
-  return std::includes(combined_joints.begin(), combined_joints.end(), actuated_joints.begin(), actuated_joints.end());
+  return combined_joints.includes(actuated_joints);
 }
 
-void TrajectoryExecutionManager::generateControllerCombination(std::size_t start_index, std::size_t controller_count,
-                                                               const std::vector<std::string>& available_controllers,
-                                                               std::vector<std::string>& selected_controllers,
-                                                               std::vector<std::vector<std::string>>& selected_options,
-                                                               const std::set<std::string>& actuated_joints)
+void TrajectoryExecutionManager::generateControllerCombination(
+    std::size_t start_index, std::size_t controller_count,
+    const std::vector<const ControllerInformation*>& available_controllers,
+    std::vector<const ControllerInformation*>& selected_controllers, const IndexBitset& combined_joints,
+    std::vector<std::vector<std::string>>& selected_options, const IndexBitset& actuated_joints)
 {
   if (selected_controllers.size() == controller_count)
   {
-    if (checkControllerCombination(selected_controllers, actuated_joints))
-      selected_options.push_back(selected_controllers);
+    if (checkControllerCombination(selected_controllers, combined_joints, actuated_joints))
+    {
+      selected_options.emplace_back();
+      for (const ControllerInformation* ci : selected_controllers)
+        selected_options.back().push_back(ci->name_);
+    }
     return;
   }
 
   for (std::size_t i = start_index; i < available_controllers.size(); ++i)
   {
-    bool overlap = false;
-    const ControllerInformation& ci = known_controllers_[available_controllers[i]];
-    for (std::size_t j = 0; j < selected_controllers.size() && !overlap; ++j)
-    {
-      if (ci.overlapping_controllers_.find(selected_controllers[j]) != ci.overlapping_controllers_.end())
-        overlap = true;
-    }
-    if (overlap)
+    // controllers that operate on the same joints cannot be combined
+    const ControllerInformation* ci = available_controllers[i];
+    if (ci->joint_bits_.intersects(combined_joints))
       continue;
-    selected_controllers.push_back(available_controllers[i]);
-    generateControllerCombination(i + 1, controller_count, available_controllers, selected_controllers,
+    IndexBitset joints = combined_joints;
+    joints |= ci->joint_bits_;
+    selected_controllers.push_back(ci);
+    generateControllerCombination(i + 1, controller_count, available_controllers, selected_controllers, joints,
                                   selected_options, actuated_joints);
     selected_controllers.pop_back();
   }
@@ -554,28 +907,24 @@ struct OrderPotentialControllerCombination
 };
 }  // namespace
 
-bool TrajectoryExecutionManager::findControllers(const std::set<std::string>& actuated_joints,
-                                                 std::size_t controller_count,
-                                                 const std::vector<std::string>& available_controllers,
+bool TrajectoryExecutionManager::findControllers(const IndexBitset& actuated_joints, std::size_t controller_count,
+                                                 const std::vector<const ControllerInformation*>& available_controllers,
                                                  std::vector<std::string>& selected_controllers)
 {
   // generate all combinations of controller_count controllers that operate on disjoint sets of joints
-  std::vector<std::string> work_area;
+  std::vector<const ControllerInformation*> work_area;
   OrderPotentialControllerCombination order;
   std::vector<std::vector<std::string>>& selected_options = order.selected_options;
-  generateControllerCombination(0, controller_count, available_controllers, work_area, selected_options,
-                                actuated_joints);
+  generateControllerCombination(0, controller_count, available_controllers, work_area,
+                                IndexBitset(joint_indices_.size()), selected_options, actuated_joints);
 
   if (verbose_)
   {
-    std::stringstream saj;
     std::stringstream sac;
-    for (const std::string& available_controller : available_controllers)
-      sac << available_controller << ' ';
-    for (const std::string& actuated_joint : actuated_joints)
-      saj << actuated_joint << ' ';
-    RCLCPP_INFO(LOGGER, "Looking for %zu controllers among [ %s] that cover joints [ %s]. Found %zd options.",
-                controller_count, sac.str().c_str(), saj.str().c_str(), selected_options.size());
+    for (const ControllerInformation* available_controller : available_controllers)
+      sac << available_controller->name_ << ' ';
+    RCLCPP_INFO(LOGGER, "Looking for %zu controllers among [ %s] that cover %zu actuated joints. Found %zd options.",
+                controller_count, sac.str().c_str(), actuated_joints.count(), selected_options.size());
   }
 
   // if none was found, this is a problem
@@ -661,30 +1010,70 @@ bool TrajectoryExecutionManager::selectControllers(const std::set<std::string>&
                                                    const std::vector<std::string>& available_controllers,
                                                    std::vector<std::string>& selected_controllers)
 {
-  for (std::size_t i = 1; i <= available_controllers.size(); ++i)
+  moveit::core::ScopedLatencyTrace trace("trajectory_execution/select_controllers");
+  IndexBitset joint_bits(joint_indices_.size());
+  for (const std::string& joint : actuated_joints)
+  {
+    std::map<std::string, std::size_t>::const_iterator it = joint_indices_.find(joint);
+    if (it == joint_indices_.end())
+      return false;  // no known controller operates on this joint
+    joint_bits.set(it->second);
+  }
+
+  // only controllers that operate on some of the actuated joints can be part of a minimal selection
+  IndexBitset controller_bits(known_controllers_.size());
+  std::vector<const ControllerInformation*> candidates;
+  for (const std::string& controller : available_controllers)
   {
-    if (findControllers(actuated_joints, i, available_controllers, selected_controllers))
+    std::map<std::string, ControllerInformation>::const_iterator it = known_controllers_.find(controller);
+    if (it == known_controllers_.end())
+      continue;
+    controller_bits.set(it->second.index_);
+    if (joint_bits.none() || it->second.joint_bits_.intersects(joint_bits))
+      candidates.push_back(&it->second);
+  }
+
+  // the selection only depends on these two sets and on the controller states, so reuse it until one of them changes
+  const std::pair<IndexBitset, IndexBitset> key(joint_bits, controller_bits);
+  std::map<std::pair<IndexBitset, IndexBitset>, ControllerSelection>::const_iterator cached =
+      controller_selection_cache_.find(key);
+  if (cached != controller_selection_cache_.end())
+  {
+    if (cached->second.found_)
+      selected_controllers = cached->second.controllers_;
+    return cached->second.found_;
+  }
+
+  ControllerSelection selection{ false, {} };
+  for (std::size_t i = 1; i <= candidates.size() && !selection.found_; ++i)
+  {
+    if (findControllers(joint_bits, i, candidates, selection.controllers_))
     {
+      selection.found_ = true;
       // if we are not managing controllers, prefer to use active controllers even if there are more of them
-      if (!manage_controllers_ && !areControllersActive(selected_controllers))
+      if (!manage_controllers_ && !areControllersActive(selection.controllers_))
       {
         std::vector<std::string> other_option;
-        for (std::size_t j = i + 1; j <= available_controllers.size(); ++j)
+        for (std::size_t j = i + 1; j <= candidates.size(); ++j)
         {
-          if (findControllers(actuated_joints, j, available_controllers, other_option))
+          if (findControllers(joint_bits, j, candidates, other_option))
           {
             if (areControllersActive(other_option))
             {
-              selected_controllers = other_option;
+              selection.controllers_ = other_option;
               break;
             }
           }
         }
       }
-      return true;
     }
   }
-  return false;
+
+  const bool found = selection.found_;
+  if (found)
+    selected_controllers = selection.controllers_;
+  controller_selection_cache_[key] = std::move(selection);
+  return found;
 }
 
 bool TrajectoryExecutionManager::distributeTrajectory(const moveit_msgs::msg::RobotTrajectory& trajectory,
@@ -832,8 +1221,9 @@ bool TrajectoryExecutionManager::distributeTrajectory(const moveit_msgs::msg::Ro
   return true;
 }
 
-bool TrajectoryExecutionManager::validate(const TrajectoryExecutionContext& context) const
+bool TrajectoryExecutionManager::validate(const TrajectoryExecutionContext& context, double& settle_time) const
 {
+  settle_time = 0.0;
   if (allowed_start_tolerance_ == 0)  // skip validation on this magic number
     return true;
 
@@ -875,6 +1265,20 @@ bool TrajectoryExecutionManager::validate(const TrajectoryExecutionContext& cont
         jm->enforcePositionBounds(&traj_position);
         if (jm->distance(&cur_position, &traj_position) > allowed_start_tolerance_)
         {
+          // accept a robot that is still settling, if it comes to rest at the start of the trajectory. Rest position
+          // and settling are both checked with half the tolerance, so the start is within tolerance once settled
+          SettlingPrediction prediction;
+          if (predictive_start_check_ &&
+              predictJointSettling(joint_names[i], 0.5 * allowed_start_tolerance_, prediction))
+          {
+            double rest_position = prediction.rest_position;
+            jm->enforcePositionBounds(&rest_position);
+            if (jm->distance(&rest_position, &traj_position) <= 0.5 * allowed_start_tolerance_)
+            {
+              settle_time = std::max(settle_time, prediction.settle_time);
+              continue;
+            }
+          }
           RCLCPP_ERROR(LOGGER,
                        "\nInvalid Trajectory: start point deviates from current robot state more than %g"
                        "\njoint '%s': expected: %g, current: %g",
@@ -939,7 +1343,7 @@ bool TrajectoryExecutionManager::configure(TrajectoryExecutionContext& context,
     return true;
   }
 
-  reloadControllerInformation();
+  refreshControllerInformation();
   std::set<std::string> actuated_joints;
 
   auto is_actuated = [this](const std::string& joint_name) -> bool {
@@ -1125,9 +1529,18 @@ void TrajectoryExecutionManager::execute(const ExecutionCompleteCallback& callba
     return;
 
   stopExecution(false);
+  execution_request_time_ = std::chrono::steady_clock::now();
+  {
+    std::scoped_lock llock(dispatch_latencies_mutex_);
+    motion_start_time_ = motion_end_time_ = std::chrono::steady_clock::time_point();
+  }
 
   // check whether first trajectory starts at current robot state
-  if (!trajectories_.empty() && !validate(*trajectories_.front()))
+  moveit::core::ScopedLatencyTrace validate_trace("trajectory_execution/validate");
+  double settle_time = 0.0;
+  const bool valid = validate(*trajectories_.front(), settle_time);
+  validate_trace.stop();
+  if (!valid)
   {
     last_execution_status_ = moveit_controller_manager::ExecutionStatus::ABORTED;
     if (auto_clear)
@@ -1137,6 +1550,18 @@ void TrajectoryExecutionManager::execute(const ExecutionCompleteCallback& callba
     return;
   }
 
+  // a robot that is still settling does not need to be waited for here; the trajectory is sent right away, to start
+  // once the robot has settled
+  if (settle_time > 0.0)
+  {
+    RCLCPP_INFO(LOGGER, "Robot is predicted to settle at the trajectory start in %g seconds", settle_time);
+    trajectories_.front()->earliest_start_ = node_->now() + rclcpp::Duration::from_seconds(settle_time);
+  }
+  else
+  {
+    trajectories_.front()->earliest_start_ = rclcpp::Time(0, 0, RCL_ROS_TIME);
+  }
+
   // start the execution thread
   execution_complete_ = false;
   execution_thread_ = std::make_unique<std::thread>(&TrajectoryExecutionManager::executeThread, this, callback,
@@ -1200,9 +1625,13 @@ void TrajectoryExecutionManager::executeThread(const ExecutionCompleteCallback&
     }
   }
 
-  // only report that execution finished successfully when the robot actually stopped moving
-  if (last_execution_status_ == moveit_controller_manager::ExecutionStatus::SUCCEEDED)
+  // only report that execution finished successfully when the robot actually stopped moving. With the predictive start
+  // check, the next execution accepts a robot that is still settling, so there is no need to wait here
+  if (last_execution_status_ == moveit_controller_manager::ExecutionStatus::SUCCEEDED && !predictive_start_check_)
+  {
+    moveit::core::ScopedLatencyTrace trace("trajectory_execution/wait_for_robot_to_stop");
     waitForRobotToStop(*trajectories_[i - 1]);
+  }
 
   RCLCPP_INFO(LOGGER, "Completed trajectory execution with status %s ...", last_execution_status_.asString().c_str());
 
@@ -1226,7 +1655,10 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
   TrajectoryExecutionContext& context = *trajectories_[part_index];
 
   // first make sure desired controllers are active
-  if (ensureActiveControllers(context.controllers_))
+  moveit::core::ScopedLatencyTrace activation_trace("trajectory_execution/ensure_active_controllers");
+  const bool active = ensureActiveControllers(context.controllers_);
+  activation_trace.stop();
+  if (active)
   {
     // stop if we are already asked to do so
     if (execution_complete_)
@@ -1264,40 +1696,131 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
           active_handles_[i] = h;
         }
         handles = active_handles_;  // keep a copy for later, to avoid thread safety issues
-        for (std::size_t i = 0; i < context.trajectory_parts_.size(); ++i)
+
+        // multiple controllers are sent the same start time, so they start moving simultaneously; with streaming
+        // enabled, the explicit start time also allows to splice in appended trajectories seamlessly later on.
+        // Without a known delay, a common start time would pass before the controllers hold their goals, so the
+        // parts are left to start when they are received
+        const bool delayed_start = context.earliest_start_.nanoseconds() != 0;
+        const double synchronized_delay = getSynchronizedStartDelay(context.controllers_);
+        const bool synchronized_start = context.trajectory_parts_.size() > 1 && synchronized_delay > 0.0;
+        if (trajectory_streaming_ || synchronized_start || delayed_start)
         {
-          bool ok = false;
-          try
+          rclcpp::Time start_time = node_->now() + rclcpp::Duration::from_seconds(synchronized_delay);
+          if (delayed_start && context.earliest_start_ > start_time)
+            start_time = context.earliest_start_;
+          for (moveit_msgs::msg::RobotTrajectory& part : context.trajectory_parts_)
           {
-            ok = active_handles_[i]->sendTrajectory(context.trajectory_parts_[i]);
+            if (rclcpp::Time(part.joint_trajectory.header.stamp).nanoseconds() == 0)
+              part.joint_trajectory.header.stamp = start_time;
+            if (rclcpp::Time(part.multi_dof_joint_trajectory.header.stamp).nanoseconds() == 0)
+              part.multi_dof_joint_trajectory.header.stamp = start_time;
           }
-          catch (std::exception& ex)
+        }
+
+        // dispatch the parts concurrently, so no controller waits for the others to accept their goals
+        const std::size_t part_count = context.trajectory_parts_.size();
+        const auto dispatch_start = std::chrono::steady_clock::now();
+        std::vector<double> latencies(part_count, 0.0);
+        std::vector<std::future<bool>> dispatched;
+        dispatched.reserve(part_count);
+        for (std::size_t i = 0; i < part_count; ++i)
+        {
+          dispatched.push_back(std::async(part_count > 1 ? std::launch::async : std::launch::deferred,
+                                          [&handles, &context, &latencies, &dispatch_start, i] {
+                                            bool ok = false;
+                                            try
+                                            {
+                                              ok = handles[i]->sendTrajectory(context.trajectory_parts_[i]);
+                                            }
+                                            catch (std::exception& ex)
+                                            {
+                                              RCLCPP_ERROR(LOGGER, "Caught %s when sending trajectory to controller",
+                                                           ex.what());
+                                            }
+                                            latencies[i] = std::chrono::duration<double>(
+                                                               std::chrono::steady_clock::now() - dispatch_start)
+                                                               .count();
+                                            return ok;
+                                          }));
+        }
+        std::vector<bool> sent(part_count, false);
+        for (std::size_t i = 0; i < part_count; ++i)
+          sent[i] = dispatched[i].get();
+
+        // the robot is commanded to start moving once the controllers hold their goals, or later for trajectories
+        // with a start time in the future
+        const auto dispatch_end = std::chrono::steady_clock::now();
+        double start_delay = 0.0;
+        for (const moveit_msgs::msg::RobotTrajectory& part : context.trajectory_parts_)
+        {
+          const rclcpp::Time stamp(part.joint_trajectory.header.stamp);
+          if (stamp.nanoseconds() != 0)
+            start_delay = std::max(start_delay, (stamp - node_->now()).seconds());
+        }
+
+        moveit::core::LatencyTracer& tracer = moveit::core::LatencyTracer::getGlobal();
+        if (tracer.isEnabled())
+        {
+          tracer.record("trajectory_execution/dispatch",
+                        std::chrono::duration<double>(dispatch_end - dispatch_start).count());
+          if (part_index == 0)
           {
-            RCLCPP_ERROR(LOGGER, "Caught %s when sending trajectory to controller", ex.what());
+            // time from the execution request until the controllers hold their goals, and until they are commanded
+            // to start moving
+            const double to_dispatch = std::chrono::duration<double>(dispatch_end - execution_request_time_).count();
+            tracer.record("trajectory_execution/time_to_dispatch", to_dispatch);
+            tracer.record("trajectory_execution/time_to_commanded_start", to_dispatch + start_delay);
           }
-          if (!ok)
+        }
+
+        {
+          std::scoped_lock llock(dispatch_latencies_mutex_);
+          if (part_index == 0)
+          {
+            motion_start_time_ =
+                dispatch_end + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   std::chrono::duration<double>(start_delay));
+          }
+          dispatch_latencies_.clear();
+          for (std::size_t i = 0; i < part_count; ++i)
           {
-            for (std::size_t j = 0; j < i; ++j)
+            RCLCPP_DEBUG(LOGGER, "Dispatching the trajectory to controller '%s' took %lf seconds",
+                         handles[i]->getName().c_str(), latencies[i]);
+            dispatch_latencies_[handles[i]->getName()] = latencies[i];
+            controller_dispatch_latencies_[handles[i]->getName()] = latencies[i];
+          }
+        }
+
+        if (std::find(sent.begin(), sent.end(), false) != sent.end())
+        {
+          for (std::size_t i = 0; i < part_count; ++i)
+          {
+            if (!sent[i])
             {
-              try
-              {
-                active_handles_[j]->cancelExecution();
-              }
-              catch (std::exception& ex)
-              {
-                RCLCPP_ERROR(LOGGER, "Caught %s when canceling execution", ex.what());
-              }
+              RCLCPP_ERROR(LOGGER, "Failed to send trajectory part %zu of %zu to controller %s", i + 1, part_count,
+                           handles[i]->getName().c_str());
+              continue;
+            }
+            try
+            {
+              handles[i]->cancelExecution();
+            }
+            catch (std::exception& ex)
+            {
+              RCLCPP_ERROR(LOGGER, "Caught %s when canceling execution", ex.what());
             }
-            RCLCPP_ERROR(LOGGER, "Failed to send trajectory part %zu of %zu to controller %s", i + 1,
-                         context.trajectory_parts_.size(), active_handles_[i]->getName().c_str());
-            if (i > 0)
-              RCLCPP_ERROR(LOGGER, "Cancelling previously sent trajectory parts");
-            active_handles_.clear();
-            current_context_ = -1;
-            last_execution_status_ = moveit_controller_manager::ExecutionStatus::ABORTED;
-            return false;
           }
+          if (part_count > 1)
+            RCLCPP_ERROR(LOGGER, "Cancelling the trajectory parts sent to the other controllers");
+          active_handles_.clear();
+          current_context_ = -1;
+          last_execution_status_ = moveit_controller_manager::ExecutionStatus::ABORTED;
+          return false;
         }
+
+        tracking_violated_ = false;
+        startTrackingMonitor(context, node_->now());
       }
     }
 
@@ -1360,56 +1883,94 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
     {
       std::scoped_lock slock(time_index_mutex_);
 
-      if (context.trajectory_parts_[longest_part].joint_trajectory.points.size() >=
-          context.trajectory_parts_[longest_part].multi_dof_joint_trajectory.points.size())
+      const moveit_msgs::msg::RobotTrajectory& part = context.trajectory_parts_[longest_part];
+      const rclcpp::Time stamp(part.joint_trajectory.points.size() >= part.multi_dof_joint_trajectory.points.size() ?
+                                   part.joint_trajectory.header.stamp :
+                                   part.multi_dof_joint_trajectory.header.stamp);
+      auto d = rclcpp::Duration::from_seconds(0);
+      if (stamp > current_time)
+        d = stamp - current_time;
+      time_index_start_ = current_time + d;
+      time_index_part_ = longest_part;
+      appended_duration_ = rclcpp::Duration(0, 0);
+      updateTimeIndex(context);
+    }
+
+    // trajectories appended by appendToExecution() extend the allowed execution duration
+    const auto allowed_trajectory_duration = [this, &expected_trajectory_duration] {
+      std::scoped_lock slock(time_index_mutex_);
+      return expected_trajectory_duration + appended_duration_ * allowed_execution_duration_scaling_;
+    };
+
+    // wait for all controllers at once. The waiting threads retry with the remaining allowed duration as timeout,
+    // so they are joined soon after the execution is stopped even if a controller does not report back.
+    HandleWaiter waiter(handles, [this, &allowed_trajectory_duration, &current_time] {
+      return std::max(allowed_trajectory_duration() - (node_->now() - current_time),
+                      rclcpp::Duration::from_seconds(MIN_HANDLE_WAIT_TIMEOUT));
+    });
+    {
+      std::scoped_lock slock(tracking_mutex_);
+      tracking_waiter_ = &waiter;
+    }
+    bool result = true;
+    bool tracking_stopped = false;
+    while (!waiter.finished())
+    {
+      // checkTracking() only flags the violation, the controllers are canceled here
+      if (tracking_violated_ && !tracking_stopped)
       {
-        auto d = rclcpp::Duration::from_seconds(0);
-        if (rclcpp::Time(context.trajectory_parts_[longest_part].joint_trajectory.header.stamp) > current_time)
-          d = rclcpp::Time(context.trajectory_parts_[longest_part].joint_trajectory.header.stamp) - current_time;
-        for (trajectory_msgs::msg::JointTrajectoryPoint& point :
-             context.trajectory_parts_[longest_part].joint_trajectory.points)
-          time_index_.push_back(current_time + d + rclcpp::Duration(point.time_from_start));
+        tracking_stopped = true;
+        std::scoped_lock slock(execution_state_mutex_);
+        if (!execution_complete_)
+          stopExecutionInternal();
       }
-      else
+
+      if (!execution_duration_monitoring_)
       {
-        auto d = rclcpp::Duration::from_seconds(0);
-        if (rclcpp::Time(context.trajectory_parts_[longest_part].multi_dof_joint_trajectory.header.stamp) > current_time)
-        {
-          d = rclcpp::Time(context.trajectory_parts_[longest_part].multi_dof_joint_trajectory.header.stamp) -
-              current_time;
-        }
-        for (trajectory_msgs::msg::MultiDOFJointTrajectoryPoint& point :
-             context.trajectory_parts_[longest_part].multi_dof_joint_trajectory.points)
-          time_index_.push_back(current_time + d + rclcpp::Duration(point.time_from_start));
+        waiter.wait();
+        continue;
       }
-    }
 
-    bool result = true;
-    for (moveit_controller_manager::MoveItControllerHandlePtr& handle : handles)
-    {
-      if (execution_duration_monitoring_)
+      // the allowed duration can only grow while waiting (see appendToExecution()), so it is checked on expiry
+      const rclcpp::Duration remaining = allowed_trajectory_duration() - (node_->now() - current_time);
+      if (remaining > rclcpp::Duration(0, 0))
       {
-        if (!handle->waitForExecution(expected_trajectory_duration))
-        {
-          if (!execution_complete_ && node_->now() - current_time > expected_trajectory_duration)
-          {
-            RCLCPP_ERROR(LOGGER,
-                         "Controller is taking too long to execute trajectory (the expected upper "
-                         "bound for the trajectory execution was %lf seconds). Stopping trajectory.",
-                         expected_trajectory_duration.seconds());
-            {
-              std::scoped_lock slock(execution_state_mutex_);
-              stopExecutionInternal();  // this is really tricky. we can't call stopExecution() here, so we call the
-                                        // internal function only
-            }
-            last_execution_status_ = moveit_controller_manager::ExecutionStatus::TIMED_OUT;
-            result = false;
-            break;
-          }
-        }
+        waiter.waitFor(std::chrono::nanoseconds(remaining.nanoseconds()));
+        continue;
       }
-      else
-        handle->waitForExecution();
+      if (execution_complete_)
+        break;
+
+      RCLCPP_ERROR(LOGGER,
+                   "Controller is taking too long to execute trajectory (the expected upper "
+                   "bound for the trajectory execution was %lf seconds). Stopping trajectory.",
+                   allowed_trajectory_duration().seconds());
+      {
+        std::scoped_lock slock(execution_state_mutex_);
+        stopExecutionInternal();  // this is really tricky. we can't call stopExecution() here, so we call the
+                                  // internal function only
+      }
+      last_execution_status_ = moveit_controller_manager::ExecutionStatus::TIMED_OUT;
+      result = false;
+      break;
+    }
+    {
+      std::scoped_lock slock(tracking_mutex_);
+      tracking_waiter_ = nullptr;
+    }
+    waiter.abandon();
+
+    // the controllers were canceled because the robot did not follow the trajectory
+    if (result && tracking_violated_)
+    {
+      last_execution_status_ = moveit_controller_manager::ExecutionStatus::ABORTED;
+      result = false;
+    }
+
+    for (const moveit_controller_manager::MoveItControllerHandlePtr& handle : handles)
+    {
+      if (!result)
+        break;
 
       // if something made the trajectory stop, we stop this thread too
       if (execution_complete_)
@@ -1426,6 +1987,12 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
       }
     }
 
+    stopTrackingMonitor();
+    {
+      std::scoped_lock llock(dispatch_latencies_mutex_);
+      motion_end_time_ = std::chrono::steady_clock::now();
+    }
+
     // clear the active handles
     execution_state_mutex_.lock();
     active_handles_.clear();
@@ -1433,6 +2000,7 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
     // clear the time index
     time_index_mutex_.lock();
     time_index_.clear();
+    time_index_part_ = -1;
     current_context_ = -1;
     time_index_mutex_.unlock();
 
@@ -1507,6 +2075,119 @@ bool TrajectoryExecutionManager::waitForRobotToStop(const TrajectoryExecutionCon
   return time_remaining > 0;
 }
 
+void TrajectoryExecutionManager::updateTimeIndex(const TrajectoryExecutionContext& context)
+{
+  // time_index_mutex_ needs to have been locked by the caller
+  time_index_.clear();
+  const moveit_msgs::msg::RobotTrajectory& part = context.trajectory_parts_[time_index_part_];
+  if (part.joint_trajectory.points.size() >= part.multi_dof_joint_trajectory.points.size())
+  {
+    for (const trajectory_msgs::msg::JointTrajectoryPoint& point : part.joint_trajectory.points)
+      time_index_.push_back(time_index_start_ + rclcpp::Duration(point.time_from_start));
+  }
+  else
+  {
+    for (const trajectory_msgs::msg::MultiDOFJointTrajectoryPoint& point : part.multi_dof_joint_trajectory.points)
+      time_index_.push_back(time_index_start_ + rclcpp::Duration(point.time_from_start));
+  }
+}
+
+bool TrajectoryExecutionManager::appendToExecution(const moveit_msgs::msg::RobotTrajectory& trajectory)
+{
+  if (!trajectory_streaming_)
+  {
+    RCLCPP_ERROR(LOGGER, "Cannot append trajectory: trajectory streaming is disabled");
+    return false;
+  }
+
+  std::scoped_lock slock(execution_state_mutex_);
+  bool executing_last_context = false;
+  {
+    std::scoped_lock tlock(time_index_mutex_);
+    executing_last_context = !execution_complete_ && !active_handles_.empty() && time_index_part_ >= 0 &&
+                             current_context_ >= 0 &&
+                             static_cast<std::size_t>(current_context_) + 1 == trajectories_.size();
+  }
+  if (!executing_last_context)
+  {
+    RCLCPP_ERROR(LOGGER, "Cannot append trajectory: the last pushed trajectory is not being executed");
+    return false;
+  }
+
+  for (const moveit_controller_manager::MoveItControllerHandlePtr& handle : active_handles_)
+  {
+    if (!handle->supportsTrajectoryReplacement())
+    {
+      RCLCPP_ERROR(LOGGER, "Cannot append trajectory: controller '%s' does not support trajectory replacement",
+                   handle->getName().c_str());
+      return false;
+    }
+  }
+
+  TrajectoryExecutionContext& context = *trajectories_[current_context_];
+  std::vector<moveit_msgs::msg::RobotTrajectory> parts;
+  if (!distributeTrajectory(trajectory, context.controllers_, parts))
+    return false;
+
+  // the appended trajectory has to continue where the executing one ends
+  const double start_tolerance =
+      allowed_start_tolerance_ > 0.0 ? allowed_start_tolerance_ : std::numeric_limits<double>::infinity();
+  std::vector<moveit_msgs::msg::RobotTrajectory> spliced = context.trajectory_parts_;
+  for (std::size_t i = 0; i < spliced.size(); ++i)
+  {
+    if (rclcpp::Time(spliced[i].joint_trajectory.header.stamp).nanoseconds() == 0 ||
+        !appendTrajectory(spliced[i], parts[i], start_tolerance))
+    {
+      RCLCPP_ERROR(LOGGER, "Cannot append trajectory to the one executed by controller '%s'",
+                   context.controllers_[i].c_str());
+      return false;
+    }
+  }
+
+  // the start time of the trajectories stays the same, so the controllers switch to the extended trajectories
+  // without any discontinuity; points that are already executed do not need to be sent again
+  const int current_point = getCurrentExpectedTrajectoryIndex().second;
+  for (std::size_t i = 0; i < spliced.size(); ++i)
+  {
+    moveit_msgs::msg::RobotTrajectory goal = spliced[i];
+    std::vector<trajectory_msgs::msg::JointTrajectoryPoint>& points = goal.joint_trajectory.points;
+    if (current_point > 1 && static_cast<std::size_t>(current_point) < points.size())
+      points.erase(points.begin(), points.begin() + (current_point - 1));
+
+    bool ok = false;
+    try
+    {
+      ok = active_handles_[i]->sendTrajectory(goal);
+    }
+    catch (std::exception& ex)
+    {
+      RCLCPP_ERROR(LOGGER, "Caught %s when sending trajectory to controller", ex.what());
+    }
+    if (!ok)
+    {
+      RCLCPP_ERROR(LOGGER, "Failed to append trajectory part %zu of %zu to controller %s", i + 1, spliced.size(),
+                   active_handles_[i]->getName().c_str());
+      // the controllers would execute inconsistent trajectories otherwise
+      if (i > 0)
+      {
+        RCLCPP_ERROR(LOGGER, "Cancelling execution");
+        stopExecutionInternal();
+      }
+      return false;
+    }
+  }
+
+  std::scoped_lock tlock(time_index_mutex_);
+  const double previous_duration = getTrajectoryDuration(context.trajectory_parts_[time_index_part_]);
+  context.trajectory_parts_.swap(spliced);
+  appended_duration_ = appended_duration_ + rclcpp::Duration::from_seconds(
+                                                getTrajectoryDuration(context.trajectory_parts_[time_index_part_]) -
+                                                previous_duration);
+  updateTimeIndex(context);
+  startTrackingMonitor(context, time_index_start_);
+  return true;
+}
+
 std::pair<int, int> TrajectoryExecutionManager::getCurrentExpectedTrajectoryIndex() const
 {
   std::scoped_lock slock(time_index_mutex_);
@@ -1526,6 +2207,36 @@ TrajectoryExecutionManager::getTrajectories() const
   return trajectories_;
 }
 
+double TrajectoryExecutionManager::getSynchronizedStartDelay(const std::vector<std::string>& controllers) const
+{
+  if (synchronized_start_delay_ > 0.0)
+    return synchronized_start_delay_;
+
+  std::scoped_lock slock(dispatch_latencies_mutex_);
+  double latency = 0.0;
+  for (const std::string& controller : controllers)
+  {
+    const auto it = controller_dispatch_latencies_.find(controller);
+    if (it == controller_dispatch_latencies_.end())
+      return 0.0;
+    latency = std::max(latency, it->second);
+  }
+  return SYNCHRONIZED_START_LATENCY_SCALING * latency;
+}
+
+std::map<std::string, double> TrajectoryExecutionManager::getLastDispatchLatencies() const
+{
+  std::scoped_lock slock(dispatch_latencies_mutex_);
+  return dispatch_latencies_;
+}
+
+std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point>
+TrajectoryExecutionManager::getLastMotionTimes() const
+{
+  std::scoped_lock slock(dispatch_latencies_mutex_);
+  return std::make_pair(motion_start_time_, motion_end_time_);
+}
+
 moveit_controller_manager::ExecutionStatus TrajectoryExecutionManager::getLastExecutionStatus() const
 {
   return last_execution_status_;
@@ -1580,7 +2291,7 @@ bool TrajectoryExecutionManager::ensureActiveController(const std::string& contr
 
 bool TrajectoryExecutionManager::ensureActiveControllers(const std::vector<std::string>& controllers)
 {
-  reloadControllerInformation();
+  refreshControllerInformation();
 
   updateControllersState(DEFAULT_CONTROLLER_INFORMATION_VALIDITY_AGE);
 
@@ -0,0 +1,106 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/trajectory_execution_manager/trajectory_splicing.h>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/logging.hpp>
+#include <cmath>
+
+namespace trajectory_execution_manager
+{
+static const rclcpp::Logger LOGGER = rclcpp::get_logger("moveit_ros.trajectory_execution_manager.trajectory_splicing");
+
+double getTrajectoryDuration(const moveit_msgs::msg::RobotTrajectory& trajectory)
+{
+  double duration = 0.0;
+  if (!trajectory.joint_trajectory.points.empty())
+    duration = rclcpp::Duration(trajectory.joint_trajectory.points.back().time_from_start).seconds();
+  if (!trajectory.multi_dof_joint_trajectory.points.empty())
+  {
+    duration = std::max(
+        duration, rclcpp::Duration(trajectory.multi_dof_joint_trajectory.points.back().time_from_start).seconds());
+  }
+  return duration;
+}
+
+bool appendTrajectory(moveit_msgs::msg::RobotTrajectory& trajectory, const moveit_msgs::msg::RobotTrajectory& next,
+                      double start_tolerance)
+{
+  if (!trajectory.multi_dof_joint_trajectory.points.empty() || !next.multi_dof_joint_trajectory.points.empty())
+  {
+    RCLCPP_ERROR(LOGGER, "Appending multi-dof trajectories is not supported");
+    return false;
+  }
+
+  trajectory_msgs::msg::JointTrajectory& current = trajectory.joint_trajectory;
+  const trajectory_msgs::msg::JointTrajectory& appended = next.joint_trajectory;
+  if (appended.points.empty())
+    return true;
+  if (current.points.empty() || current.joint_names != appended.joint_names)
+  {
+    RCLCPP_ERROR(LOGGER, "Cannot append a trajectory for a different set of joints");
+    return false;
+  }
+
+  // the appended trajectory needs to start where the current one ends
+  const std::vector<double>& end_positions = current.points.back().positions;
+  const std::vector<double>& start_positions = appended.points.front().positions;
+  if (end_positions.size() != start_positions.size())
+  {
+    RCLCPP_ERROR(LOGGER, "Wrong trajectory: #positions: %zu != %zu", end_positions.size(), start_positions.size());
+    return false;
+  }
+  for (std::size_t i = 0; i < end_positions.size(); ++i)
+  {
+    if (std::fabs(end_positions[i] - start_positions[i]) > start_tolerance)
+    {
+      RCLCPP_ERROR(LOGGER,
+                   "Cannot append trajectory: start point deviates from the end of the current trajectory more than %g"
+                   "\njoint '%s': expected: %g, start: %g",
+                   start_tolerance, current.joint_names[i].c_str(), end_positions[i], start_positions[i]);
+      return false;
+    }
+  }
+
+  const rclcpp::Duration offset(current.points.back().time_from_start);
+  std::size_t first = rclcpp::Duration(appended.points.front().time_from_start) == rclcpp::Duration(0, 0) ? 1 : 0;
+  current.points.reserve(current.points.size() + appended.points.size() - first);
+  for (std::size_t i = first; i < appended.points.size(); ++i)
+  {
+    current.points.push_back(appended.points[i]);
+    current.points.back().time_from_start = offset + rclcpp::Duration(appended.points[i].time_from_start);
+  }
+  return true;
+}
+}  // namespace trajectory_execution_manager
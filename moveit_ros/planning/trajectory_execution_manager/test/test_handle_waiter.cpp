@@ -0,0 +1,192 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_execution_manager/handle_waiter.h>
+#include <atomic>
+#include <memory>
+
+using trajectory_execution_manager::HandleWaiter;
+
+namespace
+{
+// controller handle whose execution finishes when the test says so
+class ControlledHandle : public moveit_controller_manager::MoveItControllerHandle
+{
+public:
+  ControlledHandle(const std::string& name) : MoveItControllerHandle(name)
+  {
+  }
+
+  bool sendTrajectory(const moveit_msgs::msg::RobotTrajectory& /*trajectory*/) override
+  {
+    return true;
+  }
+
+  bool cancelExecution() override
+  {
+    return true;
+  }
+
+  bool waitForExecution(const rclcpp::Duration& timeout) override
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiting_;
+    ++calls_;
+    condition_.notify_all();
+    const bool done =
+        condition_.wait_for(lock, std::chrono::nanoseconds(timeout.nanoseconds()), [this] { return finished_; });
+    --waiting_;
+    return done;
+  }
+
+  moveit_controller_manager::ExecutionStatus getLastExecutionStatus() override
+  {
+    return moveit_controller_manager::ExecutionStatus::SUCCEEDED;
+  }
+
+  void finish()
+  {
+    std::scoped_lock lock(mutex_);
+    finished_ = true;
+    condition_.notify_all();
+  }
+
+  bool waitUntilWaiting(std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout, [this] { return waiting_ > 0; });
+  }
+
+  int calls()
+  {
+    std::scoped_lock lock(mutex_);
+    return calls_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool finished_ = false;
+  int waiting_ = 0;
+  int calls_ = 0;
+};
+}  // namespace
+
+TEST(HandleWaiter, WaitsForAllHandlesConcurrently)
+{
+  auto first = std::make_shared<ControlledHandle>("first");
+  auto second = std::make_shared<ControlledHandle>("second");
+  HandleWaiter waiter({ first, second }, [] { return rclcpp::Duration::from_seconds(10.0); });
+
+  // both handles are waited for at the same time
+  ASSERT_TRUE(first->waitUntilWaiting(std::chrono::seconds(5)));
+  ASSERT_TRUE(second->waitUntilWaiting(std::chrono::seconds(5)));
+  EXPECT_FALSE(waiter.finished());
+
+  // the handles finish in any order
+  second->finish();
+  EXPECT_FALSE(waiter.waitFor(std::chrono::milliseconds(50)));
+  first->finish();
+  EXPECT_TRUE(waiter.waitFor(std::chrono::seconds(5)));
+  EXPECT_TRUE(waiter.finished());
+  EXPECT_EQ(first->calls(), 1);
+  EXPECT_EQ(second->calls(), 1);
+}
+
+TEST(HandleWaiter, RetriesUntilFinished)
+{
+  auto handle = std::make_shared<ControlledHandle>("handle");
+  HandleWaiter waiter({ handle }, [] { return rclcpp::Duration::from_seconds(0.01); });
+
+  // a wait timeout alone does not count as the end of the execution
+  EXPECT_FALSE(waiter.waitFor(std::chrono::milliseconds(100)));
+  handle->finish();
+  EXPECT_TRUE(waiter.waitFor(std::chrono::seconds(5)));
+  EXPECT_GT(handle->calls(), 1);
+}
+
+TEST(HandleWaiter, Interrupts)
+{
+  auto handle = std::make_shared<ControlledHandle>("handle");
+  HandleWaiter waiter({ handle }, [] { return rclcpp::Duration::from_seconds(10.0); });
+
+  // an interrupt before waiting wakes up the next wait
+  waiter.interrupt();
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(waiter.waitFor(std::chrono::seconds(5)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+  // the interrupt is consumed by that wait
+  EXPECT_FALSE(waiter.waitFor(std::chrono::milliseconds(50)));
+
+  std::thread interrupter([&waiter] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    waiter.interrupt();
+  });
+  waiter.wait();
+  EXPECT_FALSE(waiter.finished());
+  interrupter.join();
+
+  handle->finish();
+  EXPECT_TRUE(waiter.waitFor(std::chrono::seconds(5)));
+}
+
+TEST(HandleWaiter, AbandonsUnresponsiveHandles)
+{
+  auto responsive = std::make_shared<ControlledHandle>("responsive");
+  auto unresponsive = std::make_shared<ControlledHandle>("unresponsive");
+  {
+    HandleWaiter waiter({ responsive, unresponsive }, [] { return rclcpp::Duration::from_seconds(0.05); });
+    responsive->finish();
+    ASSERT_TRUE(unresponsive->waitUntilWaiting(std::chrono::seconds(5)));
+
+    // abandoning joins the threads within one wait timeout, even though a controller never reports back
+    const auto start = std::chrono::steady_clock::now();
+    waiter.abandon();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_FALSE(waiter.finished());
+  }
+
+  // no thread keeps waiting for the handle afterwards
+  const int calls = unresponsive->calls();
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  EXPECT_EQ(unresponsive->calls(), calls);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_execution_manager/index_bitset.h>
+#include <map>
+
+using trajectory_execution_manager::IndexBitset;
+
+namespace
+{
+IndexBitset makeBitset(std::size_t size, const std::vector<std::size_t>& indices)
+{
+  IndexBitset bits(size);
+  for (std::size_t index : indices)
+    bits.set(index);
+  return bits;
+}
+}  // namespace
+
+TEST(IndexBitset, SetAndTest)
+{
+  const IndexBitset bits = makeBitset(130, { 0, 63, 64, 129 });
+  EXPECT_TRUE(bits.test(0));
+  EXPECT_TRUE(bits.test(63));
+  EXPECT_TRUE(bits.test(64));
+  EXPECT_TRUE(bits.test(129));
+  EXPECT_FALSE(bits.test(1));
+  EXPECT_FALSE(bits.test(500));
+  EXPECT_EQ(bits.count(), 4u);
+  EXPECT_FALSE(bits.none());
+  EXPECT_TRUE(IndexBitset(130).none());
+}
+
+TEST(IndexBitset, CoverageAndOverlap)
+{
+  const IndexBitset arm = makeBitset(70, { 0, 1, 2, 3, 4, 5, 6 });
+  const IndexBitset gripper = makeBitset(70, { 7, 68 });
+  const IndexBitset actuated = makeBitset(70, { 2, 68 });
+
+  EXPECT_FALSE(arm.intersects(gripper));
+  EXPECT_TRUE(arm.intersects(actuated));
+  EXPECT_FALSE(arm.includes(actuated));
+
+  IndexBitset combined = arm;
+  combined |= gripper;
+  EXPECT_TRUE(combined.includes(actuated));
+  EXPECT_TRUE(combined.includes(IndexBitset()));
+  EXPECT_EQ(combined.count(), 9u);
+}
+
+TEST(IndexBitset, DifferentSizes)
+{
+  const IndexBitset small = makeBitset(10, { 3 });
+  const IndexBitset large = makeBitset(200, { 3 });
+  EXPECT_EQ(small, large);
+  EXPECT_FALSE(small < large);
+  EXPECT_FALSE(large < small);
+  EXPECT_TRUE(small.includes(large));
+
+  IndexBitset grown = small;
+  grown.set(150);
+  EXPECT_NE(grown, large);
+  EXPECT_TRUE(grown.includes(large));
+  EXPECT_FALSE(large.includes(grown));
+}
+
+TEST(IndexBitset, MapKey)
+{
+  std::map<IndexBitset, int> map;
+  map[makeBitset(100, { 1, 99 })] = 1;
+  map[makeBitset(100, { 2 })] = 2;
+  map[makeBitset(128, { 1, 99 })] = 3;
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map[makeBitset(100, { 1, 99 })], 3);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_execution_manager/settling_prediction.h>
+#include <cmath>
+
+using trajectory_execution_manager::predictSettling;
+using trajectory_execution_manager::samplesAreRecent;
+using trajectory_execution_manager::SettlingPrediction;
+
+namespace
+{
+// samples of a joint converging exponentially to rest with the given time constant
+void sampleSettling(double rest, double offset, double time_constant, std::size_t count, double dt,
+                    std::vector<double>& times, std::vector<double>& positions)
+{
+  times.clear();
+  positions.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    times.push_back(i * dt);
+    positions.push_back(rest + offset * std::exp(-times.back() / time_constant));
+  }
+}
+}  // namespace
+
+TEST(SettlingPrediction, PredictsExponentialConvergence)
+{
+  std::vector<double> times, positions;
+  sampleSettling(1.0, 0.1, 0.05, 5, 0.01, times, positions);
+
+  SettlingPrediction prediction;
+  ASSERT_TRUE(predictSettling(times, positions, 0.001, prediction));
+  EXPECT_NEAR(prediction.rest_position, 1.0, 1e-6);
+
+  // the joint is within tolerance of its rest position once the remaining offset has decayed below it
+  const double remaining = 0.1 * std::exp(-times.back() / 0.05);
+  EXPECT_NEAR(prediction.settle_time, 0.05 * std::log(remaining / 0.001), 1e-6);
+}
+
+TEST(SettlingPrediction, JointAtRest)
+{
+  const std::vector<double> times = { 0.0, 0.01, 0.02 };
+  const std::vector<double> positions = { 0.5, 0.5, 0.5 };
+
+  SettlingPrediction prediction;
+  ASSERT_TRUE(predictSettling(times, positions, 0.001, prediction));
+  EXPECT_DOUBLE_EQ(prediction.rest_position, 0.5);
+  EXPECT_DOUBLE_EQ(prediction.settle_time, 0.0);
+}
+
+TEST(SettlingPrediction, RejectsNonConvergingMotion)
+{
+  SettlingPrediction prediction;
+  // constant velocity
+  EXPECT_FALSE(predictSettling({ 0.0, 0.01, 0.02, 0.03 }, { 0.0, 0.1, 0.2, 0.3 }, 0.001, prediction));
+  // accelerating
+  EXPECT_FALSE(predictSettling({ 0.0, 0.01, 0.02 }, { 0.0, 0.1, 0.3 }, 0.001, prediction));
+  // reversing
+  EXPECT_FALSE(predictSettling({ 0.0, 0.01, 0.02 }, { 0.0, 0.1, 0.05 }, 0.001, prediction));
+  // too few samples
+  EXPECT_FALSE(predictSettling({ 0.0, 0.01 }, { 0.0, 0.1 }, 0.001, prediction));
+}
+
+TEST(SettlingPrediction, RejectsStaleSamples)
+{
+  const std::vector<double> times = { 0.0, 0.01, 0.02, 0.03 };
+  EXPECT_TRUE(samplesAreRecent(times, 0.035));
+  EXPECT_TRUE(samplesAreRecent(times, 0.06));
+  // joint states stopped arriving more than three sample periods ago
+  EXPECT_FALSE(samplesAreRecent(times, 0.07));
+  EXPECT_TRUE(samplesAreRecent(times, 0.07, 5.0));
+  // a single sample does not tell the sample period
+  EXPECT_FALSE(samplesAreRecent({ 0.0 }, 0.0));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_execution_manager/tracking_monitor.h>
+#include <rclcpp/duration.hpp>
+#include <cmath>
+
+using trajectory_execution_manager::TrackingMonitor;
+
+namespace
+{
+// two joints moving linearly from 0 to 1 and from 0 to -1 in 1s
+trajectory_msgs::msg::JointTrajectory makeTrajectory()
+{
+  trajectory_msgs::msg::JointTrajectory trajectory;
+  trajectory.joint_names = { "joint_1", "joint_2" };
+  for (std::size_t i = 0; i <= 10; ++i)
+  {
+    trajectory_msgs::msg::JointTrajectoryPoint point;
+    point.positions = { 0.1 * i, -0.1 * i };
+    point.time_from_start = rclcpp::Duration::from_seconds(0.1 * i);
+    trajectory.points.push_back(point);
+  }
+  return trajectory;
+}
+}  // namespace
+
+TEST(TrackingMonitor, InterpolatesExpectedPositions)
+{
+  TrackingMonitor monitor(makeTrajectory(), { 0.01, 0.01 });
+  EXPECT_NEAR(monitor.getExpectedPosition(0.25, 0), 0.25, 1e-9);
+  EXPECT_NEAR(monitor.getExpectedPosition(0.55, 1), -0.55, 1e-9);
+  // going back in time is supported as well
+  EXPECT_NEAR(monitor.getExpectedPosition(0.05, 0), 0.05, 1e-9);
+  // the last point is held after the end
+  EXPECT_NEAR(monitor.getExpectedPosition(2.0, 0), 1.0, 1e-9);
+}
+
+TEST(TrackingMonitor, DetectsDeviations)
+{
+  TrackingMonitor monitor(makeTrajectory(), { 0.01, 0.05 });
+  std::size_t joint = 0;
+  double deviation = 0.0;
+
+  for (double time = 0.0; time <= 1.0; time += 0.01)
+    EXPECT_TRUE(monitor.check(time, { time + 0.005, -time }, joint, deviation));
+
+  EXPECT_FALSE(monitor.check(0.5, { 0.5, -0.44 }, joint, deviation));
+  EXPECT_EQ(joint, 1u);
+  EXPECT_NEAR(deviation, 0.06, 1e-9);
+
+  // joints without tolerance are not checked
+  TrackingMonitor unchecked(makeTrajectory(), { 0.0, 0.0 });
+  EXPECT_TRUE(unchecked.check(0.5, { 10.0, 10.0 }, joint, deviation));
+}
+
+TEST(TrackingMonitor, WrapsContinuousJoints)
+{
+  TrackingMonitor monitor(makeTrajectory(), { 0.01, 0.01 }, { true, false });
+  std::size_t joint = 0;
+  double deviation = 0.0;
+  EXPECT_TRUE(monitor.check(0.5, { 0.5 + 2.0 * M_PI, -0.5 }, joint, deviation));
+  EXPECT_FALSE(monitor.check(0.5, { -0.5, -0.5 + 2.0 * M_PI }, joint, deviation));
+}
+
+TEST(TrackingMonitor, ChangesTolerances)
+{
+  TrackingMonitor monitor(makeTrajectory(), { 0.01, 0.01 });
+  std::size_t joint = 0;
+  double deviation = 0.0;
+
+  EXPECT_FALSE(monitor.check(0.5, { 0.52, -0.5 }, joint, deviation));
+  monitor.setTolerances({ 0.05, 0.01 });
+  EXPECT_TRUE(monitor.check(0.5, { 0.52, -0.5 }, joint, deviation));
+  EXPECT_FALSE(monitor.check(0.6, { 0.6, -0.62 }, joint, deviation));
+  EXPECT_EQ(joint, 1u);
+
+  // joints without a tolerance are not checked anymore
+  monitor.setTolerances({ 0.05 });
+  EXPECT_TRUE(monitor.check(0.7, { 0.7, -0.9 }, joint, deviation));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
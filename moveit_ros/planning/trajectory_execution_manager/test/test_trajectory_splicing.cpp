@@ -0,0 +1,120 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, PickNik Robotics, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of PickNik Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_execution_manager/trajectory_splicing.h>
+#include <rclcpp/duration.hpp>
+
+using trajectory_execution_manager::appendTrajectory;
+using trajectory_execution_manager::getTrajectoryDuration;
+
+namespace
+{
+moveit_msgs::msg::RobotTrajectory makeTrajectory(double start, double end, std::size_t count, double dt)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory;
+  trajectory.joint_trajectory.joint_names = { "joint_1", "joint_2" };
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    trajectory_msgs::msg::JointTrajectoryPoint point;
+    const double position = start + (end - start) * i / (count - 1);
+    point.positions = { position, -position };
+    point.time_from_start = rclcpp::Duration::from_seconds(i * dt);
+    trajectory.joint_trajectory.points.push_back(point);
+  }
+  return trajectory;
+}
+}  // namespace
+
+TEST(TrajectorySplicing, AppendContinuesTimeline)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory = makeTrajectory(0.0, 1.0, 11, 0.1);
+  const moveit_msgs::msg::RobotTrajectory next = makeTrajectory(1.0, 2.0, 6, 0.2);
+  ASSERT_TRUE(appendTrajectory(trajectory, next, 0.01));
+
+  // the duplicated junction point is dropped and there is no idle gap between the two segments
+  const auto& points = trajectory.joint_trajectory.points;
+  ASSERT_EQ(points.size(), 16u);
+  EXPECT_NEAR(getTrajectoryDuration(trajectory), 1.0 + 1.0, 1e-9);
+  for (std::size_t i = 1; i < points.size(); ++i)
+  {
+    const double dt = rclcpp::Duration(points[i].time_from_start).seconds() -
+                      rclcpp::Duration(points[i - 1].time_from_start).seconds();
+    EXPECT_GT(dt, 0.0);
+    EXPECT_LE(dt, 0.2 + 1e-9);
+  }
+  EXPECT_DOUBLE_EQ(points.back().positions[0], 2.0);
+  EXPECT_DOUBLE_EQ(points.back().positions[1], -2.0);
+}
+
+TEST(TrajectorySplicing, AppendKeepsFirstPointWithTimeOffset)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory = makeTrajectory(0.0, 1.0, 3, 0.5);
+  moveit_msgs::msg::RobotTrajectory next = makeTrajectory(1.0, 2.0, 3, 0.5);
+  for (auto& point : next.joint_trajectory.points)
+    point.time_from_start = rclcpp::Duration(point.time_from_start) + rclcpp::Duration::from_seconds(0.5);
+  ASSERT_TRUE(appendTrajectory(trajectory, next, 0.01));
+  EXPECT_EQ(trajectory.joint_trajectory.points.size(), 6u);
+  EXPECT_NEAR(getTrajectoryDuration(trajectory), 2.5, 1e-9);
+}
+
+TEST(TrajectorySplicing, RejectsDiscontinuousStart)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory = makeTrajectory(0.0, 1.0, 5, 0.1);
+  const moveit_msgs::msg::RobotTrajectory original = trajectory;
+  EXPECT_FALSE(appendTrajectory(trajectory, makeTrajectory(1.5, 2.0, 5, 0.1), 0.01));
+  EXPECT_EQ(trajectory, original);
+}
+
+TEST(TrajectorySplicing, RejectsDifferentJoints)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory = makeTrajectory(0.0, 1.0, 5, 0.1);
+  moveit_msgs::msg::RobotTrajectory next = makeTrajectory(1.0, 2.0, 5, 0.1);
+  next.joint_trajectory.joint_names[1] = "joint_3";
+  EXPECT_FALSE(appendTrajectory(trajectory, next, 0.01));
+}
+
+TEST(TrajectorySplicing, AppendEmptyIsNoop)
+{
+  moveit_msgs::msg::RobotTrajectory trajectory = makeTrajectory(0.0, 1.0, 5, 0.1);
+  const moveit_msgs::msg::RobotTrajectory original = trajectory;
+  EXPECT_TRUE(appendTrajectory(trajectory, moveit_msgs::msg::RobotTrajectory(), 0.01));
+  EXPECT_EQ(trajectory, original);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}